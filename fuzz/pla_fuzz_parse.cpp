@@ -0,0 +1,257 @@
+//libFuzzer target for pla_parse_GLTF with PLA_HARDENED, everything a parsed file feeds (accessors, quantizing, skins, morph targets, animations, hashing, bvhs, lods, tangents, queries, writing it back out) runs on what it accepts.
+//Besides crashes it times every input and traps when one takes more than its budget per byte, so inputs that send a scanner superlinear are saved like crashes.
+//
+//    clang++ -std=c++2b -g -O1 -fsanitize=fuzzer,address,undefined fuzz/pla_fuzz_parse.cpp -o pla_fuzz_parse
+//    ./pla_fuzz_parse -max_len=65536 fuzz/corpus
+//
+//Built with PLA_FUZZ_REPLAY it has its own main that runs the files it's given once each, prints the time per byte and exits with 1 if any was over budget, for the benchmark runs and compilers without libFuzzer.
+//
+//    c++ -std=c++2b -O2 -DPLA_FUZZ_REPLAY fuzz/pla_fuzz_parse.cpp -o pla_fuzz_replay
+//    ./pla_fuzz_replay fuzz/corpus/*
+//
+//PLA_FUZZ_NS_PER_BYTE sets the budget, every input also gets PLA_FUZZ_BASE_NS on top so tiny inputs aren't flagged by fixed costs.
+//the fuzzing default is loose enough for sanitizer builds, the replay default is for optimized builds where the corpus runs at under 60ns per byte.
+
+#define PLA_HARDENED
+#include "../plastic_gltf_bvh.h"
+#include "../plastic_gltf_simplify.h"
+#include "../plastic_gltf_tangents.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+//memory a single input may ask for, bigger requests are skipped rather than reported as out of memory.
+#define PLA_FUZZ_MAX_MEMORY (64u << 20)
+#define PLA_FUZZ_MAX_ELEMENTS (1u << 20)
+
+#ifdef PLA_FUZZ_REPLAY
+#define PLA_FUZZ_DEFAULT_NS_PER_BYTE 150
+#define PLA_FUZZ_DEFAULT_BASE_NS 1000000
+#else
+#define PLA_FUZZ_DEFAULT_NS_PER_BYTE 2000
+#define PLA_FUZZ_DEFAULT_BASE_NS 20000000
+#endif
+
+static u64 pla_fuzz_now_ns(){
+        return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static u64 pla_fuzz_env(char const * name, u64 fallback){
+        char const * value = getenv(name);
+        return value ? strtoull(value, PLA_NULL, 10) : fallback;
+}
+
+static bool pla_fuzz_is_slow(usize size, u64 elapsed){
+        static u64 const ns_per_byte = pla_fuzz_env("PLA_FUZZ_NS_PER_BYTE", PLA_FUZZ_DEFAULT_NS_PER_BYTE);
+        static u64 const base_ns = pla_fuzz_env("PLA_FUZZ_BASE_NS", PLA_FUZZ_DEFAULT_BASE_NS);
+        return elapsed > base_ns + ns_per_byte * size;
+}
+
+static void pla_fuzz_primitive(pla_GLTF const * gltf, pla_mesh const * mesh, pla_skin const * skin, pla_mesh_primitive const * primitive){
+        pla_quantize_config config = pla_default_quantize_config();
+        pla_vertex_layout layout;
+        usize size = 0;
+        if(pla_quantize_primitive(gltf, primitive, &config, &layout, &size, PLA_NULL) && size <= PLA_FUZZ_MAX_MEMORY){
+                std::vector<u8> vertices(size + 1);
+                pla_quantize_primitive(gltf, primitive, &config, &layout, &size, vertices.data());
+        }
+
+        pla_skin_packing packing = pla_default_skin_packing();
+        size = 0;
+        if(skin && pla_pack_skin_influences(gltf, primitive, skin, &packing, &size, PLA_NULL) && size <= PLA_FUZZ_MAX_MEMORY){
+                std::vector<u8> influences(size + 1);
+                pla_pack_skin_influences(gltf, primitive, skin, &packing, &size, influences.data());
+        }
+
+        for(u32 i = 0; i < primitive->attribute_count; ++i){
+                if(primitive->attributes[i].name != pla_POSITION) continue;
+                pla_accessor const * position = &gltf->accessors[primitive->attributes[i].accessor];
+                if(position->count > PLA_FUZZ_MAX_ELEMENTS) break;
+                std::vector<f32> weights(mesh->weight_count + 1, 0.5f);
+                std::vector<f32> blended((usize)position->count * 4 + 1);
+                pla_blend_morph_targets(gltf, primitive, pla_POSITION, weights.data(), mesh->weight_count, blended.data(), PLA_NULL);
+                break;
+        }
+}
+
+//the parsed primitive and attribute counts have to be the ones in the json, however many there are.
+static void pla_fuzz_check_counts(pla_GLTF const * gltf){
+        pla_json_tape const * tape = &gltf->tape;
+        if(!tape->entries) return;
+        for(u32 m = 0; m < gltf->meshes_size; ++m){
+                pla_json_value primitives = pla_get_item(gltf, "meshes", m, "primitives");
+                if(primitives.count != gltf->meshes[m].primitive_count) __builtin_trap();
+                for(u32 p = 0; p < primitives.count; ++p){
+                        u32 attributes = pla_tape_find_member(tape, pla_tape_get_item(tape, primitives.index, p), "attributes");
+                        u32 attribute_count = 0;
+                        for(u32 key = attributes + 1; key < tape->entries[attributes].end; key = pla_tape_next(tape, key + 1)){
+                                pla_mesh_primitive_attribute attribute;
+                                attribute_count += lookup_mesh_primitive_attribute_name(pla_tape_get_str(tape, key), &attribute);
+                        }
+                        if(attribute_count != gltf->meshes[m].primitives[p].attribute_count) __builtin_trap();
+                }
+        }
+}
+
+//writes the file back out and parses what was written, the keys the writer puts in a primitive itself have to be there once.
+static void pla_fuzz_round_trip(pla_GLTF const * gltf){
+        usize json_size = 0;
+        if(!pla_write_GLB(gltf, &json_size, PLA_NULL, PLA_NULL) || json_size > PLA_FUZZ_MAX_MEMORY) return;
+        std::vector<u8> json(json_size + 1);
+        std::vector<u8> glb(json_size + gltf->bin_size + 32);
+        pla_memory_writer memory = {glb.data(), 0, glb.size()};
+        pla_writer writer = {&memory, pla_write_to_memory};
+        if(!pla_write_GLB(gltf, &json_size, json.data(), &writer)) __builtin_trap();
+
+        size_t memory_size = 0;
+        if(!pla_parse_GLTF((u32)memory.size, memory.data, &memory_size, PLA_NULL, PLA_NULL)) __builtin_trap();
+        std::vector<u8> written_memory(memory_size + 1);
+        pla_GLTF written = {};
+        if(!pla_parse_GLTF((u32)memory.size, memory.data, &memory_size, written_memory.data(), &written)) __builtin_trap();
+        pla_json_tape const * tape = &written.tape;
+        if(!tape->entries) return;
+        for(u32 m = 0; m < written.meshes_size; ++m){
+                pla_json_value primitives = pla_get_item(&written, "meshes", m, "primitives");
+                for(u32 p = 0; p < primitives.count; ++p){
+                        u32 primitive = pla_tape_get_item(tape, primitives.index, p);
+                        u32 end = tape->entries[primitive].end;
+                        for(c_str name : {"attributes", "indices", "material", "mode"}){
+                                u32 count = 0;
+                                for(u32 key = primitive + 1; key < end; key = pla_tape_next(tape, key + 1)) count += pla_str_is_equal(pla_tape_get_str(tape, key), name);
+                                if(count > 1) __builtin_trap();
+                        }
+                }
+        }
+}
+
+static void pla_fuzz_one(u8 const * data, usize size){
+        if(size > UINT32_MAX) return;
+        size_t memory_size = 0;
+        if(!pla_parse_GLTF((u32)size, data, &memory_size, PLA_NULL, PLA_NULL) || memory_size > PLA_FUZZ_MAX_MEMORY) return;
+        std::vector<u8> memory(memory_size + 1);
+        pla_GLTF gltf = {};
+        if(!pla_parse_GLTF((u32)size, data, &memory_size, memory.data(), &gltf)) return;
+        pla_fuzz_check_counts(&gltf);
+
+        usize meshopt_size = pla_get_meshopt_memory_size(&gltf);
+        if(meshopt_size > PLA_FUZZ_MAX_MEMORY) return;
+        std::vector<u8> meshopt(meshopt_size + 1);
+        if(meshopt_size && !pla_decode_meshopt_buffer_views(&gltf, PLA_NULL, meshopt_size, meshopt.data())) return;
+
+        std::vector<f32> values;
+        for(u32 i = 0; i < gltf.accessors_size; ++i){
+                pla_accessor const * accessor = &gltf.accessors[i];
+                if(accessor->count > PLA_FUZZ_MAX_ELEMENTS) continue;
+                values.resize((usize)accessor->count * 16 + 1);
+                pla_read_accessor_f32(&gltf, accessor, 0, accessor->count, values.data());
+                //the back half on its own like a job would read it, sparse indices before first must not land before values.
+                pla_read_accessor_f32(&gltf, accessor, accessor->count / 2, accessor->count - accessor->count / 2, values.data());
+        }
+        std::vector<u64> hashes(gltf.accessors_size + 1);
+        pla_hash_accessors(&gltf, PLA_NULL, hashes.data());
+
+        //a mesh is skinned with the skin of the first node that has both.
+        std::vector<pla_skin const *> mesh_skins(gltf.meshes_size + 1, PLA_NULL);
+        for(u32 n = gltf.nodes_size; n-- > 0;){
+                if(gltf.nodes[n].mesh != PLA_INDEX_NONE && gltf.nodes[n].skin != PLA_INDEX_NONE) mesh_skins[gltf.nodes[n].mesh] = &gltf.skins[gltf.nodes[n].skin];
+        }
+        for(u32 m = 0; m < gltf.meshes_size; ++m){
+                u64 hash;
+                pla_hash_mesh(&gltf, &gltf.meshes[m], hashes.data(), &hash);
+                for(u32 p = 0; p < gltf.meshes[m].primitive_count; ++p) pla_fuzz_primitive(&gltf, &gltf.meshes[m], mesh_skins[m], &gltf.meshes[m].primitives[p]);
+        }
+        //bvhs, lods and tangents take memory for every vertex and triangle up front.
+        u64 element_count = 0;
+        for(u32 m = 0; m < gltf.meshes_size; ++m){
+                for(u32 p = 0; p < gltf.meshes[m].primitive_count; ++p){
+                        pla_mesh_primitive const * primitive = &gltf.meshes[m].primitives[p];
+                        pla_accessor const * position = pla_find_attribute_accessor(&gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+                        element_count += (u64)pla_get_primitive_triangle_count(&gltf, primitive) + (position ? position->count : 0);
+                }
+        }
+        if(element_count <= PLA_FUZZ_MAX_ELEMENTS && gltf.nodes_size <= PLA_FUZZ_MAX_ELEMENTS){
+                pla_bvh_config config = pla_default_bvh_config();
+                pla_linear_allocator arena = pla_make_linear_allocator(pla_get_heap_allocator(), 1 << 16, 0);
+                pla_scene_bvh bvh;
+                f32 origin[3] = {0, 0, -10};
+                f32 direction[3] = {0.01f, 0.02f, 1};
+                if(gltf.scenes_size && pla_build_scene_bvh(&gltf, 0, &config, PLA_NULL, &arena, &bvh)){
+                        pla_scene_bvh_hit hit;
+                        pla_scene_bvh_intersect_ray(&bvh, origin, direction, 1e30f, &hit);
+                }else if(pla_build_mesh_bvhs(&gltf, &config, PLA_NULL, &arena, &bvh.meshes) && bvh.meshes.count){
+                        pla_bvh_closest_point closest;
+                        pla_bvh_find_closest_point(&bvh.meshes.bvhs[0], origin, 1e30f, &closest);
+                }
+                pla_simplify_attribute attributes[] = {{pla_NORMAL, 0, 1.0f}, {pla_TEXCOORD, 0, 1.0f}, {pla_COLOR, 0, 1.0f}};
+                pla_simplify_config simplify = pla_default_simplify_config();
+                simplify.attributes = attributes;
+                simplify.attribute_count = 3;
+                pla_lod_target targets[] = {{0.5f, 0.01f}, {0.1f, 1.0f}};
+                pla_mesh_lods lods;
+                pla_generate_mesh_lods(&gltf, &simplify, targets, 2, PLA_NULL, &arena, &lods);
+                pla_mesh_tangents tangents;
+                pla_generate_mesh_tangents(&gltf, PLA_NULL, &arena, &tangents);
+                pla_release_linear_allocator(&arena);
+        }
+        for(u32 i = 0; i < gltf.animations_size; ++i){
+                usize clip_size = 0;
+                pla_animation_clip clip;
+                if(!pla_bake_animation_clip(&gltf, &gltf.animations[i], &clip_size, PLA_NULL, PLA_NULL) || clip_size > PLA_FUZZ_MAX_MEMORY) continue;
+                std::vector<u8> clip_memory(clip_size + 1);
+                if(!pla_bake_animation_clip(&gltf, &gltf.animations[i], &clip_size, clip_memory.data(), &clip)) continue;
+                u32 frame_count = pla_get_resampled_frame_count(&clip, 30.0f);
+                if(frame_count == 0 || (u64)frame_count * clip.output_size > PLA_FUZZ_MAX_ELEMENTS) continue;
+                std::vector<f32> frames((usize)frame_count * clip.output_size + 1);
+                if(!pla_resample_animation_clip(&clip, 30.0f, frames.data())) __builtin_trap();
+        }
+        pla_get(&gltf, "asset.version");
+        pla_get_item(&gltf, "meshes", 0, "primitives[0].attributes.POSITION");
+        pla_fuzz_round_trip(&gltf);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(u8 const * data, usize size){
+#ifdef PLA_FUZZ_REPLAY
+        pla_fuzz_one(data, size);
+#else
+        u64 start = pla_fuzz_now_ns();
+        pla_fuzz_one(data, size);
+        u64 elapsed = pla_fuzz_now_ns() - start;
+        //a trap makes libFuzzer keep the input like a crash.
+        if(pla_fuzz_is_slow(size, elapsed)){
+                fprintf(stderr, "slow input: %zu bytes took %.3f ms, %.1f ns per byte\n", size, elapsed / 1e6, (double)elapsed / (size ? size : 1));
+                __builtin_trap();
+        }
+#endif
+        return 0;
+}
+
+#ifdef PLA_FUZZ_REPLAY
+int main(int argc, char ** argv){
+        if(argc < 2){
+                fprintf(stderr, "usage: %s files...\n", argv[0]);
+                return 2;
+        }
+        int slow_count = 0;
+        for(int i = 1; i < argc; ++i){
+                FILE * file = fopen(argv[i], "rb");
+                if(!file){
+                        fprintf(stderr, "%s: can't read\n", argv[i]);
+                        return 1;
+                }
+                std::vector<u8> data;
+                u8 chunk[65536];
+                for(usize read; (read = fread(chunk, 1, sizeof(chunk), file)) > 0;) data.insert(data.end(), chunk, chunk + read);
+                fclose(file);
+                u64 start = pla_fuzz_now_ns();
+                LLVMFuzzerTestOneInput(data.data(), data.size());
+                u64 elapsed = pla_fuzz_now_ns() - start;
+                bool slow = pla_fuzz_is_slow(data.size(), elapsed);
+                slow_count += slow;
+                printf("%-48s %9zu bytes %9.3f ms %8.1f ns/byte%s\n", argv[i], data.size(), elapsed / 1e6, (double)elapsed / (data.size() ? data.size() : 1), slow ? " SLOW" : "");
+        }
+        if(slow_count) fprintf(stderr, "%d inputs over budget\n", slow_count);
+        return slow_count ? 1 : 0;
+}
+#endif
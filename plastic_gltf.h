@@ -3,18 +3,40 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+
+#if !defined(PLA_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#ifdef PLA_USE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#endif
 
 #ifdef __cplusplus
 #define NOEXCEPT noexcept
 #define CONSTEXPR constexpr
 #define PLA_NULL nullptr
 #define NODISCARD [[nodiscard]]
+#define PLA_THREAD_LOCAL thread_local
 extern "C" {
 #else
 #define NOEXCEPT
 #define CONSTEXPR
 #define PLA_NULL 0
 #define NODISCARD
+#define PLA_THREAD_LOCAL _Thread_local
 #include <stdbool.h>
 #endif
 
@@ -30,9 +52,12 @@ typedef uint64_t u64;
 typedef int64_t s64;
 typedef size_t usize;
 typedef float f32;
+typedef double f64;
 typedef char const * c_str;
 
 #define U8_MAX UINT8_MAX
+//Used for optional indices that are not in the file.
+#define PLA_INDEX_NONE UINT32_MAX
 
 #define glTF 0x46546C67
 #define JSON 0x4E4F534A
@@ -45,7 +70,8 @@ typedef struct pla_str {
 } pla_str;
 
 NODISCARD INTERNAL bool pla_str_is_equal(pla_str stra, char const *const strb) NOEXCEPT {
-        for(usize i = 0;i < stra.length;++i) if(stra.data[i] != strb[i]) return false;
+        //a nul in stra must not walk past the end of strb.
+        for(usize i = 0;i < stra.length;++i) if(strb[i] == '\0' || stra.data[i] != strb[i]) return false;
         if(strb[stra.length] != '\0') return false;
         return true;
 }
@@ -55,6 +81,290 @@ NODISCARD INTERNAL bool pla_str_in(pla_str str, char const * const * strs, usize
         return false;
 }
 
+//CPU dispatch.
+//The byte scanning, digit and conversion kernels have a scalar version and sse4.2, avx2 and avx512 versions picked once from cpuid, so a header compiled for any x86-64 uses what the machine it runs on has.
+//pla_set_isa forces a level for testing, every level gives the same bits as the scalar one. define PLA_NO_SIMD to only build the scalar kernels.
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define pla_atomic_load(pointer) (*(u32 volatile *)(pointer))
+#define pla_atomic_store(pointer, value) (*(u32 volatile *)(pointer) = (value))
+#else
+#define pla_atomic_load(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+#define pla_atomic_store(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+#endif
+
+typedef enum pla_isa{
+        pla_isa_scalar,
+        pla_isa_sse42,
+        pla_isa_avx2,
+        //avx512f and avx512bw.
+        pla_isa_avx512,
+        pla_isa_MAX_ENUM,
+} pla_isa;
+
+char const * const pla_isa_strings[pla_isa_MAX_ENUM] = {"scalar", "sse4.2", "avx2", "avx512"};
+
+typedef struct pla_kernels{
+        //offset of the first of " { } [ ] , : at or after offset, size if there isn't one.
+        usize (*find_json_structural)(u8 const * data, usize size, usize offset);
+        //offset of the first byte at or after offset that isn't json whitespace, size if there isn't one.
+        usize (*skip_json_whitespace)(u8 const * data, usize size, usize offset);
+        //reads up to 16 leading decimal digits in to out_value and returns how many there were.
+        u32 (*parse_digits)(u8 const * data, usize length, u64 * out_value);
+        //out[i] = (f32)in[i] * scale for packed components.
+        void (*convert_s8)(u8 const * in, usize count, f32 scale, f32 * out);
+        void (*convert_u8)(u8 const * in, usize count, f32 scale, f32 * out);
+        void (*convert_s16)(u8 const * in, usize count, f32 scale, f32 * out);
+        void (*convert_u16)(u8 const * in, usize count, f32 scale, f32 * out);
+} pla_kernels;
+
+static inline usize pla_find_json_structural_scalar(u8 const * data, usize size, usize offset){
+        for(; offset < size; ++offset){
+                u8 byte = data[offset];
+                if(byte == '"' || byte == '{' || byte == '}' || byte == '[' || byte == ']' || byte == ',' || byte == ':') return offset;
+        }
+        return size;
+}
+
+static inline usize pla_skip_json_whitespace_scalar(u8 const * data, usize size, usize offset){
+        for(; offset < size; ++offset){
+                u8 byte = data[offset];
+                if(byte != ' ' && byte != '\n' && byte != '\r' && byte != '\t') return offset;
+        }
+        return size;
+}
+
+static inline u32 pla_parse_digits_scalar(u8 const * data, usize length, u64 * out_value){
+        u64 value = 0;
+        u32 count = 0;
+        for(; count < 16 && count < length && (u8)(data[count] - '0') <= 9; ++count) value = value * 10 + (data[count] - '0');
+        *out_value = value;
+        return count;
+}
+
+#define pla_define_convert_scalar(name, type) \
+        static inline void pla_convert_##name##_scalar(u8 const * in, usize count, f32 scale, f32 * out){ \
+                for(usize i = 0; i < count; ++i){ \
+                        type value; \
+                        memcpy(&value, in + i * sizeof(type), sizeof(type)); \
+                        out[i] = (f32)value * scale; \
+                } \
+        }
+pla_define_convert_scalar(s8, s8)
+pla_define_convert_scalar(u8, u8)
+pla_define_convert_scalar(s16, s16)
+pla_define_convert_scalar(u16, u16)
+#undef pla_define_convert_scalar
+
+#if !defined(PLA_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define PLA_X86_SIMD
+#endif
+
+#ifdef PLA_X86_SIMD
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PLA_TARGET(isa)
+static inline u32 pla_count_trailing_zeros_u64(u64 value){ unsigned long index; _BitScanForward64(&index, value); return (u32)index; }
+static inline void pla_cpuid(u32 leaf, u32 subleaf, u32 * registers){ int info[4]; __cpuidex(info, (int)leaf, (int)subleaf); for(u32 i = 0; i < 4; ++i) registers[i] = (u32)info[i]; }
+static inline u64 pla_xgetbv(void){ return _xgetbv(0); }
+#else
+#define PLA_TARGET(isa) __attribute__((target(isa)))
+static inline u32 pla_count_trailing_zeros_u64(u64 value){ return (u32)__builtin_ctzll(value); }
+static inline void pla_cpuid(u32 leaf, u32 subleaf, u32 * registers){ __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]); }
+static inline u64 pla_xgetbv(void){ u32 eax, edx; __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0)); return (u64)edx << 32 | eax; }
+#endif
+
+//'[' and '{' only differ in bit 5, so do ']' and '}', or-ing it in covers both with one compare.
+#define pla_structural_mask(width, prefix, v) \
+        prefix##_or_si##width(prefix##_or_si##width(prefix##_cmpeq_epi8(v, prefix##_set1_epi8('"')), prefix##_cmpeq_epi8(v, prefix##_set1_epi8(','))), \
+        prefix##_or_si##width(prefix##_cmpeq_epi8(v, prefix##_set1_epi8(':')), prefix##_or_si##width( \
+        prefix##_cmpeq_epi8(prefix##_or_si##width(v, prefix##_set1_epi8(0x20)), prefix##_set1_epi8('{')), \
+        prefix##_cmpeq_epi8(prefix##_or_si##width(v, prefix##_set1_epi8(0x20)), prefix##_set1_epi8('}')))))
+
+#define pla_whitespace_mask(width, prefix, v) \
+        prefix##_or_si##width(prefix##_or_si##width(prefix##_cmpeq_epi8(v, prefix##_set1_epi8(' ')), prefix##_cmpeq_epi8(v, prefix##_set1_epi8('\n'))), \
+        prefix##_or_si##width(prefix##_cmpeq_epi8(v, prefix##_set1_epi8('\r')), prefix##_cmpeq_epi8(v, prefix##_set1_epi8('\t'))))
+
+PLA_TARGET("sse4.2") static inline usize pla_find_json_structural_sse42(u8 const * data, usize size, usize offset){
+        for(; offset + 16 <= size; offset += 16){
+                __m128i v = _mm_loadu_si128((__m128i const *)(data + offset));
+                u32 mask = (u32)_mm_movemask_epi8(pla_structural_mask(128, _mm, v));
+                if(mask) return offset + pla_count_trailing_zeros_u64(mask);
+        }
+        return pla_find_json_structural_scalar(data, size, offset);
+}
+
+PLA_TARGET("sse4.2") static inline usize pla_skip_json_whitespace_sse42(u8 const * data, usize size, usize offset){
+        for(; offset + 16 <= size; offset += 16){
+                __m128i v = _mm_loadu_si128((__m128i const *)(data + offset));
+                u32 mask = ~(u32)_mm_movemask_epi8(pla_whitespace_mask(128, _mm, v)) & 0xffff;
+                if(mask) return offset + pla_count_trailing_zeros_u64(mask);
+        }
+        return pla_skip_json_whitespace_scalar(data, size, offset);
+}
+
+PLA_TARGET("avx2") static inline usize pla_find_json_structural_avx2(u8 const * data, usize size, usize offset){
+        for(; offset + 32 <= size; offset += 32){
+                __m256i v = _mm256_loadu_si256((__m256i const *)(data + offset));
+                u32 mask = (u32)_mm256_movemask_epi8(pla_structural_mask(256, _mm256, v));
+                if(mask) return offset + pla_count_trailing_zeros_u64(mask);
+        }
+        return pla_find_json_structural_sse42(data, size, offset);
+}
+
+PLA_TARGET("avx2") static inline usize pla_skip_json_whitespace_avx2(u8 const * data, usize size, usize offset){
+        for(; offset + 32 <= size; offset += 32){
+                __m256i v = _mm256_loadu_si256((__m256i const *)(data + offset));
+                u32 mask = ~(u32)_mm256_movemask_epi8(pla_whitespace_mask(256, _mm256, v));
+                if(mask) return offset + pla_count_trailing_zeros_u64(mask);
+        }
+        return pla_skip_json_whitespace_sse42(data, size, offset);
+}
+
+PLA_TARGET("avx512f,avx512bw") static inline usize pla_find_json_structural_avx512(u8 const * data, usize size, usize offset){
+        for(; offset + 64 <= size; offset += 64){
+                __m512i v = _mm512_loadu_si512((void const *)(data + offset));
+                __m512i folded = _mm512_or_si512(v, _mm512_set1_epi8(0x20));
+                u64 mask = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('"')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(',')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(':'))
+                        | _mm512_cmpeq_epi8_mask(folded, _mm512_set1_epi8('{')) | _mm512_cmpeq_epi8_mask(folded, _mm512_set1_epi8('}'));
+                if(mask) return offset + pla_count_trailing_zeros_u64(mask);
+        }
+        return pla_find_json_structural_avx2(data, size, offset);
+}
+
+PLA_TARGET("avx512f,avx512bw") static inline usize pla_skip_json_whitespace_avx512(u8 const * data, usize size, usize offset){
+        for(; offset + 64 <= size; offset += 64){
+                __m512i v = _mm512_loadu_si512((void const *)(data + offset));
+                u64 mask = ~(_mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(' ')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\n'))
+                        | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\r')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\t')));
+                if(mask) return offset + pla_count_trailing_zeros_u64(mask);
+        }
+        return pla_skip_json_whitespace_avx2(data, size, offset);
+}
+
+//16 digits at once: the run is right aligned with a shuffle, then pairs, quads and eights are combined with multiply adds.
+PLA_TARGET("sse4.2") static inline u32 pla_parse_digits_sse42(u8 const * data, usize length, u64 * out_value){
+        if(length < 16) return pla_parse_digits_scalar(data, length, out_value);
+        static u8 const shift_table[32] = {
+                0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+        };
+        __m128i digits = _mm_sub_epi8(_mm_loadu_si128((__m128i const *)data), _mm_set1_epi8('0'));
+        u32 is_digit = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits));
+        u32 count = pla_count_trailing_zeros_u64(~is_digit | 0x10000);
+        digits = _mm_shuffle_epi8(digits, _mm_loadu_si128((__m128i const *)(shift_table + count)));
+        __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+        __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+        quads = _mm_packus_epi32(quads, quads);
+        __m128i eights = _mm_madd_epi16(quads, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+        *out_value = (u64)(u32)_mm_cvtsi128_si32(eights) * 100000000 + (u32)_mm_extract_epi32(eights, 1);
+        return count;
+}
+
+//lanes components at a time: load, widen to 32 bits, to float, times scale.
+#define pla_define_convert_simd(name, type, isa, target, lanes, vector, load, widen, to_float, multiply, store, set1, scalar) \
+        PLA_TARGET(target) static inline void pla_convert_##name##_##isa(u8 const * in, usize count, f32 scale, f32 * out){ \
+                vector scales = set1(scale); \
+                usize i = 0; \
+                for(; i + lanes <= count; i += lanes) store(out + i, multiply(to_float(widen(load(in + i * sizeof(type)))), scales)); \
+                scalar(in + i * sizeof(type), count - i, scale, out + i); \
+        }
+
+static inline __m128i pla_load_32(u8 const * in){ s32 bits; memcpy(&bits, in, 4); return _mm_cvtsi32_si128(bits); }
+#define pla_load_64(in) _mm_loadl_epi64((__m128i const *)(in))
+#define pla_load_128(in) _mm_loadu_si128((__m128i const *)(in))
+#define pla_load_256(in) _mm256_loadu_si256((__m256i const *)(in))
+
+pla_define_convert_simd(s8, s8, sse42, "sse4.2", 4, __m128, pla_load_32, _mm_cvtepi8_epi32, _mm_cvtepi32_ps, _mm_mul_ps, _mm_storeu_ps, _mm_set1_ps, pla_convert_s8_scalar)
+pla_define_convert_simd(u8, u8, sse42, "sse4.2", 4, __m128, pla_load_32, _mm_cvtepu8_epi32, _mm_cvtepi32_ps, _mm_mul_ps, _mm_storeu_ps, _mm_set1_ps, pla_convert_u8_scalar)
+pla_define_convert_simd(s16, s16, sse42, "sse4.2", 4, __m128, pla_load_64, _mm_cvtepi16_epi32, _mm_cvtepi32_ps, _mm_mul_ps, _mm_storeu_ps, _mm_set1_ps, pla_convert_s16_scalar)
+pla_define_convert_simd(u16, u16, sse42, "sse4.2", 4, __m128, pla_load_64, _mm_cvtepu16_epi32, _mm_cvtepi32_ps, _mm_mul_ps, _mm_storeu_ps, _mm_set1_ps, pla_convert_u16_scalar)
+pla_define_convert_simd(s8, s8, avx2, "avx2", 8, __m256, pla_load_64, _mm256_cvtepi8_epi32, _mm256_cvtepi32_ps, _mm256_mul_ps, _mm256_storeu_ps, _mm256_set1_ps, pla_convert_s8_sse42)
+pla_define_convert_simd(u8, u8, avx2, "avx2", 8, __m256, pla_load_64, _mm256_cvtepu8_epi32, _mm256_cvtepi32_ps, _mm256_mul_ps, _mm256_storeu_ps, _mm256_set1_ps, pla_convert_u8_sse42)
+pla_define_convert_simd(s16, s16, avx2, "avx2", 8, __m256, pla_load_128, _mm256_cvtepi16_epi32, _mm256_cvtepi32_ps, _mm256_mul_ps, _mm256_storeu_ps, _mm256_set1_ps, pla_convert_s16_sse42)
+pla_define_convert_simd(u16, u16, avx2, "avx2", 8, __m256, pla_load_128, _mm256_cvtepu16_epi32, _mm256_cvtepi32_ps, _mm256_mul_ps, _mm256_storeu_ps, _mm256_set1_ps, pla_convert_u16_sse42)
+//gcc's own avx512 widening intrinsics trip its maybe-uninitialized warning.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+pla_define_convert_simd(s8, s8, avx512, "avx512f,avx512bw", 16, __m512, pla_load_128, _mm512_cvtepi8_epi32, _mm512_cvtepi32_ps, _mm512_mul_ps, _mm512_storeu_ps, _mm512_set1_ps, pla_convert_s8_avx2)
+pla_define_convert_simd(u8, u8, avx512, "avx512f,avx512bw", 16, __m512, pla_load_128, _mm512_cvtepu8_epi32, _mm512_cvtepi32_ps, _mm512_mul_ps, _mm512_storeu_ps, _mm512_set1_ps, pla_convert_u8_avx2)
+pla_define_convert_simd(s16, s16, avx512, "avx512f,avx512bw", 16, __m512, pla_load_256, _mm512_cvtepi16_epi32, _mm512_cvtepi32_ps, _mm512_mul_ps, _mm512_storeu_ps, _mm512_set1_ps, pla_convert_s16_avx2)
+pla_define_convert_simd(u16, u16, avx512, "avx512f,avx512bw", 16, __m512, pla_load_256, _mm512_cvtepu16_epi32, _mm512_cvtepi32_ps, _mm512_mul_ps, _mm512_storeu_ps, _mm512_set1_ps, pla_convert_u16_avx2)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#undef pla_define_convert_simd
+#undef pla_load_64
+#undef pla_load_128
+#undef pla_load_256
+#undef pla_structural_mask
+#undef pla_whitespace_mask
+
+//Best level the cpu and the os (saved vector registers) both support.
+static inline pla_isa pla_detect_isa(void){
+        u32 registers[4] = {0};
+        pla_cpuid(0, 0, registers);
+        u32 max_leaf = registers[0];
+        pla_cpuid(1, 0, registers);
+        u32 ecx1 = registers[2];
+        bool sse42 = (ecx1 >> 19 & 1) && (ecx1 >> 20 & 1) && (ecx1 >> 9 & 1);
+        if(!sse42) return pla_isa_scalar;
+        bool osxsave = ecx1 >> 27 & 1;
+        bool avx = ecx1 >> 28 & 1;
+        if(!osxsave || !avx || max_leaf < 7) return pla_isa_sse42;
+        u64 xcr0 = pla_xgetbv();
+        pla_cpuid(7, 0, registers);
+        u32 ebx7 = registers[1];
+        bool avx2 = (ebx7 >> 5 & 1) && (xcr0 & 0x6) == 0x6;
+        if(!avx2) return pla_isa_sse42;
+        bool avx512 = (ebx7 >> 16 & 1) && (ebx7 >> 30 & 1) && (xcr0 & 0xe6) == 0xe6;
+        return avx512 ? pla_isa_avx512 : pla_isa_avx2;
+}
+#else
+static inline pla_isa pla_detect_isa(void){ return pla_isa_scalar; }
+#endif
+
+static pla_kernels const pla_kernel_tables[pla_isa_MAX_ENUM] = {
+        {pla_find_json_structural_scalar, pla_skip_json_whitespace_scalar, pla_parse_digits_scalar, pla_convert_s8_scalar, pla_convert_u8_scalar, pla_convert_s16_scalar, pla_convert_u16_scalar},
+#ifdef PLA_X86_SIMD
+        {pla_find_json_structural_sse42, pla_skip_json_whitespace_sse42, pla_parse_digits_sse42, pla_convert_s8_sse42, pla_convert_u8_sse42, pla_convert_s16_sse42, pla_convert_u16_sse42},
+        //numbers are short, 16 digits at a time is already the whole run.
+        {pla_find_json_structural_avx2, pla_skip_json_whitespace_avx2, pla_parse_digits_sse42, pla_convert_s8_avx2, pla_convert_u8_avx2, pla_convert_s16_avx2, pla_convert_u16_avx2},
+        {pla_find_json_structural_avx512, pla_skip_json_whitespace_avx512, pla_parse_digits_sse42, pla_convert_s8_avx512, pla_convert_u8_avx512, pla_convert_s16_avx512, pla_convert_u16_avx512},
+#endif
+};
+
+//PLA_INDEX_NONE until the first use detects it.
+static u32 pla_active_isa = PLA_INDEX_NONE;
+
+//The best level this machine runs.
+inline pla_isa pla_get_supported_isa(void) NOEXCEPT{
+        return pla_detect_isa();
+}
+
+//Forces the kernels of a level, pla_isa_MAX_ENUM goes back to the detected one. returns false if the machine can't run it.
+//its per translation unit like the rest of the header's statics.
+inline bool pla_set_isa(pla_isa isa) NOEXCEPT{
+        pla_isa supported = pla_detect_isa();
+        if(isa == pla_isa_MAX_ENUM) isa = supported;
+        if(isa > supported) return false;
+        pla_atomic_store(&pla_active_isa, (u32)isa);
+        return true;
+}
+
+inline pla_isa pla_get_isa(void) NOEXCEPT{
+        u32 isa = pla_atomic_load(&pla_active_isa);
+        if(isa == PLA_INDEX_NONE){
+                isa = (u32)pla_detect_isa();
+                pla_atomic_store(&pla_active_isa, isa);
+        }
+        return (pla_isa)isa;
+}
+
+static inline pla_kernels const * pla_get_kernels(void){
+        return &pla_kernel_tables[pla_get_isa()];
+}
 
 NODISCARD INTERNAL s64 pla_str_to_s64(pla_str str) NOEXCEPT{
         if(str.length == 0 || str.data == PLA_NULL) return 0;
@@ -64,39 +374,101 @@ NODISCARD INTERNAL s64 pla_str_to_s64(pla_str str) NOEXCEPT{
         if(str.data[0] == '-') sign = -1;
         for(u64 position = 0 + (sign < 0); position < str.length; ++position){
                 u64 digit = str.data[position] - '0';
-                bool is_valid = (bool)(digit >= 0 || digit <= 9);
-                value = value * 10 + (digit * is_valid);
+                if(digit > 9) break;
+                value = value * 10 + digit;
         }
 
         return value * sign;
 }
 
-NODISCARD INTERNAL f32 pla_str_to_f32(pla_str str) NOEXCEPT{
-        if(str.length == 0 || str.data == PLA_NULL) return 0;
-        f32 sign = 1;
-        f32 value = 0;
-        if(str.data[0] == '-') sign = -1;
-        s64 point_index = -1;
-        for(usize i = 0 + (sign < 0); i < str.length; ++i){
-                if(str.data[i] == '.'){
-                        point_index = i;
-                        continue;
-                }
-                u64 digit = str.data[i] - '0';
-                if(digit >= 0 || digit <= 9){
-                        value = value * 10.0f + (f32)digit;
-                        if(point_index >= 0){
-                                f32 decimal = 10;
-                                for(usize b = 1; b < i-point_index; ++b){
-                                        decimal *= 10.0f;
-                                }
-                                value += (f32)digit/decimal;
+static u64 const pla_u64_powers_of_10[20] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+        10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+        10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+//every power of 10 a double holds exactly.
+static f64 const pla_f64_powers_of_10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+//Adds the run of digits at i to the mantissa while it stays under 19 digits, the digits that don't fit are counted in dropped.
+static inline usize pla_read_digit_run(pla_kernels const * kernels, pla_str str, usize i, u64 * mantissa, u32 * read, u32 * dropped){
+        for(;;){
+                u64 chunk;
+                //short runs aren't worth the call, both give the same chunk.
+                u32 count = str.length - i >= 16 ? kernels->parse_digits(str.data + i, str.length - i, &chunk) : pla_parse_digits_scalar(str.data + i, str.length - i, &chunk);
+                if(count == 0) return i;
+                //the mantissa is under 10^read so the whole chunk fits.
+                if(*dropped == 0 && *read + count <= 19){
+                        *mantissa = *mantissa * pla_u64_powers_of_10[count] + chunk;
+                        *read += count;
+                }else{
+                        for(u32 d = 0; d < count; ++d){
+                                if(*dropped == 0 && *mantissa < pla_u64_powers_of_10[18]){
+                                        *mantissa = *mantissa * 10 + (str.data[i + d] - '0');
+                                        ++*read;
+                                }else ++*dropped;
                         }
                 }
+                i += count;
+        }
+}
+
+//Reads a json number, the digits are gathered in an integer and scaled by exact powers of 10 so there is one rounding in the common case.
+//past 19 significant digits the rest are dropped, leading zeros aren't significant. the result never depends on which kernels are in use.
+//numbers too large for a double are infinite.
+NODISCARD static inline f64 pla_str_to_f64(pla_str str) NOEXCEPT{
+        if(str.length == 0 || str.data == PLA_NULL) return 0;
+        pla_kernels const * kernels = pla_get_kernels();
+        f64 sign = 1;
+        usize i = 0;
+        if(str.data[0] == '-'){
+                sign = -1;
+                ++i;
+        }
+        while(i < str.length && str.data[i] == '0') ++i;
+        u64 mantissa = 0;
+        u32 read = 0;
+        u32 dropped = 0;
+        i = pla_read_digit_run(kernels, str, i, &mantissa, &read, &dropped);
+        //dropped integer digits still count as tens.
+        s32 exponent10 = (s32)(dropped < 400 ? dropped : 400);
+        if(i < str.length && str.data[i] == '.'){
+                ++i;
+                //zeros before the first digit only move the exponent, past 1000 of them the number is 0 whatever the exponent says.
+                if(read == 0){
+                        usize first = i;
+                        while(i < str.length && str.data[i] == '0') ++i;
+                        exponent10 -= (s32)(i - first < 1000 ? i - first : 1000);
+                }
+                u32 integer_read = read;
+                i = pla_read_digit_run(kernels, str, i, &mantissa, &read, &dropped);
+                exponent10 -= (s32)(read - integer_read);
+        }
+        if(i < str.length && (str.data[i] == 'e' || str.data[i] == 'E')){
+                ++i;
+                bool negative_exponent = i < str.length && str.data[i] == '-';
+                if(i < str.length && (str.data[i] == '-' || str.data[i] == '+')) ++i;
+                s32 exponent = 0;
+                for(; i < str.length && (u8)(str.data[i] - '0') <= 9 && exponent < 400; ++i) exponent = exponent * 10 + (str.data[i] - '0');
+                exponent10 += negative_exponent ? -exponent : exponent;
         }
+        f64 value = (f64)mantissa;
+        if(mantissa == 0) return value * sign;
+        //the exponent is bounded so this ends, once it is past the largest double it stays infinite.
+        for(; exponent10 > 22; exponent10 -= 22) value *= 1e22;
+        for(; exponent10 < -22 && value > 0; exponent10 += 22) value /= 1e22;
+        if(exponent10 > 22 || exponent10 < -22) return value * sign;
+        value = exponent10 < 0 ? value / pla_f64_powers_of_10[-exponent10] : value * pla_f64_powers_of_10[exponent10];
         return value * sign;
 }
 
+NODISCARD static inline f32 pla_str_to_f32(pla_str str) NOEXCEPT{
+        return (f32)pla_str_to_f64(str);
+}
+
 typedef struct pla_asset {
         // in data
         pla_str generator;
@@ -107,20 +479,24 @@ typedef struct pla_asset {
 
 typedef struct pla_scene {
         pla_str name;
+        //root nodes, in the index pool.
         u32 *nodes;
-        u8 node_count;
+        u32 node_count;
 } pla_scene;
 
 typedef struct pla_node {
         pla_str name;
+        //PLA_INDEX_NONE if not given.
         u32 mesh;
         u32 skin;
-        // f32 translation[3];
-        // f32 rotation[4];
-        // f32 scale[3];
+        f32 translation[3];
+        f32 rotation[4];
+        f32 scale[3];
+        //local transform, column major. the matrix in the file, or translation * rotation * scale when it only has those.
         f32 matrix[4 * 4];
+        //nodes, in the index pool.
         u32 *children;
-        u8 child_count;
+        u32 child_count;
 } pla_node;
 
 typedef enum pla_mesh_primitive_attribute_name {
@@ -133,8 +509,11 @@ typedef enum pla_mesh_primitive_attribute_name {
         pla_COLOR,
         pla_JOINTS,
         pla_WEIGHTS,
+        pla_mesh_primitive_attribute_name_MAX_ENUM,
 }pla_mesh_primitive_attribute_name;
 
+char const * const pla_mesh_primitive_attribute_name_strings[pla_mesh_primitive_attribute_name_MAX_ENUM] = {"POSITION", "NORMAL", "TANGENT", "TEXCOORD", "COLOR", "JOINTS", "WEIGHTS"};
+
 typedef struct pla_mesh_primitive_attribute{
         u32 accessor;
         pla_mesh_primitive_attribute_name name;
@@ -154,18 +533,29 @@ INTERNAL s8 pla_check_value_is_mesh_primitive_attribute_name_get_set_index(pla_s
         return -1;
 }
 
+//attributes of a morph target are displacements, only POSITION, NORMAL and TANGENT are used.
+typedef struct pla_morph_target{
+        u32 attribute_count;
+        pla_mesh_primitive_attribute * attributes;
+}pla_morph_target;
+
 typedef struct pla_mesh_primitive{
-        u8 attribute_count;
+        u32 attribute_count;
         pla_mesh_primitive_attribute * attributes;
         u32 indices;
         u32 material;
         u32 mode;
+        pla_morph_target * targets;
+        u32 target_count;
 }pla_mesh_primitive;
 
 typedef struct pla_mesh {
         pla_str name;
         pla_mesh_primitive *primitives;
-        u8 primitive_count;
+        u32 primitive_count;
+        //default morph target weights, in the float pool.
+        f32 * weights;
+        u32 weight_count;
 } pla_mesh;
 
 typedef enum pla_GLTF_component_type {
@@ -175,6 +565,7 @@ typedef enum pla_GLTF_component_type {
         pla_GLTF_component_type_u16,
         pla_GLTF_component_type_u32,
         pla_GLTF_component_type_f32,
+        pla_GLTF_component_type_MAX_ENUM,
 } pla_GLTF_component_type;
 
 char const * const pla_GLTF_component_type_strings[6] = {"5120","5121","5122","5123","5125","5126"};
@@ -208,7 +599,7 @@ char const * const pla_GLTF_type_strings[8] = { "SCALAR", "VEC2", "VEC3", "VEC4"
 
 //returns -1 if the string is not a valid component.
 INTERNAL bool lookup_pla_GLTF_type(pla_str str, pla_GLTF_type * type) NOEXCEPT{
-        for(usize i = 0; i < 8; ++i){
+        for(usize i = 0; i < pla_GLTF_type_MAX_ENUM; ++i){
                 if(pla_str_is_equal(str, pla_GLTF_type_strings[i])){
                         *type = (pla_GLTF_type)i;
                         return true;
@@ -227,12 +618,25 @@ u8 const pla_GLTF_type_component_count[8] = {1,2,3,4,4,9,16};
         X(u32, "byteOffset", byte_offset, parse_u32)\
         X(void *, "min", min_values, parse_min_or_max)\
         X(void *, "max", max_values, parse_min_or_max)\
-        X(u32, "count", count, parse_u32)
+        X(u32, "count", count, parse_u32)\
+        X(bool, "normalized", normalized, parse_bool)
+
+//Elements of an accessor that are replaced, indices are strictly increasing.
+typedef struct pla_accessor_sparse{
+        //0 when the accessor isn't sparse.
+        u32 count;
+        u32 indices_buffer_view;
+        u32 indices_byte_offset;
+        pla_GLTF_component_type indices_component_type;
+        u32 values_buffer_view;
+        u32 values_byte_offset;
+} pla_accessor_sparse;
 
 typedef struct{
 #define X(type, _, prop, __) type prop;
 ACESSOR_COMPONENTS
 #undef X
+        pla_accessor_sparse sparse;
         // pla_GLTF_component_type component_type;
         // pla_GLTF_type type;
         // u32 buffer_view;
@@ -250,6 +654,42 @@ ACESSOR_COMPONENTS
         X(u32, "byteStride", byte_stride, parse_u32)\
         X(u32, "target", target, parse_u32)
 
+typedef enum pla_meshopt_mode{
+        pla_meshopt_mode_none,
+        pla_meshopt_mode_attributes,
+        pla_meshopt_mode_triangles,
+        pla_meshopt_mode_indices,
+        pla_meshopt_mode_MAX_ENUM,
+} pla_meshopt_mode;
+
+char const * const pla_meshopt_mode_strings[pla_meshopt_mode_MAX_ENUM] = {"", "ATTRIBUTES", "TRIANGLES", "INDICES"};
+
+typedef enum pla_meshopt_filter{
+        pla_meshopt_filter_none,
+        pla_meshopt_filter_octahedral,
+        pla_meshopt_filter_quaternion,
+        pla_meshopt_filter_exponential,
+        pla_meshopt_filter_MAX_ENUM,
+} pla_meshopt_filter;
+
+char const * const pla_meshopt_filter_strings[pla_meshopt_filter_MAX_ENUM] = {"NONE", "OCTAHEDRAL", "QUATERNION", "EXPONENTIAL"};
+
+//EXT_meshopt_compression on a buffer view, the compressed bytes live in buffer and decode to count * byte_stride bytes.
+#define MESHOPT_COMPRESSION_COMPONENTS \
+        X(u32, "buffer", buffer, parse_u32)\
+        X(u32, "byteOffset", byte_offset, parse_u32)\
+        X(u32, "byteLength", byte_length, parse_u32)\
+        X(u32, "byteStride", byte_stride, parse_u32)\
+        X(u32, "count", count, parse_u32)\
+        X(pla_meshopt_mode, "mode", mode, parse_meshopt_mode)\
+        X(pla_meshopt_filter, "filter", filter, parse_meshopt_filter)
+
+typedef struct pla_meshopt_compression {
+#define X(type, _, prop, __) type prop;
+MESHOPT_COMPRESSION_COMPONENTS
+#undef X
+} pla_meshopt_compression;
+
 typedef struct pla_buffer_view {
 #define X(type, _, prop, __) type prop;
 BUFFER_VIEW_COMPONENTS
@@ -259,17 +699,210 @@ BUFFER_VIEW_COMPONENTS
         // u32 byte_offset;
         // u32 byte_stride;
         // u32 target;
+        //mode is none unless the view uses EXT_meshopt_compression.
+        pla_meshopt_compression meshopt;
+        //the decoded bytes of a compressed view, filled in by pla_decode_meshopt_buffer_views.
+        u8 const * data;
 } pla_buffer_view;
 
 typedef struct pla_buffer {
         pla_str uri;
         u64 byte_length;
+        //the glb bin chunk for the first buffer without a uri, otherwise filled in by pla_resolve_buffers.
+        u8 const * data;
+        void * file_handle;
+        usize file_size;
 } pla_buffer;
 
+typedef struct pla_skin {
+        pla_str name;
+        //accessor of mat4s, PLA_INDEX_NONE means every joint uses the identity.
+        u32 inverse_bind_matrices;
+        //node, PLA_INDEX_NONE if not given.
+        u32 skeleton;
+        //nodes, in the index pool.
+        u32 * joints;
+        u32 joint_count;
+} pla_skin;
+
+typedef enum pla_animation_path{
+        pla_animation_path_translation,
+        pla_animation_path_rotation,
+        pla_animation_path_scale,
+        pla_animation_path_weights,
+        pla_animation_path_MAX_ENUM,
+} pla_animation_path;
+
+char const * const pla_animation_path_strings[pla_animation_path_MAX_ENUM] = {"translation", "rotation", "scale", "weights"};
+
+typedef enum pla_animation_interpolation{
+        pla_animation_interpolation_linear,
+        pla_animation_interpolation_step,
+        pla_animation_interpolation_cubic_spline,
+        pla_animation_interpolation_MAX_ENUM,
+} pla_animation_interpolation;
+
+char const * const pla_animation_interpolation_strings[pla_animation_interpolation_MAX_ENUM] = {"LINEAR", "STEP", "CUBICSPLINE"};
+
+typedef struct pla_animation_channel{
+        u32 sampler;
+        //PLA_INDEX_NONE when the target is given by an extension.
+        u32 target_node;
+        pla_animation_path target_path;
+} pla_animation_channel;
+
+typedef struct pla_animation_sampler{
+        //accessor of key times.
+        u32 input;
+        //accessor of key values, cubic splines have an in tangent, value and out tangent per key.
+        u32 output;
+        pla_animation_interpolation interpolation;
+} pla_animation_sampler;
+
+typedef struct pla_animation{
+        pla_str name;
+        pla_animation_channel * channels;
+        u32 channel_count;
+        pla_animation_sampler * samplers;
+        u32 sampler_count;
+} pla_animation;
+
+typedef struct pla_texture_info{
+        //texture, PLA_INDEX_NONE when the material doesn't have it.
+        u32 index;
+        u32 tex_coord;
+        //scale for normal textures and strength for occlusion textures.
+        f32 scale;
+} pla_texture_info;
+
+typedef enum pla_alpha_mode{
+        pla_alpha_mode_opaque,
+        pla_alpha_mode_mask,
+        pla_alpha_mode_blend,
+        pla_alpha_mode_MAX_ENUM,
+} pla_alpha_mode;
+
+char const * const pla_alpha_mode_strings[pla_alpha_mode_MAX_ENUM] = {"OPAQUE", "MASK", "BLEND"};
+
+typedef struct pla_material{
+        pla_str name;
+        f32 base_color_factor[4];
+        pla_texture_info base_color_texture;
+        f32 metallic_factor;
+        f32 roughness_factor;
+        pla_texture_info metallic_roughness_texture;
+        pla_texture_info normal_texture;
+        pla_texture_info occlusion_texture;
+        pla_texture_info emissive_texture;
+        f32 emissive_factor[3];
+        pla_alpha_mode alpha_mode;
+        f32 alpha_cutoff;
+        bool double_sided;
+} pla_material;
+
+#define TEXTURE_COMPONENTS \
+        X(pla_str, "name", name, parse_str)\
+        X(u32, "sampler", sampler, parse_u32)\
+        X(u32, "source", source, parse_u32)
+
+typedef struct pla_texture{
+#define X(type, _, prop, __) type prop;
+TEXTURE_COMPONENTS
+#undef X
+} pla_texture;
+
+//filters and wraps are the gl enums from the json, filters are 0 when not given.
+#define SAMPLER_COMPONENTS \
+        X(pla_str, "name", name, parse_str)\
+        X(u32, "magFilter", mag_filter, parse_u32)\
+        X(u32, "minFilter", min_filter, parse_u32)\
+        X(u32, "wrapS", wrap_s, parse_u32)\
+        X(u32, "wrapT", wrap_t, parse_u32)
+
+typedef struct pla_sampler{
+#define X(type, _, prop, __) type prop;
+SAMPLER_COMPONENTS
+#undef X
+} pla_sampler;
+
+typedef enum pla_image_format{
+        pla_image_format_unknown,
+        pla_image_format_png,
+        pla_image_format_jpeg,
+        pla_image_format_MAX_ENUM,
+} pla_image_format;
+
+//an image is either a uri or a buffer view with a mime type.
+#define IMAGE_COMPONENTS \
+        X(pla_str, "name", name, parse_str)\
+        X(pla_str, "uri", uri, parse_str)\
+        X(pla_str, "mimeType", mime_type, parse_str)\
+        X(u32, "bufferView", buffer_view, parse_u32)
+
+typedef struct pla_image{
+#define X(type, _, prop, __) type prop;
+IMAGE_COMPONENTS
+#undef X
+        //the encoded file, filled in by pla_resolve_images, images in buffer views point straight into the buffer.
+        u8 const * data;
+        usize data_size;
+        void * file_handle;
+        usize file_size;
+        //read from the file header by pla_resolve_images, nothing is decoded til pla_decode_images.
+        pla_image_format format;
+        u32 width;
+        u32 height;
+        u8 channel_count;
+        //width * height rgba8 pixels, filled in by pla_decode_images.
+        u8 * pixels;
+} pla_image;
+
+typedef enum pla_symbol {
+        pla_symbol_none = 0,
+        pla_symbol_open_square,
+        pla_symbol_close_square,
+        pla_symbol_open_squigily,
+        pla_symbol_close_squigily,
+        pla_symbol_begin_string,
+        pla_symbol_end_string,
+        pla_symbol_colon,
+        pla_symbol_comma,
+} pla_symbol;
+
+typedef enum pla_token {
+        pla_token_key,
+        pla_token_value,
+        pla_token_begin_object,
+        pla_token_end_object,
+        pla_token_begin_array,
+        pla_token_end_array,
+} pla_token;
+
+//One entry per json token, built in one pass over the json so everything after it jumps by index instead of rescanning bytes.
+typedef struct pla_tape_entry{
+        pla_token token;
+        //byte offset of the first byte of the token, the opening quote for strings.
+        u32 offset;
+        //tape index of the last entry of the value, the matching end for objects and arrays and itself for everything else.
+        u32 end;
+        //members of an object or items of an array, bytes of a key or value (strings without the quotes).
+        u32 count;
+} pla_tape_entry;
+
+typedef struct pla_json_tape{
+        pla_tape_entry const * entries;
+        u32 entry_count;
+        //the json the offsets are into.
+        u8 const * json;
+        usize json_size;
+} pla_json_tape;
+
 typedef struct pla_allocator {
         void * user_data;
         void *(*allocate)(void * user_data, usize size);
         void (*free)(void * user_data, void *ptr);
+        //optional, called instead of free with the size that was allocated, for memory like mappings that can't be freed without it.
+        void (*free_sized)(void * user_data, void * ptr, usize size);
 } pla_allocator;
 
 #define ROOT_ARRAYS \
@@ -278,12 +911,34 @@ typedef struct pla_allocator {
         X(pla_mesh *, "meshes", meshes)\
         X(pla_accessor *, "accessors", accessors)\
         X(pla_buffer_view *, "bufferViews", buffer_views)\
-        X(pla_buffer *, "buffers", buffers)
+        X(pla_buffer *, "buffers", buffers)\
+        X(pla_skin *, "skins", skins)\
+        X(pla_animation *, "animations", animations)\
+        X(pla_material *, "materials", materials)\
+        X(pla_texture *, "textures", textures)\
+        X(pla_image *, "images", images)\
+        X(pla_sampler *, "samplers", samplers)
+
+//Memory the elements of the root arrays point into.
+#define ARENA_POOLS \
+        X(pla_mesh_primitive *, mesh_primitives)\
+        X(pla_mesh_primitive_attribute *, mesh_primitive_attributes)\
+        X(u32 *, index_pool)\
+        X(pla_animation_channel *, animation_channels)\
+        X(pla_animation_sampler *, animation_samplers)\
+        X(pla_morph_target *, morph_targets)\
+        X(f32 *, float_pool)\
+        X(pla_tape_entry *, tape_entries)
 
 typedef struct pla_GLTF {
         //non owning pointer to the data in the glb.
         u8 const * bin;
         size_t bin_size;
+        //non owning pointer to the json chunk, the writer copies anything the structs don't hold from here.
+        u8 const * json;
+        size_t json_size;
+        //tape of the json chunk, empty if sizes.tape_entries was 0.
+        pla_json_tape tape;
         pla_asset asset;
         u32 scene;
         #define X(type, _, prop) type prop;
@@ -299,8 +954,9 @@ typedef struct{
         #define X(type, _, prop) u32 prop;
         ROOT_ARRAYS
         #undef X
-        u32 mesh_primitives;
-        u32 mesh_primitive_attributes;
+        #define X(_, prop) u32 prop;
+        ARENA_POOLS
+        #undef X
 } pla_GLTF_sizes;
 
 //Structure that is used to store all the different things that need extra memory.
@@ -308,8 +964,9 @@ typedef struct{
         #define X(type, _, prop) type prop;
         ROOT_ARRAYS
         #undef X
-        pla_mesh_primitive * mesh_primitives;
-        pla_mesh_primitive_attribute * mesh_primitive_attributes;
+        #define X(type, prop) type prop;
+        ARENA_POOLS
+        #undef X
 }pla_GLTF_arena;
 
 typedef struct pla_header {
@@ -324,51 +981,66 @@ typedef struct pla_chunk {
         u8 const *data;
 } pla_chunk;
 
-typedef enum pla_symbol {
-        pla_symbol_none = 0,
-        pla_symbol_open_square,
-        pla_symbol_close_square,
-        pla_symbol_open_squigily,
-        pla_symbol_close_squigily,
-        pla_symbol_begin_string,
-        pla_symbol_end_string,
-        pla_symbol_colon,
-        pla_symbol_comma,
-} pla_symbol;
-
-typedef enum pla_token {
-        pla_token_key,
-        pla_token_value,
-        pla_token_begin_object,
-        pla_token_end_object,
-        pla_token_begin_array,
-        pla_token_end_array,
-} pla_token;
-
 typedef enum pla_root_object{
-        pla_root_accessors,
+        #define X(_, __, prop) pla_root_##prop,
+        ROOT_ARRAYS
+        #undef X
         pla_root_asset,
-        pla_root_bufferViews,
-        pla_root_buffers,
-        pla_root_meshes,
-        pla_root_nodes,
         pla_root_scene,
-        pla_root_scenes,
         pla_root_MAX_ENUM,
         pla_root_none = U8_MAX,
 } pla_root_object;
 
- const char * const pla_root_object_names[] = {
-    "accessors",
-    "asset",
-    "bufferViews",
-    "buffers",
-    "meshes",
-    "nodes",
-    "scene",
-    "scenes",
+char const * const pla_root_object_names[pla_root_MAX_ENUM] = {
+        #define X(_, name, __) name,
+        ROOT_ARRAYS
+        #undef X
+        "asset",
+        "scene",
 };
 
+typedef enum pla_parse_error_code{
+        pla_parse_error_none,
+        //doesn't start with the glb magic or a json object.
+        pla_parse_error_not_gltf,
+        pla_parse_error_glb_version,
+        //the glb header or a chunk says its longer than the file, usually a truncated file.
+        pla_parse_error_glb_length,
+        pla_parse_error_glb_chunk_type,
+        //the json stops in the middle of a value.
+        pla_parse_error_unexpected_end,
+        pla_parse_error_unterminated_string,
+        pla_parse_error_mismatched_bracket,
+        //a symbol where the json or the gltf schema doesn't allow it.
+        pla_parse_error_unexpected_symbol,
+        pla_parse_error_missing_value,
+        //an enum string or number we don't know, like a componentType from an extension.
+        pla_parse_error_unknown_value,
+        pla_parse_error_too_many_items,
+        //the memory or sizes given to the second call don't match the file.
+        pla_parse_error_memory_mismatch,
+        //an index or a byte range that points outside of what it refers to.
+        pla_parse_error_invalid_reference,
+        //the allocator the parse was given couldn't give it memory.
+        pla_parse_error_out_of_memory,
+        pla_parse_error_MAX_ENUM,
+} pla_parse_error_code;
+
+char const * const pla_parse_error_code_strings[pla_parse_error_MAX_ENUM] = {"none", "not gltf", "glb version", "glb length", "glb chunk type", "unexpected end", "unterminated string", "mismatched bracket", "unexpected symbol", "missing value", "unknown value", "too many items", "memory mismatch", "invalid reference", "out of memory"};
+
+#define PLA_PARSE_ERROR_PATH_SIZE 128
+
+//Why a parse failed, its only written on the way out of a failing parse so a parse that works doesn't pay for it.
+typedef struct pla_parse_error{
+        pla_parse_error_code code;
+        //byte offset in to the json chunk, or in to the file for the glb errors.
+        u32 offset;
+        //root member the error is in, pla_root_none for errors outside of them.
+        pla_root_object section;
+        //keys and indices from the root to where it went wrong like "meshes[2].primitives[0].indices", the innermost part is kept if it doesn't fit.
+        char path[PLA_PARSE_ERROR_PATH_SIZE];
+} pla_parse_error;
+
 INTERNAL u64 pla_count_json_symbols(u64 json_size, u8 const *json)  NOEXCEPT{
         u64 token_count = 0;
         for (u8 const *byte = json; byte != json + json_size; ++byte) {
@@ -612,6 +1284,12 @@ typedef struct{
         size_t c;
         size_t size;
         u8 const * data;
+        //optional, counting and skipping jump through the tape when its there.
+        pla_json_tape const * tape;
+        //entry the last tape lookup landed on.
+        u32 * tape_cursor;
+        //optional, only written when a parse fails.
+        pla_parse_error * error;
 }parse_state;
 
 typedef struct{
@@ -621,6 +1299,56 @@ typedef struct{
         pla_GLTF * out_gltf;
 }GLTF_state;
 
+//Errors.
+//Failures come back up as SIZE_MAX, the first one reported is the innermost and keeps its code and offset, the levels it passes on the way out only add their key or index to the path.
+
+static bool pla_set_parse_error(pla_parse_error * error, pla_parse_error_code code, usize offset){
+        if(error && error->code == pla_parse_error_none){
+                error->code = code;
+                error->offset = offset < UINT32_MAX ? (u32)offset : UINT32_MAX;
+        }
+        return false;
+}
+
+static usize pla_fail(parse_state p, pla_parse_error_code code, usize offset){
+        pla_set_parse_error(p.error, code, offset < p.size ? offset : p.size);
+        return SIZE_MAX;
+}
+
+//puts text in front of the path, keys are separated from what comes after them by a dot.
+static void pla_prepend_error_path(pla_parse_error * error, char const * text, usize length){
+        usize path_length = strlen(error->path);
+        bool dot = path_length && error->path[0] != '[';
+        if(path_length + length + dot + 1 > PLA_PARSE_ERROR_PATH_SIZE) return;
+        memmove(error->path + length + dot, error->path, path_length + 1);
+        memcpy(error->path, text, length);
+        if(dot) error->path[length] = '.';
+}
+
+static usize pla_fail_in_member(parse_state p, pla_str key){
+        if(p.error) pla_prepend_error_path(p.error, (char const *)key.data, key.length);
+        return SIZE_MAX;
+}
+
+static usize pla_fail_in_item(parse_state p, usize index){
+        if(!p.error) return SIZE_MAX;
+        char text[24];
+        usize length = sizeof(text);
+        text[--length] = ']';
+        do text[--length] = '0' + index % 10; while(index /= 10);
+        text[--length] = '[';
+        pla_prepend_error_path(p.error, text + length, sizeof(text) - length);
+        return SIZE_MAX;
+}
+
+static usize pla_fail_in_root_member(parse_state p, pla_str key){
+        if(!p.error) return SIZE_MAX;
+        for(u32 i = 0; i < pla_root_MAX_ENUM; ++i){
+                if(pla_str_is_equal(key, pla_root_object_names[i])) p.error->section = (pla_root_object)i;
+        }
+        return pla_fail_in_member(p, key);
+}
+
 //Have no idea wtf to call this.
 #define do_loopy_thing(test1, test2) for(; c < jsize; ++c) if(test1) for(usize c2 = c+1; c2 < jsize; ++c2) if(test2)
 #define check_string_loopy_thing do_loopy_thing(jdata[c] == '"', jdata[c2] == '"')
@@ -630,8 +1358,10 @@ static inline u8 c_byte(parse_state parser){return parser.data[parser.c];}
 
 //returns c + whatever bytes to the end of the value.
 static usize parse_til_next_symbol(parse_state parser){
-        ++parser.c;
-        for(; parser.c < parser.size; ++parser.c){
+        if(parser.c == SIZE_MAX) return SIZE_MAX;
+        //most symbols are a few bytes away, those are found before paying for the kernel call.
+        usize end = parser.c + 9 < parser.size ? parser.c + 9 : parser.size;
+        for(++parser.c; parser.c < end; ++parser.c){
                 switch(c_byte(parser)){
                         case '"': return parser.c;
                         case '{': return parser.c;
@@ -642,7 +1372,8 @@ static usize parse_til_next_symbol(parse_state parser){
                         case ':': return parser.c;
                 }
         }
-        return SIZE_MAX;
+        usize c = pla_get_kernels()->find_json_structural(parser.data, parser.size, parser.c);
+        return c < parser.size ? c : pla_fail(parser, pla_parse_error_unexpected_end, parser.size);
 }
 
 typedef enum{
@@ -667,19 +1398,30 @@ static size_t check_next_symbol_is(parse_state parser, symbol_flags symbols){
         if((close_square & symbols) == close_square && symbol == ']') return parser.c;  
         if((comma & symbols) == comma && symbol == ',') return parser.c;         
         if((colon & symbols) == colon && symbol == ':') return parser.c;         
-        return SIZE_MAX;
+        return pla_fail(parser, pla_parse_error_unexpected_symbol, parser.c);
 }
 
 //checks the next symbol is correct this is only ment to be used in the main function
 #define parse(symbol)\
 p.c = parse_til_next_symbol(p);\
-if(p.c != symbol) return false;
+if(p.c == SIZE_MAX) return SIZE_MAX;\
+if(p.data[p.c] != symbol) return pla_fail(p, pla_parse_error_unexpected_symbol, p.c);
+
+//returns the offset of the closing quote of the string that starts at c.
+static inline size_t parse_til_end_of_string(parse_state p){
+        usize start = p.c;
+        for(++p.c; p.c < p.size; ++p.c){
+                if(c_byte(p) == '\\') ++p.c;
+                else if(c_byte(p) == '"') return p.c;
+        }
+        return pla_fail(p, pla_parse_error_unterminated_string, start);
+}
 
 //return new offset if correct else return SIZE_MAX
 inline size_t try_parse_string(parse_state p, pla_str * out_str){
         p.c = check_next_symbol_is(p, quote);
         if(p.c == SIZE_MAX) return SIZE_MAX;
-        size_t c2 = check_next_symbol_is(p, quote);
+        size_t c2 = parse_til_end_of_string(p);
         if(c2 == SIZE_MAX) return SIZE_MAX;
         out_str->data = p.data+p.c+1;
         out_str->length = c2 -(p.c+1);
@@ -691,51 +1433,271 @@ inline size_t try_parse_string(parse_state p, pla_str * out_str){
 // if(c == SIZE_MAX) return false;
 
 
-static usize try_parse_value(parse_state parser, pla_str *value){
-        parser.c = check_next_symbol_is(parser, colon);
-        if(parser.c == SIZE_MAX) return SIZE_MAX;
-        usize c2 = check_next_symbol_is(parser, quote);
-        if(c2 != SIZE_MAX) {
-                try_parse_string(parser, value);
-        }
-        c2 = check_next_symbol_is(parser, comma & close_squirle);
-        if(c2 == SIZE_MAX) return SIZE_MAX;
-        value->data = parser.data+parser.c+1;
-        value->length = c2 -(parser.c+1);
-        return c2;
+static inline bool is_json_whitespace(u8 byte){
+        return byte == ' ' || byte == '\n' || byte == '\r' || byte == '\t';
 }
 
-#define parse_value \
-pla_str value;\
-p.c = try_parse_value(p, &value);\
-if(p.c == SIZE_MAX) return SIZE_MAX;
+static inline bool pla_build_json_tape_reporting(usize json_size, u8 const * json, u32 * entry_count, pla_tape_entry * entries, pla_parse_error * error){
+        if(!entry_count || json_size > UINT32_MAX) return false;
+        u32 capacity = *entry_count;
+        u32 count = 0;
+        usize depth = 0;
+        //while filling, the innermost open object or array, open entries keep the index of their parent in end til they're closed.
+        u32 open = PLA_INDEX_NONE;
+        bool in_object = false;
+        bool expect_key = false;
+        pla_kernels const * kernels = pla_get_kernels();
+        for(usize c = 0; c < json_size; ++c){
+                if(is_json_whitespace(json[c])){
+                        c = kernels->skip_json_whitespace(json, json_size, c + 1);
+                        if(c == json_size) break;
+                }
+                u8 byte = json[c];
+                if(byte == ':') continue;
+                if(byte == ','){
+                        expect_key = in_object;
+                        continue;
+                }
+                if(entries && count >= capacity) return pla_set_parse_error(error, pla_parse_error_memory_mismatch, c);
+                if(byte == '}' || byte == ']'){
+                        if(depth == 0) return pla_set_parse_error(error, pla_parse_error_mismatched_bracket, c);
+                        --depth;
+                        if(entries){
+                                pla_token begin = byte == '}' ? pla_token_begin_object : pla_token_begin_array;
+                                if(entries[open].token != begin) return pla_set_parse_error(error, pla_parse_error_mismatched_bracket, c);
+                                u32 parent = entries[open].end;
+                                entries[open].end = count;
+                                entries[count].token = byte == '}' ? pla_token_end_object : pla_token_end_array;
+                                entries[count].offset = (u32)c;
+                                entries[count].end = count;
+                                entries[count].count = 0;
+                                open = parent;
+                                in_object = open != PLA_INDEX_NONE && entries[open].token == pla_token_begin_object;
+                        }
+                        expect_key = false;
+                        ++count;
+                        continue;
+                }
 
-//return new offset if correct else return usize max
-static inline usize try_count_items_in_array_or_object(parse_state p, u32 * out_count){
-        p.c = check_next_symbol_is(p, open_squirle & open_square);
-        if(p.c == SIZE_MAX) return SIZE_MAX;
-        usize object_depth = 0;
-        bool in_string = false;
+                usize start = c;
+                u32 length = 0;
+                pla_token token = pla_token_value;
+                if(byte == '{') token = pla_token_begin_object;
+                else if(byte == '[') token = pla_token_begin_array;
+                else if(byte == '"'){
+                        //jump quote to quote, a quote only ends the string if an even number of backslashes come before it.
+                        for(;;){
+                                u8 const * quote = (u8 const *)memchr(json + c + 1, '"', json_size - (c + 1));
+                                if(!quote) return pla_set_parse_error(error, pla_parse_error_unterminated_string, start);
+                                c = (usize)(quote - json);
+                                usize backslashes = 0;
+                                while(json[c - 1 - backslashes] == '\\') ++backslashes;
+                                if(backslashes % 2 == 0) break;
+                        }
+                        token = expect_key ? pla_token_key : pla_token_value;
+                        length = (u32)(c - start - 1);
+                }else{
+                        while(c + 1 < json_size){
+                                u8 next = json[c + 1];
+                                if(next == ',' || next == ']' || next == '}' || next == ':' || is_json_whitespace(next)) break;
+                                ++c;
+                        }
+                        length = (u32)(c - start + 1);
+                }
 
-        for (; p.c < p.size; ++p.c){
-                p.c = parse_til_next_symbol(p);
-                switch(c_byte(p)){
-                        case '"' : if(p.data[p.c-1] != '\\')in_string = (bool)!in_string;
-                        case '{': case '[': ++object_depth; continue;
-                        case '}': case ']': 
-                                if(object_depth == 0) return p.c;
-                                --object_depth; 
-                                if(object_depth == 0) ++*out_count;
-                                continue;
-                        case ',': if(object_depth == 0) continue;
+                if(entries){
+                        //objects count their keys, arrays count their values.
+                        if(open != PLA_INDEX_NONE && (token == pla_token_key || !in_object)) ++entries[open].count;
+                        entries[count].token = token;
+                        entries[count].offset = (u32)start;
+                        entries[count].end = count;
+                        entries[count].count = length;
+                        if(token == pla_token_begin_object || token == pla_token_begin_array){
+                                entries[count].end = open;
+                                open = count;
+                                in_object = token == pla_token_begin_object;
+                        }
                 }
+                if(token == pla_token_begin_object || token == pla_token_begin_array) ++depth;
+                expect_key = token == pla_token_begin_object;
+                ++count;
         }
-        return SIZE_MAX;
+        if(depth) return pla_set_parse_error(error, pla_parse_error_unexpected_end, json_size);
+        *entry_count = count;
+        return true;
 }
 
-#define parse_begining_of_root_array(property_name, count_name)\
-        bool has_space = arena && arena->property_name && out_gltf; \
-        if(has_space) out_gltf->property_name = arena->property_name; \
+//Builds the tape of the json in one pass, with entries null it only counts them.
+//entry_count is the capacity of entries going in and the number of entries coming out.
+//returns false if the brackets don't match or a string doesn't end.
+inline bool pla_build_json_tape(usize json_size, u8 const * json, u32 * entry_count, pla_tape_entry * entries) NOEXCEPT{
+        return pla_build_json_tape_reporting(json_size, json, entry_count, entries, PLA_NULL);
+}
+
+//Finds the entry that starts at offset, PLA_INDEX_NONE if there isn't one.
+//the entries after the cursor are checked first since the parser mostly moves forward, then its a binary search.
+inline u32 pla_tape_find_offset(pla_json_tape const * tape, usize offset, u32 * cursor) NOEXCEPT{
+        u32 i = cursor ? *cursor : 0;
+        for(u32 step = 0; cursor && step < 4 && i < tape->entry_count && tape->entries[i].offset <= offset; ++step, ++i){
+                if(tape->entries[i].offset == offset){
+                        *cursor = i;
+                        return i;
+                }
+        }
+        u32 low = 0;
+        u32 high = tape->entry_count;
+        while(low < high){
+                u32 middle = low + (high - low) / 2;
+                if(tape->entries[middle].offset < offset) low = middle + 1;
+                else high = middle;
+        }
+        if(low >= tape->entry_count || tape->entries[low].offset != offset) return PLA_INDEX_NONE;
+        if(cursor) *cursor = low;
+        return low;
+}
+
+//The entry after the value that begins at index, for walking the items of an object or array.
+INTERNAL u32 pla_tape_next(pla_json_tape const * tape, u32 index) NOEXCEPT{
+        return tape->entries[index].end + 1;
+}
+
+//The text of a key or value, strings are without their quotes and still escaped.
+inline pla_str pla_tape_get_str(pla_json_tape const * tape, u32 index) NOEXCEPT{
+        pla_tape_entry const * entry = &tape->entries[index];
+        pla_str str = {0};
+        if(entry->token != pla_token_key && entry->token != pla_token_value) return str;
+        bool is_string = tape->json[entry->offset] == '"';
+        str.data = tape->json + entry->offset + is_string;
+        str.length = entry->count;
+        return str;
+}
+
+//Index of the value of key in the object that begins at entry object, PLA_INDEX_NONE if its not there.
+inline u32 pla_tape_find_member(pla_json_tape const * tape, u32 object, c_str key) NOEXCEPT{
+        if(object >= tape->entry_count || tape->entries[object].token != pla_token_begin_object) return PLA_INDEX_NONE;
+        u32 end = tape->entries[object].end;
+        for(u32 i = object + 1; i < end; i = pla_tape_next(tape, i + 1)){
+                if(pla_str_is_equal(pla_tape_get_str(tape, i), key)) return i + 1;
+        }
+        return PLA_INDEX_NONE;
+}
+
+//the tape entry of the value that starts at p.c, PLA_INDEX_NONE without a tape.
+static inline u32 pla_tape_entry_at(parse_state p){
+        if(!p.tape || !p.tape_cursor) return PLA_INDEX_NONE;
+        return pla_tape_find_offset(p.tape, p.c, p.tape_cursor);
+}
+
+//returns the offset of the last byte of the value, strings are returned without quotes.
+static usize try_parse_value(parse_state parser, pla_str *value){
+        parser.c = check_next_symbol_is(parser, colon);
+        if(parser.c == SIZE_MAX) return SIZE_MAX;
+        usize c2 = parse_til_next_symbol(parser);
+        if(c2 == SIZE_MAX) return SIZE_MAX;
+        if(parser.data[c2] == '"') return try_parse_string(parser, value);
+        if(parser.data[c2] != ',' && parser.data[c2] != '}' && parser.data[c2] != ']') return pla_fail(parser, pla_parse_error_unexpected_symbol, c2);
+        usize begin = parser.c + 1;
+        usize end = c2;
+        while(begin < end && is_json_whitespace(parser.data[begin])) ++begin;
+        while(end > begin && is_json_whitespace(parser.data[end - 1])) --end;
+        if(begin == end) return pla_fail(parser, pla_parse_error_missing_value, c2);
+        value->data = parser.data + begin;
+        value->length = end - begin;
+        return end - 1;
+}
+
+//skips a whole value (string, number, object or array) starting after c, returns the offset of its last byte.
+static usize try_skip_json_value(parse_state p){
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        for(++p.c; p.c < p.size && is_json_whitespace(c_byte(p)); ++p.c);
+        if(p.c >= p.size) return pla_fail(p, pla_parse_error_unexpected_end, p.size);
+        u32 entry = pla_tape_entry_at(p);
+        if(entry != PLA_INDEX_NONE){
+                pla_tape_entry const * e = &p.tape->entries[entry];
+                *p.tape_cursor = e->end + 1;
+                if(e->token == pla_token_begin_object || e->token == pla_token_begin_array) return p.tape->entries[e->end].offset;
+                if(c_byte(p) == '"') return e->offset + e->count + 1;
+                if(e->token == pla_token_value) return e->offset + e->count - 1;
+        }
+        switch(c_byte(p)){
+                case '"': return parse_til_end_of_string(p);
+                case '{': case '[': {
+                        usize depth = 0;
+                        for(; p.c < p.size; ++p.c){
+                                switch(c_byte(p)){
+                                        case '"': p.c = parse_til_end_of_string(p); if(p.c == SIZE_MAX) return SIZE_MAX; continue;
+                                        case '{': case '[': ++depth; continue;
+                                        case '}': case ']': if(--depth == 0) return p.c; continue;
+                                }
+                        }
+                        return pla_fail(p, pla_parse_error_unexpected_end, p.size);
+                }
+                case ',': case ':': case '}': case ']': return pla_fail(p, pla_parse_error_missing_value, p.c);
+        }
+        for(; p.c + 1 < p.size; ++p.c){
+                u8 next = p.data[p.c + 1];
+                if(next == ',' || next == '}' || next == ']' || is_json_whitespace(next)) return p.c;
+        }
+        return pla_fail(p, pla_parse_error_unexpected_end, p.size);
+}
+
+//skips the colon and the value of a key we don't care about.
+static usize try_skip_value(parse_state p){
+        p.c = check_next_symbol_is(p, colon);
+        return try_skip_json_value(p);
+}
+
+#define parse_value \
+pla_str value;\
+p.c = try_parse_value(p, &value);\
+if(p.c == SIZE_MAX) return SIZE_MAX;
+
+//counts the items in the array or object that opens at c, returns the offset of its closing symbol.
+static inline usize count_items_in_array_or_object_at(parse_state p, u32 * out_count){
+        u32 entry = pla_tape_entry_at(p);
+        if(entry != PLA_INDEX_NONE && (p.tape->entries[entry].token == pla_token_begin_object || p.tape->entries[entry].token == pla_token_begin_array)){
+                *out_count = p.tape->entries[entry].count;
+                *p.tape_cursor = entry + 1;
+                return p.tape->entries[p.tape->entries[entry].end].offset;
+        }
+        usize object_depth = 0;
+        bool is_empty = true;
+        u32 count = 0;
+        for (; p.c < p.size; ++p.c){
+                switch(c_byte(p)){
+                        case '"': 
+                                p.c = parse_til_end_of_string(p);
+                                if(p.c == SIZE_MAX) return SIZE_MAX;
+                                is_empty = false;
+                                continue;
+                        case '{': case '[': 
+                                if(object_depth != 0) is_empty = false;
+                                ++object_depth; 
+                                continue;
+                        case '}': case ']': 
+                                --object_depth; 
+                                if(object_depth == 0){
+                                        *out_count = is_empty ? 0 : count + 1;
+                                        return p.c;
+                                }
+                                continue;
+                        case ',': if(object_depth == 1) ++count; continue;
+                        default: if(!is_json_whitespace(c_byte(p))) is_empty = false; continue;
+                }
+        }
+        return pla_fail(p, pla_parse_error_unexpected_end, p.size);
+}
+
+//return new offset if correct else return usize max
+static inline usize try_count_items_in_array_or_object(parse_state p, u32 * out_count){
+        p.c = check_next_symbol_is(p, open_squirle | open_square);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        return count_items_in_array_or_object_at(p, out_count);
+}
+
+#define parse_begining_of_root_array(property_name, count_name)\
+        bool has_space = arena && arena->property_name && out_gltf; \
+        if(has_space) out_gltf->property_name = arena->property_name; \
         parse(':'); \
         u32 count_name = 0; \
         if(try_count_items_in_array_or_object(jsize, jdata, c, &count_name) == SIZE_MAX) return false; \
@@ -743,7 +1705,6 @@ static inline usize try_count_items_in_array_or_object(parse_state p, u32 * out_
         parse('[');
 
 #define parse_array_object_key\
-        u32 buffer_view_components = 0; \
         pla_str key = {0}; \
         p.c = try_parse_string(p, &key); \
         if(p.c == SIZE_MAX) return SIZE_MAX;
@@ -751,18 +1712,18 @@ static inline usize try_count_items_in_array_or_object(parse_state p, u32 * out_
 #define parse_object_value(name, out_value, parser) \
                 else if(pla_str_is_equal(key, name) && has_space){ \
                         p.c = parser(p, has_space, &out_value);\
-                        if(p.c == SIZE_MAX)return SIZE_MAX;\
+                        if(p.c == SIZE_MAX) return pla_fail_in_member(p, key);\
                 }
 
 static inline size_t parse_component_type(parse_state p, bool has_space, pla_GLTF_component_type * component_type){
         parse_value
-        if(has_space) if(!lookup_component_type(value, component_type)) return SIZE_MAX;
+        if(has_space) if(!lookup_component_type(value, component_type)) return pla_fail(p, pla_parse_error_unknown_value, value.data - p.data);
         return p.c;
 }
 
 static inline size_t parse_gltf_type(parse_state p, bool has_space, pla_GLTF_type * type){
         parse_value
-        if(has_space) if(!lookup_pla_GLTF_type(value, type)) return SIZE_MAX;
+        if(has_space) if(!lookup_pla_GLTF_type(value, type)) return pla_fail(p, pla_parse_error_unknown_value, value.data - p.data);
         return p.c;
 }
 
@@ -773,204 +1734,822 @@ static inline size_t parse_u32(parse_state p, bool has_space, u32 * out_value){
         return p.c;
 }
 
+static inline size_t parse_str(parse_state p, bool has_space, pla_str * out_value){
+        parse_value
+        if(has_space) *out_value = value;
+        return p.c;
+}
+
+static inline size_t parse_f32(parse_state p, bool has_space, f32 * out_value){
+        parse_value
+        if(has_space) *out_value = pla_str_to_f32(value);
+        return p.c;
+}
+
+static inline size_t parse_bool(parse_state p, bool has_space, bool * out_value){
+        parse_value
+        if(has_space) *out_value = pla_str_is_equal(value, "true");
+        return p.c;
+}
+
+//opens the object of an array element and bails out early if its empty.
+#define parse_array_object_begin(components)\
+        u32 components = 0; \
+        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX; \
+        parse('{'); \
+        if(components == 0) return check_next_symbol_is(p, close_squirle);
+
+//moves past the comma or closing squigily after an object member.
+#define parse_end_of_member \
+        if(p.c == SIZE_MAX) return pla_fail_in_member(p, key); \
+        p.c = check_next_symbol_is(p, comma | close_squirle); \
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+
+static inline size_t parse_meshopt_mode(parse_state p, bool has_space, pla_meshopt_mode * mode){
+        parse_value
+        for(usize i = 1; i < pla_meshopt_mode_MAX_ENUM; ++i){
+                if(pla_str_is_equal(value, pla_meshopt_mode_strings[i])){
+                        if(has_space) *mode = (pla_meshopt_mode)i;
+                        return p.c;
+                }
+        }
+        return pla_fail(p, pla_parse_error_unknown_value, value.data - p.data);
+}
+
+static inline size_t parse_meshopt_filter(parse_state p, bool has_space, pla_meshopt_filter * filter){
+        parse_value
+        for(usize i = 0; i < pla_meshopt_filter_MAX_ENUM; ++i){
+                if(pla_str_is_equal(value, pla_meshopt_filter_strings[i])){
+                        if(has_space) *filter = (pla_meshopt_filter)i;
+                        return p.c;
+                }
+        }
+        return pla_fail(p, pla_parse_error_unknown_value, value.data - p.data);
+}
+
 //stub to defer parsing til after everyting else has been parsed.
 static inline size_t parse_min_or_max(parse_state p, bool has_spae, void ** min_max){ *min_max = NULL; return p.c; }
 
 
 
+//returns the offset of the last byte of the array item that starts after c.
+static usize try_parse_array_item(parse_state parser, pla_str * value){
+        usize c2 = parse_til_next_symbol(parser);
+        if(c2 == SIZE_MAX) return SIZE_MAX;
+        if(parser.data[c2] == '"') return try_parse_string(parser, value);
+        if(parser.data[c2] != ',' && parser.data[c2] != ']') return pla_fail(parser, pla_parse_error_unexpected_symbol, c2);
+        usize begin = parser.c + 1;
+        usize end = c2;
+        while(begin < end && is_json_whitespace(parser.data[begin])) ++begin;
+        while(end > begin && is_json_whitespace(parser.data[end - 1])) --end;
+        if(begin == end) return pla_fail(parser, pla_parse_error_missing_value, c2);
+        value->data = parser.data + begin;
+        value->length = end - begin;
+        return end - 1;
+}
+
+//reads the array of indices after the key into the index pool.
+static inline size_t parse_index_array(parse_state p, bool has_space, GLTF_state * out_state, u32 ** out_indices, u32 * out_count){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        u32 count = 0;
+        if(try_count_items_in_array_or_object(p, &count) == SIZE_MAX) return SIZE_MAX;
+        u32 * indices = has_space ? out_state->arena->index_pool + out_state->sizes.index_pool : PLA_NULL;
+        out_state->sizes.index_pool += count;
+        if(has_space && out_state->sizes.index_pool > out_state->in_sizes->index_pool) return pla_fail(p, pla_parse_error_memory_mismatch, p.c);
+        parse('[');
+        if(count == 0) p.c = check_next_symbol_is(p, close_square);
+        for(u32 i = 0; i < count; ++i){
+                pla_str value = {0};
+                p.c = try_parse_array_item(p, &value);
+                if(p.c == SIZE_MAX) return pla_fail_in_item(p, i);
+                if(has_space) indices[i] = pla_str_to_s64(value);
+                p.c = check_next_symbol_is(p, comma | close_square);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+        }
+        if(has_space){
+                *out_indices = indices;
+                *out_count = count;
+        }
+        return p.c;
+}
+
+//reads the array of floats after the key into the float pool.
+static inline size_t parse_float_pool_array(parse_state p, bool has_space, GLTF_state * out_state, f32 ** out_values, u32 * out_count){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        u32 count = 0;
+        if(try_count_items_in_array_or_object(p, &count) == SIZE_MAX) return SIZE_MAX;
+        f32 * values = has_space ? out_state->arena->float_pool + out_state->sizes.float_pool : PLA_NULL;
+        out_state->sizes.float_pool += count;
+        if(has_space && out_state->sizes.float_pool > out_state->in_sizes->float_pool) return pla_fail(p, pla_parse_error_memory_mismatch, p.c);
+        parse('[');
+        if(count == 0) p.c = check_next_symbol_is(p, close_square);
+        for(u32 i = 0; i < count; ++i){
+                pla_str value = {0};
+                p.c = try_parse_array_item(p, &value);
+                if(p.c == SIZE_MAX) return pla_fail_in_item(p, i);
+                if(has_space) values[i] = pla_str_to_f32(value);
+                p.c = check_next_symbol_is(p, comma | close_square);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+        }
+        if(has_space){
+                *out_values = values;
+                *out_count = count;
+        }
+        return p.c;
+}
+
+static inline size_t parse_accessor_sparse_indices(parse_state p, bool has_space, pla_accessor_sparse * out_sparse){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("bufferView", out_sparse->indices_buffer_view, parse_u32)
+                parse_object_value("byteOffset", out_sparse->indices_byte_offset, parse_u32)
+                parse_object_value("componentType", out_sparse->indices_component_type, parse_component_type)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_accessor_sparse_values(parse_state p, bool has_space, pla_accessor_sparse * out_sparse){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("bufferView", out_sparse->values_buffer_view, parse_u32)
+                parse_object_value("byteOffset", out_sparse->values_byte_offset, parse_u32)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_accessor_sparse(parse_state p, bool has_space, pla_accessor_sparse * out_sparse){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("count", out_sparse->count, parse_u32)
+                else if(pla_str_is_equal(key, "indices")) p.c = parse_accessor_sparse_indices(p, has_space, out_sparse);
+                else if(pla_str_is_equal(key, "values")) p.c = parse_accessor_sparse_values(p, has_space, out_sparse);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
 static inline size_t parse_accessors(parse_state p, bool has_space, GLTF_state * out_state, pla_accessor * out_accessor){
         size_t min_c = SIZE_MAX;
         size_t max_c = SIZE_MAX;
 
-        u32 components = 0;
-        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX;
-        parse('{');
+        if(has_space){
+                memset(out_accessor, 0, sizeof(*out_accessor));
+                out_accessor->buffer_view = PLA_INDEX_NONE;
+                out_accessor->sparse.indices_buffer_view = PLA_INDEX_NONE;
+                out_accessor->sparse.values_buffer_view = PLA_INDEX_NONE;
+        }
+        parse_array_object_begin(components)
         for(u32 i = 0; i < components; ++i){
                 parse_array_object_key
 
                 //This is to deffer parsing this until after we've parsed the type its supposed to be.
                 if(pla_str_is_equal(key, "min")){
-                        p.c = check_next_symbol_is(p, colon);
-                        if(p.c == SIZE_MAX)return SIZE_MAX;
-                        p.c = check_next_symbol_is(p, open_square);
                         min_c = p.c;
-                        if(p.c == SIZE_MAX)return SIZE_MAX;
-                        for(; p.c < p.size; ++p.c){
-                                if(c_byte(p) == ']'){
-                                        ++p.c;
-                                        if(c_byte(p) == ',') break;
-                                        else return SIZE_MAX;
-                                } 
-                        }
+                        p.c = try_skip_value(p);
                 }else if(pla_str_is_equal(key, "max")){
-                        p.c = check_next_symbol_is(p, colon);
-                        if(p.c == SIZE_MAX)return SIZE_MAX;
-                        p.c = check_next_symbol_is(p, open_square);
                         max_c = p.c;
-                        if(p.c == SIZE_MAX)return SIZE_MAX;
-                        for(; p.c < p.size; ++p.c){
-                                if(c_byte(p) == ']'){
-                                        ++p.c;
-                                        if(c_byte(p) == ',') break;
-                                        else return SIZE_MAX;
-                                } 
-                        }
-                } 
+                        p.c = try_skip_value(p);
+                }
+                else if(pla_str_is_equal(key, "sparse")) p.c = parse_accessor_sparse(p, has_space, has_space ? &out_accessor->sparse : PLA_NULL);
                 #define X(type, name, prop, parser) \
                 else if(pla_str_is_equal(key, name) && has_space){ \
                         p.c = parser(p, has_space, &out_accessor->prop);\
-                        if(p.c == SIZE_MAX)return SIZE_MAX;\
+                        if(p.c == SIZE_MAX) return pla_fail_in_member(p, key);\
                 }
                 ACESSOR_COMPONENTS
                 #undef X
-                p.c = check_next_symbol_is(p, comma & close_squirle);
-                if(p.c == SIZE_MAX) return p.c;
+                else p.c = try_skip_value(p);
+                parse_end_of_member
         }
         //TODO: parse min max.
         return p.c;
 }
 
 static inline size_t parse_buffers(parse_state p, bool has_space, GLTF_state * out_state, pla_buffer * out_buffer){
-        u32 components = 0;
-        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX;
-        parse('{');
+        if(has_space) memset(out_buffer, 0, sizeof(*out_buffer));
+        parse_array_object_begin(components)
         for(u32 i = 0; i < components; ++i){
                 parse_array_object_key;
                 if(pla_str_is_equal(key, "uri")){
-                        p.c = try_parse_value(p, &out_buffer->uri);
+                        pla_str uri = {0};
+                        p.c = try_parse_value(p, &uri);
+                        if(has_space) out_buffer->uri = uri;
                 }else if(pla_str_is_equal(key, "byteLength")){
-                        p.c = parse_u32(p, has_space, (u32*)&out_buffer->byte_length);
-                }
+                        u32 byte_length = 0;
+                        p.c = parse_u32(p, has_space, &byte_length);
+                        if(has_space) out_buffer->byte_length = byte_length;
+                }else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
 
-                if(p.c == SIZE_MAX) return SIZE_MAX;
-                p.c = check_next_symbol_is(p, comma & close_squirle);
-                if(p.c == SIZE_MAX) return p.c;
+static inline size_t parse_meshopt_compression(parse_state p, bool has_space, pla_meshopt_compression * out_meshopt){
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                #define X(type, name, prop, parser) parse_object_value(name, out_meshopt->prop, parser)
+                MESHOPT_COMPRESSION_COMPONENTS
+                #undef X
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_buffer_view_extensions(parse_state p, bool has_space, pla_buffer_view * out_buffer_view){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(pla_str_is_equal(key, "EXT_meshopt_compression") || pla_str_is_equal(key, "KHR_meshopt_compression")){
+                        p.c = check_next_symbol_is(p, colon);
+                        p.c = parse_meshopt_compression(p, has_space, &out_buffer_view->meshopt);
+                }else p.c = try_skip_value(p);
+                parse_end_of_member
         }
-        pla_str uri;
-        u64 byte_length;
         return p.c;
 }
 
 static inline size_t parse_buffer_views(parse_state p, bool has_space, GLTF_state * out_state, pla_buffer_view * out_buffer_views){
-        u32 components = 0;
-        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX;
-        parse('{');
+        if(has_space) memset(out_buffer_views, 0, sizeof(*out_buffer_views));
+        parse_array_object_begin(components)
         for(u32 i = 0; i < components; ++i){
                 parse_array_object_key
-                if(1);
+                if(0);
                 #define X(type, name, prop, parser) parse_object_value(name, out_buffer_views->prop, parser)
                 BUFFER_VIEW_COMPONENTS
                 #undef X
-                p.c = check_next_symbol_is(p, comma & close_squirle);
-                if(p.c == SIZE_MAX) return p.c;
+                else if(pla_str_is_equal(key, "extensions") && has_space) p.c = parse_buffer_view_extensions(p, has_space, out_buffer_views);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
         }
         return p.c;
 }
 
-static inline size_t parse_meshes(parse_state p, bool has_space, GLTF_state * out_state, pla_mesh * out_mesh){
-        u32 components = 0;
-        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX;
+//reads the array of objects after the key into one of the arena pools.
+#define parse_pool_array(type, pool, parser, out_items, out_count) { \
+        p.c = check_next_symbol_is(p, colon); \
+        if(p.c == SIZE_MAX) return pla_fail_in_member(p, key); \
+        u32 count = 0; \
+        if(try_count_items_in_array_or_object(p, &count) == SIZE_MAX) return pla_fail_in_member(p, key); \
+        type * items = has_space ? out_state->arena->pool + out_state->sizes.pool : PLA_NULL; \
+        out_state->sizes.pool += count; \
+        if(has_space && out_state->sizes.pool > out_state->in_sizes->pool){ pla_fail(p, pla_parse_error_memory_mismatch, p.c); return pla_fail_in_member(p, key); } \
+        if(has_space){ \
+                out_items = items; \
+                out_count = count; \
+        } \
+        p.c = check_next_symbol_is(p, open_square); \
+        if(count == 0) p.c = check_next_symbol_is(p, close_square); \
+        if(p.c == SIZE_MAX) return pla_fail_in_member(p, key); \
+        for(u32 item = 0; item < count; ++item){ \
+                p.c = parser(p, has_space, out_state, has_space ? &items[item] : PLA_NULL); \
+                if(p.c == SIZE_MAX){ pla_fail_in_item(p, item); return pla_fail_in_member(p, key); } \
+                p.c = check_next_symbol_is(p, comma | close_square); \
+                if(p.c == SIZE_MAX) return pla_fail_in_member(p, key); \
+        } \
+}
+
+//POSITION, NORMAL and TANGENT by their exact name, the others as <NAME>_<set index> with nothing but digits after the _. anything else is a custom attribute like _BATCHID.
+static inline bool lookup_mesh_primitive_attribute_name(pla_str key, pla_mesh_primitive_attribute * attribute){
+        for(usize i = 0; i < pla_TEXCOORD; ++i){
+                if(!pla_str_is_equal(key, pla_mesh_primitive_attribute_name_strings[i])) continue;
+                attribute->name = (pla_mesh_primitive_attribute_name)i;
+                attribute->set_index = 0;
+                return true;
+        }
+        for(usize i = pla_TEXCOORD; i < pla_mesh_primitive_attribute_name_MAX_ENUM; ++i){
+                char const * name = pla_mesh_primitive_attribute_name_strings[i];
+                usize length = strlen(name);
+                if(key.length < length + 2 || memcmp(key.data, name, length) != 0 || key.data[length] != '_') continue;
+                u32 set_index = 0;
+                for(usize c = length + 1; c < key.length; ++c){
+                        u8 digit = (u8)(key.data[c] - '0');
+                        if(digit > 9) return false;
+                        set_index = set_index * 10 + digit;
+                        if(set_index > 127) return false;
+                }
+                attribute->name = (pla_mesh_primitive_attribute_name)i;
+                attribute->set_index = (s8)set_index;
+                return true;
+        }
+        return false;
+}
+
+static inline size_t parse_mesh_primitive_attributes(parse_state p, bool has_space, GLTF_state * out_state, pla_mesh_primitive_attribute ** out_attributes, u32 * out_attribute_count){
+        u32 attribute_count = 0;
+        if(try_count_items_in_array_or_object(p, &attribute_count) == SIZE_MAX) return SIZE_MAX;
+        pla_mesh_primitive_attribute * attributes = has_space ? out_state->arena->mesh_primitive_attributes + out_state->sizes.mesh_primitive_attributes : PLA_NULL;
+        out_state->sizes.mesh_primitive_attributes += attribute_count;
+        if(has_space && out_state->sizes.mesh_primitive_attributes > out_state->in_sizes->mesh_primitive_attributes) return pla_fail(p, pla_parse_error_memory_mismatch, p.c);
         parse('{');
+        if(attribute_count == 0) return check_next_symbol_is(p, close_squirle);
+
+        u32 stored_count = 0;
+        for(u32 i = 0; i < attribute_count; ++i){
+                parse_array_object_key
+                pla_mesh_primitive_attribute attribute = {0};
+                if(lookup_mesh_primitive_attribute_name(key, &attribute)){
+                        p.c = parse_u32(p, true, &attribute.accessor);
+                        if(has_space) attributes[stored_count++] = attribute;
+                }else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        if(has_space){
+                *out_attributes = attributes;
+                *out_attribute_count = stored_count;
+        }
+        return p.c;
+}
+
+static inline size_t parse_morph_target(parse_state p, bool has_space, GLTF_state * out_state, pla_morph_target * out_target){
+        if(has_space) memset(out_target, 0, sizeof(*out_target));
+        return parse_mesh_primitive_attributes(p, has_space, out_state, has_space ? &out_target->attributes : PLA_NULL, has_space ? &out_target->attribute_count : PLA_NULL);
+}
+
+static inline size_t parse_mesh_primitive(parse_state p, bool has_space, GLTF_state * out_state, pla_mesh_primitive * out_primitive){
+        if(has_space){
+                memset(out_primitive, 0, sizeof(*out_primitive));
+                out_primitive->indices = PLA_INDEX_NONE;
+                out_primitive->material = PLA_INDEX_NONE;
+                out_primitive->mode = 4;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(pla_str_is_equal(key, "attributes")){
+                        p.c = check_next_symbol_is(p, colon);
+                        p.c = parse_mesh_primitive_attributes(p, has_space, out_state, has_space ? &out_primitive->attributes : PLA_NULL, has_space ? &out_primitive->attribute_count : PLA_NULL);
+                }
+                else if(pla_str_is_equal(key, "targets")) parse_pool_array(pla_morph_target, morph_targets, parse_morph_target, out_primitive->targets, out_primitive->target_count)
+                else if(pla_str_is_equal(key, "indices") && has_space) p.c = parse_u32(p, has_space, &out_primitive->indices);
+                else if(pla_str_is_equal(key, "material") && has_space) p.c = parse_u32(p, has_space, &out_primitive->material);
+                else if(pla_str_is_equal(key, "mode") && has_space) p.c = parse_u32(p, has_space, &out_primitive->mode);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_meshes(parse_state p, bool has_space, GLTF_state * out_state, pla_mesh * out_mesh){
+        if(has_space) memset(out_mesh, 0, sizeof(*out_mesh));
+        parse_array_object_begin(components)
         for(u32 i = 0; i < components; ++i){
                 parse_array_object_key
-                parse(':')
                 if(pla_str_is_equal(key, "name")){
-                        p.c = try_parse_string(p, &out_mesh->name);
-                        if(p.c == SIZE_MAX) return SIZE_MAX;
+                        pla_str name = {0};
+                        p.c = try_parse_value(p, &name);
+                        if(has_space) out_mesh->name = name;
+                }else if(pla_str_is_equal(key, "weights")){
+                        p.c = parse_float_pool_array(p, has_space, out_state, has_space ? &out_mesh->weights : PLA_NULL, has_space ? &out_mesh->weight_count : PLA_NULL);
                 }else if(pla_str_is_equal(key, "primitives")){
+                        p.c = check_next_symbol_is(p, colon);
                         u32 primitive_count = 0; 
-                        if(try_count_items_in_array_or_object(p, &primitive_count) == SIZE_MAX) return SIZE_MAX;
-                        if(has_space) out_mesh->primitives = out_state->arena->mesh_primitives+out_state->sizes.mesh_primitives;
+                        if(try_count_items_in_array_or_object(p, &primitive_count) == SIZE_MAX) return pla_fail_in_member(p, key);
+                        pla_mesh_primitive * primitives = has_space ? out_state->arena->mesh_primitives + out_state->sizes.mesh_primitives : PLA_NULL;
+                        if(has_space){
+                                out_mesh->primitives = primitives;
+                                out_mesh->primitive_count = primitive_count;
+                        }
                         out_state->sizes.mesh_primitives += primitive_count;
-                        if(out_state->sizes.mesh_primitives > out_state->in_sizes->mesh_primitives) return SIZE_MAX;
-                }
+                        if(has_space && out_state->sizes.mesh_primitives > out_state->in_sizes->mesh_primitives){ pla_fail(p, pla_parse_error_memory_mismatch, p.c); return pla_fail_in_member(p, key); }
+                        p.c = check_next_symbol_is(p, open_square);
+                        if(primitive_count == 0) p.c = check_next_symbol_is(p, close_square);
+                        if(p.c == SIZE_MAX) return pla_fail_in_member(p, key);
+                        for(u32 prim = 0; prim < primitive_count; ++prim){
+                                p.c = parse_mesh_primitive(p, has_space, out_state, has_space ? &primitives[prim] : PLA_NULL);
+                                if(p.c == SIZE_MAX){ pla_fail_in_item(p, prim); return pla_fail_in_member(p, key); }
+                                p.c = check_next_symbol_is(p, comma | close_square);
+                                if(p.c == SIZE_MAX) return pla_fail_in_member(p, key);
+                        }
+                }else p.c = try_skip_value(p);
+                parse_end_of_member
         }
         return p.c;
 }
 
-static inline size_t parse_nodes(parse_state p, bool has_space, GLTF_state * out_state, pla_node * out_nodes){
-        u32 components = 0;
-        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX;
-        parse('{');
+static inline size_t parse_skins(parse_state p, bool has_space, GLTF_state * out_state, pla_skin * out_skin){
+        if(has_space){
+                memset(out_skin, 0, sizeof(*out_skin));
+                out_skin->inverse_bind_matrices = PLA_INDEX_NONE;
+                out_skin->skeleton = PLA_INDEX_NONE;
+        }
+        parse_array_object_begin(components)
         for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(pla_str_is_equal(key, "name")){
+                        pla_str name = {0};
+                        p.c = try_parse_value(p, &name);
+                        if(has_space) out_skin->name = name;
+                }
+                else if(pla_str_is_equal(key, "inverseBindMatrices") && has_space) p.c = parse_u32(p, has_space, &out_skin->inverse_bind_matrices);
+                else if(pla_str_is_equal(key, "skeleton") && has_space) p.c = parse_u32(p, has_space, &out_skin->skeleton);
+                else if(pla_str_is_equal(key, "joints")) p.c = parse_index_array(p, has_space, out_state, has_space ? &out_skin->joints : PLA_NULL, has_space ? &out_skin->joint_count : PLA_NULL);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
 
+static inline size_t parse_animation_path(parse_state p, bool has_space, pla_animation_path * path){
+        parse_value
+        for(usize i = 0; i < pla_animation_path_MAX_ENUM; ++i){
+                if(pla_str_is_equal(value, pla_animation_path_strings[i])){
+                        if(has_space) *path = (pla_animation_path)i;
+                        return p.c;
+                }
         }
+        //paths from extensions like KHR_animation_pointer are kept as an untargeted channel.
+        if(has_space) *path = pla_animation_path_MAX_ENUM;
         return p.c;
 }
 
-static inline size_t parse_scenes(parse_state p, bool has_space, GLTF_state * out_state, pla_scene * out_scenes){
-        u32 components = 0;
-        if(try_count_items_in_array_or_object(p, &components) == SIZE_MAX) return SIZE_MAX;
-        parse('{');
+static inline size_t parse_animation_interpolation(parse_state p, bool has_space, pla_animation_interpolation * interpolation){
+        parse_value
+        for(usize i = 0; i < pla_animation_interpolation_MAX_ENUM; ++i){
+                if(pla_str_is_equal(value, pla_animation_interpolation_strings[i])){
+                        if(has_space) *interpolation = (pla_animation_interpolation)i;
+                        return p.c;
+                }
+        }
+        return pla_fail(p, pla_parse_error_unknown_value, value.data - p.data);
+}
+
+static inline size_t parse_animation_channel_target(parse_state p, bool has_space, pla_animation_channel * out_channel){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
         for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("node", out_channel->target_node, parse_u32)
+                parse_object_value("path", out_channel->target_path, parse_animation_path)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
 
+static inline size_t parse_animation_channel(parse_state p, bool has_space, GLTF_state * out_state, pla_animation_channel * out_channel){
+        if(has_space){
+                out_channel->sampler = PLA_INDEX_NONE;
+                out_channel->target_node = PLA_INDEX_NONE;
+                out_channel->target_path = pla_animation_path_MAX_ENUM;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("sampler", out_channel->sampler, parse_u32)
+                else if(pla_str_is_equal(key, "target")) p.c = parse_animation_channel_target(p, has_space, out_channel);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
         }
         return p.c;
 }
 
-static inline size_t parse_root(parse_state p, GLTF_state * out) NOEXCEPT{
-        u32 root_comp_count = 0;
-        if(try_count_items_in_array_or_object(p, &root_comp_count) == SIZE_MAX) return SIZE_MAX;
+static inline size_t parse_animation_sampler(parse_state p, bool has_space, GLTF_state * out_state, pla_animation_sampler * out_sampler){
+        if(has_space){
+                out_sampler->input = PLA_INDEX_NONE;
+                out_sampler->output = PLA_INDEX_NONE;
+                out_sampler->interpolation = pla_animation_interpolation_linear;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("input", out_sampler->input, parse_u32)
+                parse_object_value("output", out_sampler->output, parse_u32)
+                parse_object_value("interpolation", out_sampler->interpolation, parse_animation_interpolation)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
 
-        p.c = check_next_symbol_is(p, open_squirle);
-        if(p.c == SIZE_MAX) return SIZE_MAX;
+static inline size_t parse_animations(parse_state p, bool has_space, GLTF_state * out_state, pla_animation * out_animation){
+        if(has_space) memset(out_animation, 0, sizeof(*out_animation));
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(pla_str_is_equal(key, "name")){
+                        pla_str name = {0};
+                        p.c = try_parse_value(p, &name);
+                        if(has_space) out_animation->name = name;
+                }else if(pla_str_is_equal(key, "channels")) parse_pool_array(pla_animation_channel, animation_channels, parse_animation_channel, out_animation->channels, out_animation->channel_count)
+                else if(pla_str_is_equal(key, "samplers")) parse_pool_array(pla_animation_sampler, animation_samplers, parse_animation_sampler, out_animation->samplers, out_animation->sampler_count)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
 
-        for(u32 root_object_index = 0; root_object_index < root_comp_count; ++root_object_index){
-                pla_str key = {};
-                p.c = try_parse_string(p, &key);
+//reads an array of up to count floats after the key, extra items are an error.
+static inline size_t parse_f32_array(parse_state p, bool has_space, f32 * out_values, u32 count){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        u32 item_count = 0;
+        if(try_count_items_in_array_or_object(p, &item_count) == SIZE_MAX) return SIZE_MAX;
+        if(item_count > count) return pla_fail(p, pla_parse_error_too_many_items, p.c);
+        parse('[');
+        if(item_count == 0) p.c = check_next_symbol_is(p, close_square);
+        for(u32 i = 0; i < item_count; ++i){
+                pla_str value = {0};
+                p.c = try_parse_array_item(p, &value);
+                if(p.c == SIZE_MAX) return pla_fail_in_item(p, i);
+                if(has_space) out_values[i] = pla_str_to_f32(value);
+                p.c = check_next_symbol_is(p, comma | close_square);
                 if(p.c == SIZE_MAX) return SIZE_MAX;
-                if(pla_str_is_equal(key, "asset")){
-                        parse(':');
-                        u32 asset_items = 0;
-                        if(try_count_items_in_array_or_object(p, &asset_items) == SIZE_MAX) return false;
-                        for(u32 i = 0; i < asset_items; ++i){
-                                pla_str key = {0};
-                                p.c = try_parse_string(p, &key);
-                                if(p.c == SIZE_MAX) return false;
-                                if(pla_str_is_equal(key, "generator")){
-                                        parse_value
-                                        if(out->out_gltf) out->out_gltf->asset.generator = value;
-                                }else if(pla_str_is_equal(key, "version")){
-                                        parse_value
-                                        if(out->out_gltf) out->out_gltf->asset.version = value;
-                                }
-                                p.c = parse_til_next_symbol(p);
-                                if(p.data[p.c] != ',' && p.data[p.c] != '}') return false;
-                        }
-                }else if(pla_str_is_equal(key, "scene")){
-                        pla_str key = {};
-                        p.c = try_parse_string(p, &key);
-                        if(p.c == SIZE_MAX) return SIZE_MAX;
-                        parse(':');
-                        if(pla_str_is_equal(key, "scene") && out->out_gltf){
-                                p.c = parse_u32(p, true, &out->out_gltf->scene);
-                        }
-                        if(p.c == SIZE_MAX) return SIZE_MAX;
-                        p.c = check_next_symbol_is(p, comma | close_squirle);
-                        if(p.c == SIZE_MAX) return SIZE_MAX;
+        }
+        return p.c;
+}
 
+static inline size_t parse_alpha_mode(parse_state p, bool has_space, pla_alpha_mode * alpha_mode){
+        parse_value
+        for(usize i = 0; i < pla_alpha_mode_MAX_ENUM; ++i){
+                if(pla_str_is_equal(value, pla_alpha_mode_strings[i])){
+                        if(has_space) *alpha_mode = (pla_alpha_mode)i;
+                        return p.c;
                 }
-                #define X(_, name, prop_name) \
-                else if(pla_str_is_equal(key, name)){ \
-                        bool has_space = out->arena && out->arena->prop_name && out->out_gltf; \
-                        if(has_space) out->out_gltf->prop_name = out->arena->prop_name; \
-                        p.c = check_next_symbol_is(p, colon);\
-                        if(p.c == SIZE_MAX) return SIZE_MAX;\
-                        u32 count = 0; \
-                        if(try_count_items_in_array_or_object(p, &count) == SIZE_MAX) return SIZE_MAX; \
-                        out->sizes.prop_name += count; \
-                        if(has_space && out->sizes.prop_name > out->in_sizes->prop_name) return SIZE_MAX; \
-                        p.c = check_next_symbol_is(p, open_square); \
-                        if(p.c == SIZE_MAX) return SIZE_MAX; \
-                        for(usize i = 0; i < count; ++i){ \
-                                p.c = parse_##prop_name(p, has_space, out, &out->out_gltf->prop_name[i]); \
-                                p.c = check_next_symbol_is(p, comma & close_square); \
-                                if(p.c == SIZE_MAX) return p.c; \
-                        } \
-                        if(p.c == SIZE_MAX) return SIZE_MAX; \
+        }
+        return pla_fail(p, pla_parse_error_unknown_value, value.data - p.data);
+}
+
+static inline size_t parse_texture_info(parse_state p, bool has_space, pla_texture_info * out_info){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("index", out_info->index, parse_u32)
+                parse_object_value("texCoord", out_info->tex_coord, parse_u32)
+                parse_object_value("scale", out_info->scale, parse_f32)
+                parse_object_value("strength", out_info->scale, parse_f32)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_material_pbr(parse_state p, bool has_space, pla_material * out_material){
+        p.c = check_next_symbol_is(p, colon);
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(pla_str_is_equal(key, "baseColorFactor")) p.c = parse_f32_array(p, has_space, has_space ? out_material->base_color_factor : PLA_NULL, 4);
+                else if(pla_str_is_equal(key, "baseColorTexture")) p.c = parse_texture_info(p, has_space, has_space ? &out_material->base_color_texture : PLA_NULL);
+                parse_object_value("metallicFactor", out_material->metallic_factor, parse_f32)
+                parse_object_value("roughnessFactor", out_material->roughness_factor, parse_f32)
+                else if(pla_str_is_equal(key, "metallicRoughnessTexture")) p.c = parse_texture_info(p, has_space, has_space ? &out_material->metallic_roughness_texture : PLA_NULL);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_materials(parse_state p, bool has_space, GLTF_state * out_state, pla_material * out_material){
+        if(has_space){
+                pla_texture_info no_texture = {.index = PLA_INDEX_NONE, .tex_coord = 0, .scale = 1.0f};
+                memset(out_material, 0, sizeof(*out_material));
+                for(u32 c = 0; c < 4; ++c) out_material->base_color_factor[c] = 1.0f;
+                out_material->base_color_texture = no_texture;
+                out_material->metallic_factor = 1.0f;
+                out_material->roughness_factor = 1.0f;
+                out_material->metallic_roughness_texture = no_texture;
+                out_material->normal_texture = no_texture;
+                out_material->occlusion_texture = no_texture;
+                out_material->emissive_texture = no_texture;
+                out_material->alpha_mode = pla_alpha_mode_opaque;
+                out_material->alpha_cutoff = 0.5f;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("name", out_material->name, parse_str)
+                else if(pla_str_is_equal(key, "pbrMetallicRoughness")) p.c = parse_material_pbr(p, has_space, out_material);
+                else if(pla_str_is_equal(key, "normalTexture")) p.c = parse_texture_info(p, has_space, has_space ? &out_material->normal_texture : PLA_NULL);
+                else if(pla_str_is_equal(key, "occlusionTexture")) p.c = parse_texture_info(p, has_space, has_space ? &out_material->occlusion_texture : PLA_NULL);
+                else if(pla_str_is_equal(key, "emissiveTexture")) p.c = parse_texture_info(p, has_space, has_space ? &out_material->emissive_texture : PLA_NULL);
+                else if(pla_str_is_equal(key, "emissiveFactor")) p.c = parse_f32_array(p, has_space, has_space ? out_material->emissive_factor : PLA_NULL, 3);
+                parse_object_value("alphaMode", out_material->alpha_mode, parse_alpha_mode)
+                parse_object_value("alphaCutoff", out_material->alpha_cutoff, parse_f32)
+                parse_object_value("doubleSided", out_material->double_sided, parse_bool)
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_textures(parse_state p, bool has_space, GLTF_state * out_state, pla_texture * out_texture){
+        if(has_space){
+                memset(out_texture, 0, sizeof(*out_texture));
+                out_texture->sampler = PLA_INDEX_NONE;
+                out_texture->source = PLA_INDEX_NONE;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                #define X(type, name, prop, parser) parse_object_value(name, out_texture->prop, parser)
+                TEXTURE_COMPONENTS
+                #undef X
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_samplers(parse_state p, bool has_space, GLTF_state * out_state, pla_sampler * out_sampler){
+        if(has_space){
+                memset(out_sampler, 0, sizeof(*out_sampler));
+                out_sampler->wrap_s = 10497;
+                out_sampler->wrap_t = 10497;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                #define X(type, name, prop, parser) parse_object_value(name, out_sampler->prop, parser)
+                SAMPLER_COMPONENTS
+                #undef X
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_images(parse_state p, bool has_space, GLTF_state * out_state, pla_image * out_image){
+        if(has_space){
+                memset(out_image, 0, sizeof(*out_image));
+                out_image->buffer_view = PLA_INDEX_NONE;
+        }
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                #define X(type, name, prop, parser) parse_object_value(name, out_image->prop, parser)
+                IMAGE_COMPONENTS
+                #undef X
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+//Column major translation * rotation * scale, rotation is a unit quaternion x, y, z, w.
+inline void pla_compose_trs(f32 const * translation, f32 const * rotation, f32 const * scale, f32 * out_matrix) NOEXCEPT{
+        f32 x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+        f32 r[9] = {
+                1 - 2 * (y * y + z * z), 2 * (x * y + z * w), 2 * (x * z - y * w),
+                2 * (x * y - z * w), 1 - 2 * (x * x + z * z), 2 * (y * z + x * w),
+                2 * (x * z + y * w), 2 * (y * z - x * w), 1 - 2 * (x * x + y * y),
+        };
+        for(u32 column = 0; column < 3; ++column){
+                for(u32 row = 0; row < 3; ++row) out_matrix[column * 4 + row] = r[column * 3 + row] * scale[column];
+                out_matrix[column * 4 + 3] = 0;
+        }
+        out_matrix[12] = translation[0];
+        out_matrix[13] = translation[1];
+        out_matrix[14] = translation[2];
+        out_matrix[15] = 1;
+}
+
+static inline size_t parse_nodes(parse_state p, bool has_space, GLTF_state * out_state, pla_node * out_node){
+        if(has_space){
+                memset(out_node, 0, sizeof(*out_node));
+                out_node->mesh = PLA_INDEX_NONE;
+                out_node->skin = PLA_INDEX_NONE;
+                out_node->rotation[3] = 1.0f;
+                for(u32 c = 0; c < 3; ++c) out_node->scale[c] = 1.0f;
+                for(u32 c = 0; c < 4; ++c) out_node->matrix[c * 5] = 1.0f;
+        }
+        bool has_matrix = false;
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("name", out_node->name, parse_str)
+                parse_object_value("mesh", out_node->mesh, parse_u32)
+                parse_object_value("skin", out_node->skin, parse_u32)
+                else if(pla_str_is_equal(key, "children")) p.c = parse_index_array(p, has_space, out_state, has_space ? &out_node->children : PLA_NULL, has_space ? &out_node->child_count : PLA_NULL);
+                else if(pla_str_is_equal(key, "translation")) p.c = parse_f32_array(p, has_space, has_space ? out_node->translation : PLA_NULL, 3);
+                else if(pla_str_is_equal(key, "rotation")) p.c = parse_f32_array(p, has_space, has_space ? out_node->rotation : PLA_NULL, 4);
+                else if(pla_str_is_equal(key, "scale")) p.c = parse_f32_array(p, has_space, has_space ? out_node->scale : PLA_NULL, 3);
+                else if(pla_str_is_equal(key, "matrix")){
+                        p.c = parse_f32_array(p, has_space, has_space ? out_node->matrix : PLA_NULL, 16);
+                        has_matrix = true;
+                }
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        if(has_space && !has_matrix) pla_compose_trs(out_node->translation, out_node->rotation, out_node->scale, out_node->matrix);
+        return p.c;
+}
+
+static inline size_t parse_scenes(parse_state p, bool has_space, GLTF_state * out_state, pla_scene * out_scene){
+        if(has_space) memset(out_scene, 0, sizeof(*out_scene));
+        parse_array_object_begin(components)
+        for(u32 i = 0; i < components; ++i){
+                parse_array_object_key
+                if(0);
+                parse_object_value("name", out_scene->name, parse_str)
+                else if(pla_str_is_equal(key, "nodes")) p.c = parse_index_array(p, has_space, out_state, has_space ? &out_scene->nodes : PLA_NULL, has_space ? &out_scene->node_count : PLA_NULL);
+                else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        return p.c;
+}
+
+static inline size_t parse_asset(parse_state p, GLTF_state * out){
+        parse(':');
+        u32 asset_items = 0;
+        if(try_count_items_in_array_or_object(p, &asset_items) == SIZE_MAX) return SIZE_MAX;
+        parse('{');
+        for(u32 i = 0; i < asset_items; ++i){
+                pla_str key = {0};
+                p.c = try_parse_string(p, &key);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+                pla_str value = {0};
+                if(pla_str_is_equal(key, "generator")){
+                        p.c = try_parse_value(p, &value);
+                        if(out->out_gltf) out->out_gltf->asset.generator = value;
+                }else if(pla_str_is_equal(key, "version")){
+                        p.c = try_parse_value(p, &value);
+                        if(out->out_gltf) out->out_gltf->asset.version = value;
+                }else p.c = try_skip_value(p);
+                parse_end_of_member
+        }
+        if(asset_items == 0) p.c = check_next_symbol_is(p, close_squirle);
+        return p.c;
+}
+
+static inline size_t parse_root(parse_state p, GLTF_state * out) NOEXCEPT{
+        //the root object opens at the first byte of the chunk.
+        if(p.size == 0 || c_byte(p) != '{') return pla_fail(p, pla_parse_error_unexpected_symbol, 0);
+        u32 root_comp_count = 0;
+        if(count_items_in_array_or_object_at(p, &root_comp_count) == SIZE_MAX) return SIZE_MAX;
+
+        for(u32 root_object_index = 0; root_object_index < root_comp_count; ++root_object_index){
+                pla_str key = {};
+                p.c = try_parse_string(p, &key);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+                if(pla_str_is_equal(key, "asset")) p.c = parse_asset(p, out);
+                else if(pla_str_is_equal(key, "scene")){
+                        u32 scene = 0;
+                        p.c = parse_u32(p, true, &scene);
+                        if(out->out_gltf) out->out_gltf->scene = scene;
+                }
+                #define X(_, name, prop_name) \
+                else if(pla_str_is_equal(key, name)){ \
+                        bool has_space = out->arena && out->arena->prop_name && out->out_gltf; \
+                        if(has_space) out->out_gltf->prop_name = out->arena->prop_name; \
+                        p.c = check_next_symbol_is(p, colon);\
+                        u32 count = 0; \
+                        if(try_count_items_in_array_or_object(p, &count) == SIZE_MAX) return pla_fail_in_root_member(p, key); \
+                        out->sizes.prop_name += count; \
+                        if(has_space && out->sizes.prop_name > out->in_sizes->prop_name){ pla_fail(p, pla_parse_error_memory_mismatch, p.c); return pla_fail_in_root_member(p, key); } \
+                        if(has_space) out->out_gltf->prop_name##_size = count; \
+                        p.c = check_next_symbol_is(p, open_square); \
+                        if(count == 0) p.c = check_next_symbol_is(p, close_square); \
+                        if(p.c == SIZE_MAX) return pla_fail_in_root_member(p, key); \
+                        for(usize i = 0; i < count; ++i){ \
+                                p.c = parse_##prop_name(p, has_space, out, has_space ? &out->out_gltf->prop_name[i] : PLA_NULL); \
+                                if(p.c == SIZE_MAX){ pla_fail_in_item(p, i); return pla_fail_in_root_member(p, key); } \
+                                p.c = check_next_symbol_is(p, comma | close_square); \
+                                if(p.c == SIZE_MAX) return pla_fail_in_root_member(p, key); \
+                        } \
                 }
                 ROOT_ARRAYS
                 #undef X
+                else p.c = try_skip_value(p);
+                if(p.c == SIZE_MAX) return pla_fail_in_root_member(p, key);
+                p.c = check_next_symbol_is(p, comma | close_squirle);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
 
                 // else if(pla_str_is_equal(key, "bufferViews")){
                 //         parse_begining_of_root_array(buffer_views, buffer_view_count);
@@ -1083,39 +2662,313 @@ static inline size_t parse_root(parse_state p, GLTF_state * out) NOEXCEPT{
         return p.c;
 }
 
-//If buffer is null it just counts the size needed for a buffer to put the object in.
-bool pla_parse_gltf_arena_style(u32 data_size, u8 const * data, pla_GLTF_sizes * in_sizes, pla_GLTF_arena * arena, pla_GLTF * out_gltf) NOEXCEPT{
-        //Must have at least this
-        if(!in_sizes) return false;
-        pla_header header;
-        pla_chunk json_chunk;
-        pla_chunk binary_chunk;
+//Validation.
+//Checks every index from one root array item to another and every byte range against the buffer it's in, so a file from someone else can't send the functions after parsing out of bounds.
+//The loops or together the result of every check instead of stopping at the first so they stay straight lines the compiler can vectorize.
+
+static inline bool pla_uri_is_data(pla_str uri){
+        return uri.length >= 5 && memcmp(uri.data, "data:", 5) == 0;
+}
+
+//returns the base64 payload of a data uri, or an empty string if its not base64.
+static inline pla_str pla_data_uri_payload(pla_str uri){
+        pla_str payload = {0};
+        for(usize i = 5; i < uri.length; ++i){
+                if(uri.data[i] != ',') continue;
+                if(i < 12 || memcmp(uri.data + i - 7, ";base64", 7) != 0) return payload;
+                payload.data = uri.data + i + 1;
+                payload.length = uri.length - (i + 1);
+                return payload;
+        }
+        return payload;
+}
+
+//PLA_INDEX_NONE or in range.
+INTERNAL bool pla_optional_index_is_valid(u32 index, u32 count) NOEXCEPT{
+        return index == PLA_INDEX_NONE || index < count;
+}
+
+INTERNAL bool pla_indices_are_below(u32 const * indices, u32 count, u32 limit) NOEXCEPT{
+        u32 bad = 0;
+        for(u32 i = 0; i < count; ++i) bad |= indices[i] >= limit;
+        return !bad;
+}
+
+//elements of element_size bytes, stride apart, starting byte_offset into a view of view_length bytes.
+INTERNAL bool pla_elements_fit(u32 byte_offset, u32 stride, u32 element_size, u32 count, u32 view_length) NOEXCEPT{
+        u64 end = count ? byte_offset + (u64)stride * (count - 1) + element_size : byte_offset;
+        return end <= view_length;
+}
+
+static inline bool pla_buffer_is_valid(pla_GLTF const * gltf, pla_buffer const * buffer){
+        u32 bad = 0;
+        bad |= buffer->data == gltf->bin && buffer->data && buffer->byte_length > gltf->bin_size;
+        //base64 is 4 characters for every 3 bytes.
+        if(pla_uri_is_data(buffer->uri)) bad |= buffer->byte_length > pla_data_uri_payload(buffer->uri).length / 4 * 3 + 2;
+        return !bad;
+}
+
+static inline bool pla_buffer_view_is_valid(pla_GLTF const * gltf, pla_buffer_view const * view){
+        u32 bad = 0;
+        bad |= view->buffer >= gltf->buffers_size;
+        if(!bad) bad |= (u64)view->byte_offset + view->byte_length > gltf->buffers[view->buffer].byte_length;
+        pla_meshopt_compression const * meshopt = &view->meshopt;
+        if(meshopt->mode != pla_meshopt_mode_none){
+                bad |= (u32)meshopt->mode >= pla_meshopt_mode_MAX_ENUM || (u32)meshopt->filter >= pla_meshopt_filter_MAX_ENUM;
+                bad |= meshopt->byte_stride == 0 || (u64)meshopt->count * meshopt->byte_stride > view->byte_length;
+                bad |= meshopt->buffer >= gltf->buffers_size;
+                if(!bad) bad |= (u64)meshopt->byte_offset + meshopt->byte_length > gltf->buffers[meshopt->buffer].byte_length;
+        }
+        return !bad;
+}
+
+static inline bool pla_accessor_is_valid(pla_GLTF const * gltf, pla_accessor const * accessor){
+        u32 bad = 0;
+        bad |= (u32)accessor->component_type >= pla_GLTF_component_type_MAX_ENUM || (u32)accessor->type >= pla_GLTF_type_MAX_ENUM;
+        if(bad) return false;
+        u32 element_size = pla_GLTF_component_type_byte_count[accessor->component_type] * pla_GLTF_type_component_count[accessor->type];
+        if(accessor->buffer_view != PLA_INDEX_NONE){
+                if(accessor->buffer_view >= gltf->buffer_views_size) return false;
+                pla_buffer_view const * view = &gltf->buffer_views[accessor->buffer_view];
+                u32 stride = view->byte_stride ? view->byte_stride : element_size;
+                bad |= !pla_elements_fit(accessor->byte_offset, stride, element_size, accessor->count, view->byte_length);
+        }
+        pla_accessor_sparse const * sparse = &accessor->sparse;
+        if(sparse->count){
+                pla_GLTF_component_type index_type = sparse->indices_component_type;
+                bad |= sparse->count > accessor->count;
+                bad |= index_type != pla_GLTF_component_type_u8 && index_type != pla_GLTF_component_type_u16 && index_type != pla_GLTF_component_type_u32;
+                bad |= sparse->indices_buffer_view >= gltf->buffer_views_size || sparse->values_buffer_view >= gltf->buffer_views_size;
+                if(bad) return false;
+                u32 index_size = pla_GLTF_component_type_byte_count[index_type];
+                bad |= !pla_elements_fit(sparse->indices_byte_offset, index_size, index_size, sparse->count, gltf->buffer_views[sparse->indices_buffer_view].byte_length);
+                bad |= !pla_elements_fit(sparse->values_byte_offset, element_size, element_size, sparse->count, gltf->buffer_views[sparse->values_buffer_view].byte_length);
+        }
+        return !bad;
+}
+
+static inline bool pla_attributes_are_valid(pla_GLTF const * gltf, pla_mesh_primitive_attribute const * attributes, u32 attribute_count){
+        u32 bad = 0;
+        for(u32 i = 0; i < attribute_count; ++i){
+                bad |= attributes[i].accessor >= gltf->accessors_size;
+                bad |= (u32)attributes[i].name >= pla_mesh_primitive_attribute_name_MAX_ENUM;
+        }
+        return !bad;
+}
+
+INTERNAL bool pla_is_joint_component_type(pla_GLTF_component_type component_type) NOEXCEPT{
+        return component_type == pla_GLTF_component_type_u8 || component_type == pla_GLTF_component_type_u16;
+}
+
+static inline bool pla_primitive_is_valid(pla_GLTF const * gltf, pla_mesh_primitive const * primitive){
+        u32 bad = 0;
+        bad |= primitive->mode > 6;
+        bad |= !pla_optional_index_is_valid(primitive->material, gltf->materials_size);
+        bad |= !pla_attributes_are_valid(gltf, primitive->attributes, primitive->attribute_count);
+        for(u32 t = 0; t < primitive->target_count; ++t) bad |= !pla_attributes_are_valid(gltf, primitive->targets[t].attributes, primitive->targets[t].attribute_count);
+        if(bad) return false;
+        //every attribute and target has one element per vertex.
+        u32 vertex_count = primitive->attribute_count ? gltf->accessors[primitive->attributes[0].accessor].count : 0;
+        for(u32 i = 0; i < primitive->attribute_count; ++i){
+                pla_accessor const * accessor = &gltf->accessors[primitive->attributes[i].accessor];
+                bad |= accessor->count != vertex_count;
+                bad |= primitive->attributes[i].name == pla_JOINTS && !pla_is_joint_component_type(accessor->component_type);
+        }
+        for(u32 t = 0; t < primitive->target_count; ++t){
+                pla_morph_target const * target = &primitive->targets[t];
+                for(u32 i = 0; i < target->attribute_count; ++i) bad |= gltf->accessors[target->attributes[i].accessor].count != vertex_count;
+        }
+        if(primitive->indices != PLA_INDEX_NONE){
+                if(primitive->indices >= gltf->accessors_size) return false;
+                pla_accessor const * indices = &gltf->accessors[primitive->indices];
+                bad |= indices->type != pla_GLTF_SCALAR;
+                bad |= indices->component_type != pla_GLTF_component_type_u8 && indices->component_type != pla_GLTF_component_type_u16 && indices->component_type != pla_GLTF_component_type_u32;
+        }
+        return !bad;
+}
+
+static inline bool pla_mesh_is_valid(pla_GLTF const * gltf, pla_mesh const * mesh){
+        u32 bad = 0;
+        for(u32 i = 0; i < mesh->primitive_count; ++i) bad |= !pla_primitive_is_valid(gltf, &mesh->primitives[i]);
+        return !bad;
+}
+
+static inline bool pla_scene_is_valid(pla_GLTF const * gltf, pla_scene const * scene){
+        return pla_indices_are_below(scene->nodes, scene->node_count, gltf->nodes_size);
+}
+
+//cycles in the hierarchy aren't looked for here, pla_flatten_scene fails on them.
+static inline bool pla_node_is_valid(pla_GLTF const * gltf, pla_node const * node){
+        u32 bad = 0;
+        bad |= !pla_optional_index_is_valid(node->mesh, gltf->meshes_size);
+        bad |= !pla_optional_index_is_valid(node->skin, gltf->skins_size);
+        bad |= !pla_indices_are_below(node->children, node->child_count, gltf->nodes_size);
+        return !bad;
+}
+
+static inline bool pla_skin_is_valid(pla_GLTF const * gltf, pla_skin const * skin){
+        u32 bad = 0;
+        bad |= !pla_indices_are_below(skin->joints, skin->joint_count, gltf->nodes_size);
+        bad |= !pla_optional_index_is_valid(skin->skeleton, gltf->nodes_size);
+        bad |= !pla_optional_index_is_valid(skin->inverse_bind_matrices, gltf->accessors_size);
+        return !bad;
+}
+
+static inline bool pla_material_is_valid(pla_GLTF const * gltf, pla_material const * material){
+        u32 bad = 0;
+        bad |= (u32)material->alpha_mode >= pla_alpha_mode_MAX_ENUM;
+        bad |= !pla_optional_index_is_valid(material->base_color_texture.index, gltf->textures_size);
+        bad |= !pla_optional_index_is_valid(material->metallic_roughness_texture.index, gltf->textures_size);
+        bad |= !pla_optional_index_is_valid(material->normal_texture.index, gltf->textures_size);
+        bad |= !pla_optional_index_is_valid(material->occlusion_texture.index, gltf->textures_size);
+        bad |= !pla_optional_index_is_valid(material->emissive_texture.index, gltf->textures_size);
+        return !bad;
+}
+
+static inline bool pla_animation_is_valid(pla_GLTF const * gltf, pla_animation const * animation){
+        u32 bad = 0;
+        for(u32 i = 0; i < animation->channel_count; ++i){
+                pla_animation_channel const * channel = &animation->channels[i];
+                bad |= channel->sampler >= animation->sampler_count;
+                bad |= !pla_optional_index_is_valid(channel->target_node, gltf->nodes_size);
+                //paths from extensions are left as pla_animation_path_MAX_ENUM.
+                bad |= (u32)channel->target_path > pla_animation_path_MAX_ENUM;
+        }
+        for(u32 i = 0; i < animation->sampler_count; ++i){
+                pla_animation_sampler const * sampler = &animation->samplers[i];
+                bad |= sampler->input >= gltf->accessors_size || sampler->output >= gltf->accessors_size;
+                bad |= (u32)sampler->interpolation >= pla_animation_interpolation_MAX_ENUM;
+        }
+        return !bad;
+}
+
+static inline bool pla_texture_is_valid(pla_GLTF const * gltf, pla_texture const * texture){
+        return pla_optional_index_is_valid(texture->sampler, gltf->samplers_size) && pla_optional_index_is_valid(texture->source, gltf->images_size);
+}
+
+static inline bool pla_image_is_valid(pla_GLTF const * gltf, pla_image const * image){
+        return pla_optional_index_is_valid(image->buffer_view, gltf->buffer_views_size);
+}
+
+//The root arrays that are checked and the check for one of their items.
+#define VALIDATED_ROOT_ARRAYS \
+        X(scenes, pla_scene_is_valid)\
+        X(nodes, pla_node_is_valid)\
+        X(buffers, pla_buffer_is_valid)\
+        X(buffer_views, pla_buffer_view_is_valid)\
+        X(accessors, pla_accessor_is_valid)\
+        X(meshes, pla_mesh_is_valid)\
+        X(skins, pla_skin_is_valid)\
+        X(animations, pla_animation_is_valid)\
+        X(materials, pla_material_is_valid)\
+        X(textures, pla_texture_is_valid)\
+        X(images, pla_image_is_valid)
+
+//Checks a parsed gltf before anything reads through it, false if an index is out of range, a byte range doesn't fit in what it points at or an enum isn't one.
+//buffers are checked against the bin chunk and their data uris, files are checked when pla_resolve_buffers maps them.
+inline bool pla_validate_gltf(pla_GLTF const * gltf) NOEXCEPT{
+        if(!gltf) return false;
+        u32 bad = 0;
+        bad |= !pla_optional_index_is_valid(gltf->scene, gltf->scenes_size);
+        #define X(prop, is_valid) for(u32 i = 0; i < gltf->prop##_size; ++i) bad |= !is_valid(gltf, &gltf->prop[i]);
+        VALIDATED_ROOT_ARRAYS
+        #undef X
+        return !bad;
+}
+
+//Reports the first item pla_validate_gltf fails on, only called once it has.
+static inline bool pla_report_invalid_item(pla_GLTF const * gltf, pla_parse_error * error){
+        if(!error) return false;
+        pla_root_object section = pla_root_scene;
+        u32 index = PLA_INDEX_NONE;
+        if(pla_optional_index_is_valid(gltf->scene, gltf->scenes_size)){
+                #define X(prop, is_valid) \
+                if(index == PLA_INDEX_NONE){ \
+                        section = pla_root_##prop; \
+                        for(u32 i = 0; i < gltf->prop##_size && index == PLA_INDEX_NONE; ++i) if(!is_valid(gltf, &gltf->prop[i])) index = i; \
+                }
+                VALIDATED_ROOT_ARRAYS
+                #undef X
+        }
+        //the offset of the item comes from the tape when there is one.
+        usize offset = 0;
+        pla_json_tape const * tape = &gltf->tape;
+        u32 member = tape->entry_count ? pla_tape_find_member(tape, 0, pla_root_object_names[section]) : PLA_INDEX_NONE;
+        if(member != PLA_INDEX_NONE){
+                u32 entry = member;
+                if(index != PLA_INDEX_NONE && tape->entries[member].token == pla_token_begin_array && index < tape->entries[member].count){
+                        entry = member + 1;
+                        for(u32 i = 0; i < index; ++i) entry = pla_tape_next(tape, entry);
+                }
+                offset = tape->entries[entry].offset;
+        }
+        pla_set_parse_error(error, pla_parse_error_invalid_reference, offset);
+        error->section = section;
+        parse_state p = {.c = 0, .size = gltf->json_size, .data = gltf->json, .error = error};
+        if(index != PLA_INDEX_NONE) pla_fail_in_item(p, index);
+        pla_fail_in_member(p, (pla_str){.data = (u8 const *)pla_root_object_names[section], .length = strlen(pla_root_object_names[section])});
+        return false;
+}
 
+static inline bool pla_get_glb_chunks_reporting(u32 data_size, u8 const * data, pla_chunk * json_chunk, pla_chunk * binary_chunk, pla_parse_error * error){
+        pla_header header;
+        *binary_chunk = (pla_chunk){0};
+        if(data_size < 4) return pla_set_parse_error(error, pla_parse_error_not_gltf, 0);
         memcpy(&header.magic, data, 4);
-        if (header.magic != glTF) return false;
+        if (header.magic != glTF){
+                //a .gltf file is just the json, its buffers are all external.
+                if(data[0] != '{') return pla_set_parse_error(error, pla_parse_error_not_gltf, 0);
+                json_chunk->size = data_size;
+                json_chunk->type = JSON;
+                json_chunk->data = data;
+                return true;
+        }
+        if(data_size < 20) return pla_set_parse_error(error, pla_parse_error_glb_length, data_size);
         memcpy(&header.version, data + 4, 4);
         memcpy(&header.length, data + 8, 4);
-        memcpy(&json_chunk.size, data + 12, 4);
-        memcpy(&json_chunk.type, data + 16, 4);
-        if (json_chunk.type != JSON) return false;
-        json_chunk.data = data + 20;
-        u8 const * jdata = json_chunk.data;
-        usize jsize = json_chunk.size;
-        memcpy(&binary_chunk.size, data + 20 + json_chunk.size, 4);
-        memcpy(&binary_chunk.type, data + 20 + json_chunk.size + 4, 4);
-        if (binary_chunk.type != BIN) return false;
-        binary_chunk.data = data + 20 + json_chunk.size + 8;
+        memcpy(&json_chunk->size, data + 12, 4);
+        memcpy(&json_chunk->type, data + 16, 4);
+        if(header.version != 2) return pla_set_parse_error(error, pla_parse_error_glb_version, 4);
+        if(header.length > data_size) return pla_set_parse_error(error, pla_parse_error_glb_length, 8);
+        //the chunks have to fit in the length the header gives, anything after it is ignored.
+        data_size = header.length;
+        if (json_chunk->type != JSON) return pla_set_parse_error(error, pla_parse_error_glb_chunk_type, 16);
+        if((u64)20 + json_chunk->size > data_size) return pla_set_parse_error(error, pla_parse_error_glb_length, 12);
+        json_chunk->data = data + 20;
+        //the bin chunk is optional.
+        if((u64)20 + json_chunk->size + 8 <= data_size){
+                memcpy(&binary_chunk->size, data + 20 + json_chunk->size, 4);
+                memcpy(&binary_chunk->type, data + 20 + json_chunk->size + 4, 4);
+                if (binary_chunk->type != BIN) return pla_set_parse_error(error, pla_parse_error_glb_chunk_type, 20 + json_chunk->size + 4);
+                if((u64)20 + json_chunk->size + 8 + binary_chunk->size > data_size) return pla_set_parse_error(error, pla_parse_error_glb_length, 20 + json_chunk->size);
+                binary_chunk->data = data + 20 + json_chunk->size + 8;
+        }
+        return true;
+}
 
+//Finds the json chunk and the optional bin chunk, a .gltf file is all json.
+inline bool pla_get_glb_chunks(u32 data_size, u8 const * data, pla_chunk * json_chunk, pla_chunk * binary_chunk) NOEXCEPT{
+        return pla_get_glb_chunks_reporting(data_size, data, json_chunk, binary_chunk, PLA_NULL);
+}
 
-        pla_GLTF_sizes sizes;
+static inline bool pla_parse_gltf_reporting(u32 data_size, u8 const * data, pla_json_tape const * in_tape, pla_GLTF_sizes * in_sizes, pla_GLTF_arena * arena, pla_GLTF * out_gltf, pla_parse_error * error){
+        //Must have at least this
+        if(!in_sizes) return false;
+        pla_chunk json_chunk;
+        pla_chunk binary_chunk;
+        if(!pla_get_glb_chunks_reporting(data_size, data, &json_chunk, &binary_chunk, error)) return false;
+        u8 const * jdata = json_chunk.data;
+        usize jsize = json_chunk.size;
+        if(in_tape && (in_tape->json != jdata || in_tape->json_size != jsize)) return pla_set_parse_error(error, pla_parse_error_memory_mismatch, 0);
 
-        usize c = 0;
         if(arena && out_gltf){
                 out_gltf->bin = binary_chunk.data;
                 out_gltf->bin_size = binary_chunk.size;
+                out_gltf->json = json_chunk.data;
+                out_gltf->json_size = json_chunk.size;
+                out_gltf->scene = PLA_INDEX_NONE;
         } 
 
-
         GLTF_state out_state{
                 .sizes = {0},
                 .in_sizes = in_sizes,
@@ -1123,25 +2976,66 @@ bool pla_parse_gltf_arena_style(u32 data_size, u8 const * data, pla_GLTF_sizes *
                 .out_gltf = out_gltf,
         };
 
-        if(parse_root((parse_state){.c = 0, .size = jsize, .data = jdata}, &out_state) == SIZE_MAX) return false;
+        //the tape is built before anything else so the parse below can jump through it.
+        pla_json_tape tape = {0};
+        if(in_tape) tape = *in_tape;
+        else if(arena && out_gltf && arena->tape_entries && in_sizes->tape_entries){
+                u32 entry_count = in_sizes->tape_entries;
+                if(!pla_build_json_tape_reporting(jsize, jdata, &entry_count, arena->tape_entries, error)) return false;
+                tape = (pla_json_tape){.entries = arena->tape_entries, .entry_count = entry_count, .json = jdata, .json_size = jsize};
+        }
+        if(arena && out_gltf) out_gltf->tape = tape;
+
+        u32 tape_cursor = 0;
+        parse_state p = {.c = 0, .size = jsize, .data = jdata, .tape = tape.entries ? &tape : PLA_NULL, .tape_cursor = &tape_cursor, .error = error};
+        if(parse_root(p, &out_state) == SIZE_MAX) return pla_set_parse_error(error, pla_parse_error_unexpected_symbol, 0);
+        //the first pass is where the sizes come from.
+        if(!arena){
+                if(!in_tape && !pla_build_json_tape_reporting(jsize, jdata, &out_state.sizes.tape_entries, PLA_NULL, error)) return false;
+                *in_sizes = out_state.sizes;
+        }
+        else if(out_gltf && out_gltf->buffers_size && !out_gltf->buffers[0].uri.data && binary_chunk.data){
+                out_gltf->buffers[0].data = binary_chunk.data;
+                if(out_gltf->buffers[0].byte_length > binary_chunk.size) return pla_report_invalid_item(out_gltf, error);
+        }
+#ifdef PLA_HARDENED
+        if(arena && out_gltf && !pla_validate_gltf(out_gltf)) return pla_report_invalid_item(out_gltf, error);
+#endif
 
         return true;
 }
 
+//Same as pla_parse_gltf_arena_style but with a tape of the json chunk you built with pla_build_json_tape, or null to build one in the arena.
+//with a tape both passes jump through it, sizes.tape_entries comes out as 0 and out_gltf->tape is your tape.
+bool pla_parse_gltf_with_tape(u32 data_size, u8 const * data, pla_json_tape const * in_tape, pla_GLTF_sizes * in_sizes, pla_GLTF_arena * arena, pla_GLTF * out_gltf) NOEXCEPT{
+        return pla_parse_gltf_reporting(data_size, data, in_tape, in_sizes, arena, out_gltf, PLA_NULL);
+}
+
+//If buffer is null it just counts the size needed for a buffer to put the object in.
+//the json tape is built in to the arena unless sizes.tape_entries is set to 0 before the arena pass.
+bool pla_parse_gltf_arena_style(u32 data_size, u8 const * data, pla_GLTF_sizes * in_sizes, pla_GLTF_arena * arena, pla_GLTF * out_gltf) NOEXCEPT{
+        return pla_parse_gltf_with_tape(data_size, data, PLA_NULL, in_sizes, arena, out_gltf);
+}
+
 static size_t get_aligned_size(size_t size){
         size_t alignment = sizeof(void *);
-        return size + (alignment - (size % alignment));
+        return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static inline size_t get_aligned_size_to(size_t size, size_t alignment){
+        return (size + alignment - 1) & ~(alignment - 1);
 }
 
 inline size_t pla_get_buffer_size_from_sizes(pla_GLTF_sizes sizes){
         size_t buffer_size = 0;
 
         //Keep in sync with arena struct.
-        #define X(_, __, prop) buffer_size += get_aligned_size(sizes.prop);
+        #define X(type, __, prop) buffer_size += get_aligned_size(sizes.prop * sizeof(*(type)0));
         ROOT_ARRAYS
         #undef X
-        buffer_size += get_aligned_size(sizes.mesh_primitives);
-        buffer_size += get_aligned_size(sizes.mesh_primitive_attributes);
+        #define X(type, prop) buffer_size += get_aligned_size(sizes.prop * sizeof(*(type)0));
+        ARENA_POOLS
+        #undef X
         return buffer_size;
 }
 
@@ -1149,33 +3043,4032 @@ inline bool pla_set_arena(pla_GLTF_sizes const * sizes, size_t buffer_size, u8 *
         size_t offset = 0;
 
         //Keep in sync with arena struct.
-        #define X(type, _, prop) arena->prop = (type)buffer + offset; offset += get_aligned_size(sizes->prop); if(offset > buffer_size) return false;
+        #define X(type, _, prop) arena->prop = (type)(buffer + offset); offset += get_aligned_size(sizes->prop * sizeof(*arena->prop)); if(offset > buffer_size) return false;
         ROOT_ARRAYS
         #undef X
-        arena->mesh_primitives = (pla_mesh_primitive *)buffer + offset; offset += get_aligned_size(sizes->mesh_primitives); if(offset > buffer_size) return false;
-        arena->mesh_primitive_attributes = (pla_mesh_primitive_attribute *)buffer + offset; offset += get_aligned_size(sizes->mesh_primitive_attributes); if(offset > buffer_size) return false;
+        #define X(type, prop) arena->prop = (type)(buffer + offset); offset += get_aligned_size(sizes->prop * sizeof(*arena->prop)); if(offset > buffer_size) return false;
+        ARENA_POOLS
+        #undef X
         return true;
 }
 
 
+//only the first failure is kept, so this is the one write the error gets on a parse that works.
+static inline void pla_reset_parse_error(pla_parse_error * error){
+        if(!error) return;
+        error->code = pla_parse_error_none;
+        error->offset = 0;
+        error->section = pla_root_none;
+        error->path[0] = 0;
+}
+
 //Its expected that you call this twice, once to calculate how much memory is need then again with a buffer large enought to fit everything.
-inline bool pla_parse_GLTF(u32 data_size, u8 const * data, size_t * buffer_size, u8 * buffer, pla_GLTF * out_gltf){
+//the second call builds the json tape first, at the end of the buffer where the arena keeps it, so working out the sizes again doesn't rescan the json.
+//error can be null, when the parse fails it says why and where. each call has its own so batches and parses on many threads all get theirs.
+inline bool pla_parse_GLTF_with_error(u32 data_size, u8 const * data, size_t * buffer_size, u8 * buffer, pla_GLTF * out_gltf, pla_parse_error * error){
         if(!buffer_size) return false;
+        pla_reset_parse_error(error);
         if(!buffer){
                 pla_GLTF_sizes sizes;
-                if(!pla_parse_gltf_arena_style(data_size, data, &sizes, NULL, NULL)) return false;
+                if(!pla_parse_gltf_reporting(data_size, data, PLA_NULL, &sizes, NULL, NULL, error)) return false;
                 *buffer_size = pla_get_buffer_size_from_sizes(sizes);
                 return true;
         }
         if(!out_gltf) return false;
+        pla_chunk json_chunk;
+        pla_chunk binary_chunk;
+        if(!pla_get_glb_chunks_reporting(data_size, data, &json_chunk, &binary_chunk, error)) return false;
+        u32 entry_count = 0;
+        if(!pla_build_json_tape_reporting(json_chunk.size, json_chunk.data, &entry_count, PLA_NULL, error)) return false;
+        //tape_entries is the last pool in the arena.
+        usize tape_size = get_aligned_size(entry_count * sizeof(pla_tape_entry));
+        if(tape_size > *buffer_size) return pla_set_parse_error(error, pla_parse_error_memory_mismatch, 0);
+        pla_tape_entry * entries = (pla_tape_entry *)(buffer + *buffer_size - tape_size);
+        if(!pla_build_json_tape_reporting(json_chunk.size, json_chunk.data, &entry_count, entries, error)) return false;
+        pla_json_tape tape = {.entries = entries, .entry_count = entry_count, .json = json_chunk.data, .json_size = json_chunk.size};
+
+        pla_GLTF_sizes sizes;
+        if(!pla_parse_gltf_reporting(data_size, data, &tape, &sizes, NULL, NULL, error)) return false;
+        if(*buffer_size != pla_get_buffer_size_from_sizes(sizes) + tape_size) return pla_set_parse_error(error, pla_parse_error_memory_mismatch, 0);
+        pla_GLTF_arena arena;
+        if(!pla_set_arena(&sizes, *buffer_size - tape_size, buffer, &arena)) return pla_set_parse_error(error, pla_parse_error_memory_mismatch, 0);
+        return pla_parse_gltf_reporting(data_size, data, &tape, &sizes, &arena, out_gltf, error);
+}
+
+//pla_parse_GLTF_with_error without the error.
+inline bool pla_parse_GLTF(u32 data_size, u8 const * data, size_t * buffer_size, u8 * buffer, pla_GLTF * out_gltf){
+        return pla_parse_GLTF_with_error(data_size, data, buffer_size, buffer, out_gltf, PLA_NULL);
+}
+
+//Linear allocators.
+//Memory is handed out front to back from regions a pla_allocator gives, a mark is how far it got and resetting to a mark frees everything after it at once.
+//regions are kept across resets, so once they've grown to what a workload needs nothing is asked of the pla_allocator again til pla_release_linear_allocator.
+
+typedef struct pla_region pla_region;
+struct pla_region{
+        pla_region * next;
+        //bytes after the header.
+        usize size;
+};
+
+typedef struct pla_linear_allocator{
+        //where regions come from, the hook for huge page or numa local memory.
+        pla_allocator backing;
+        //smallest region asked for.
+        usize region_size;
+        //region sizes, header included, are rounded up to this so a huge page backing gets whole pages. 0 for no rounding.
+        usize region_alignment;
+        pla_region * first;
+        //null til the first allocation.
+        pla_region * current;
+        usize used;
+} pla_linear_allocator;
+
+typedef struct pla_linear_mark{
+        pla_region * region;
+        usize used;
+} pla_linear_mark;
+
+static inline void * pla_heap_allocate(void * user_data, usize size){
+        return malloc(size);
+}
+
+static inline void pla_heap_free(void * user_data, void * pointer){
+        free(pointer);
+}
+
+//malloc and free.
+inline pla_allocator pla_get_heap_allocator(void) NOEXCEPT{
+        pla_allocator allocator = {PLA_NULL, pla_heap_allocate, pla_heap_free, PLA_NULL};
+        return allocator;
+}
+
+inline pla_linear_allocator pla_make_linear_allocator(pla_allocator backing, usize region_size, usize region_alignment) NOEXCEPT{
+        pla_linear_allocator allocator = {.backing = backing, .region_size = region_size, .region_alignment = region_alignment, .first = PLA_NULL, .current = PLA_NULL, .used = 0};
+        return allocator;
+}
+
+//Where size bytes at alignment go in region after used bytes, null if they don't fit.
+static inline u8 * pla_region_fit(pla_region * region, usize used, usize size, usize alignment){
+        u8 * base = (u8 *)(region + 1);
+        usize start = get_aligned_size_to((usize)base + used, alignment) - (usize)base;
+        if(start > region->size || size > region->size - start) return PLA_NULL;
+        return base + start;
+}
+
+//size bytes at alignment, a power of 2. null if the backing allocator doesn't give a region.
+inline void * pla_linear_allocate(pla_linear_allocator * allocator, usize size, usize alignment) NOEXCEPT{
+        if(alignment == 0) alignment = 1;
+        //regions after the current one are free since the last reset, they're used before asking for a new one.
+        for(pla_region * region = allocator->current; region; region = region->next){
+                u8 * at = pla_region_fit(region, region == allocator->current ? allocator->used : 0, size, alignment);
+                if(!at) continue;
+                allocator->current = region;
+                allocator->used = (usize)(at - (u8 *)(region + 1)) + size;
+                return at;
+        }
+        if(!allocator->backing.allocate || size > SIZE_MAX / 2) return PLA_NULL;
+        usize region_size = sizeof(pla_region) + size + alignment;
+        if(region_size < allocator->region_size) region_size = allocator->region_size;
+        if(allocator->region_alignment > 1) region_size = get_aligned_size_to(region_size, allocator->region_alignment);
+        pla_region * region = (pla_region *)allocator->backing.allocate(allocator->backing.user_data, region_size);
+        if(!region) return PLA_NULL;
+        region->next = PLA_NULL;
+        region->size = region_size - sizeof(pla_region);
+        //appended so the regions that were too small stay in the chain for after a reset.
+        pla_region ** tail = &allocator->first;
+        while(*tail) tail = &(*tail)->next;
+        *tail = region;
+        u8 * at = pla_region_fit(region, 0, size, alignment);
+        allocator->current = region;
+        allocator->used = (usize)(at - (u8 *)(region + 1)) + size;
+        return at;
+}
+
+//Bytes at alignment left in the current region, what can be allocated without a new one.
+inline usize pla_linear_available(pla_linear_allocator const * allocator, usize alignment) NOEXCEPT{
+        pla_region * region = allocator->current;
+        if(!region) return 0;
+        u8 * base = (u8 *)(region + 1);
+        usize start = get_aligned_size_to((usize)base + allocator->used, alignment ? alignment : 1) - (usize)base;
+        return start < region->size ? region->size - start : 0;
+}
+
+inline pla_linear_mark pla_linear_get_mark(pla_linear_allocator const * allocator) NOEXCEPT{
+        pla_linear_mark mark = {allocator->current, allocator->used};
+        return mark;
+}
+
+//Frees everything allocated since mark was taken.
+inline void pla_linear_reset_to(pla_linear_allocator * allocator, pla_linear_mark mark) NOEXCEPT{
+        allocator->current = mark.region ? mark.region : allocator->first;
+        allocator->used = mark.used;
+}
+
+inline void pla_linear_reset(pla_linear_allocator * allocator) NOEXCEPT{
+        allocator->current = allocator->first;
+        allocator->used = 0;
+}
+
+//Gives every region back to the backing allocator.
+inline void pla_release_linear_allocator(pla_linear_allocator * allocator) NOEXCEPT{
+        for(pla_region * region = allocator->first; region;){
+                pla_region * next = region->next;
+                if(allocator->backing.free_sized) allocator->backing.free_sized(allocator->backing.user_data, region, sizeof(pla_region) + region->size);
+                else if(allocator->backing.free) allocator->backing.free(allocator->backing.user_data, region);
+                region = next;
+        }
+        allocator->first = PLA_NULL;
+        allocator->current = PLA_NULL;
+        allocator->used = 0;
+}
+
+//Per thread scratch.
+//Temporaries come from a linear allocator of the calling thread that is reset to where it was before returning, so it only grows to the biggest one and then never allocates.
+
+#define PLA_SCRATCH_REGION_SIZE (1u << 20)
+
+//where scratch regions come from, per translation unit like the rest of the header's statics.
+static pla_allocator pla_scratch_backing = {PLA_NULL, pla_heap_allocate, pla_heap_free, PLA_NULL};
+static usize pla_scratch_region_alignment = 0;
+static PLA_THREAD_LOCAL pla_linear_allocator pla_thread_scratch;
+
+//Sets where the scratch of threads that haven't used theirs yet gets its regions, call it before starting the threads. its malloc til then.
+inline void pla_set_scratch_allocator(pla_allocator backing, usize region_alignment) NOEXCEPT{
+        pla_scratch_backing = backing;
+        pla_scratch_region_alignment = region_alignment;
+}
+
+//The scratch of the calling thread, take a mark before using it and reset to it after.
+inline pla_linear_allocator * pla_get_scratch(void) NOEXCEPT{
+        pla_linear_allocator * scratch = &pla_thread_scratch;
+        if(!scratch->backing.allocate) *scratch = pla_make_linear_allocator(pla_scratch_backing, PLA_SCRATCH_REGION_SIZE, pla_scratch_region_alignment);
+        return scratch;
+}
+
+//Gives the regions of the calling thread's scratch back, for threads that are about to exit.
+inline void pla_release_scratch(void) NOEXCEPT{
+        pla_release_linear_allocator(&pla_thread_scratch);
+}
+
+//One call parse in to a linear allocator, no size pass over the bytes: the tape is built first and the sizes come from walking it.
+//the tape is built straight in to what's left of the current region when it fits there and counted first when it doesn't.
+//with an allocator that is reset and reused from file to file nothing is allocated once its regions have grown to the biggest one.
+//on failure the allocator is reset to where it was. error can be null.
+inline bool pla_parse_GLTF_with_allocator(u32 data_size, u8 const * data, pla_linear_allocator * allocator, pla_GLTF * out_gltf, pla_parse_error * error) NOEXCEPT{
+        if(!allocator || !out_gltf) return false;
+        pla_reset_parse_error(error);
+        pla_chunk json_chunk;
+        pla_chunk binary_chunk;
+        if(!pla_get_glb_chunks_reporting(data_size, data, &json_chunk, &binary_chunk, error)) return false;
+        usize alignment = sizeof(void *);
+        pla_linear_mark mark = pla_linear_get_mark(allocator);
+
+        usize available = pla_linear_available(allocator, alignment) / sizeof(pla_tape_entry);
+        u32 entry_count = available > UINT32_MAX ? UINT32_MAX : (u32)available;
+        pla_tape_entry * entries = entry_count ? (pla_tape_entry *)pla_linear_allocate(allocator, (usize)entry_count * sizeof(pla_tape_entry), alignment) : PLA_NULL;
+        bool built = entries && pla_build_json_tape_reporting(json_chunk.size, json_chunk.data, &entry_count, entries, PLA_NULL);
+        pla_linear_reset_to(allocator, mark);
+        //didn't fit, or the json is broken and counting says where.
+        if(!built){
+                entry_count = 0;
+                if(!pla_build_json_tape_reporting(json_chunk.size, json_chunk.data, &entry_count, PLA_NULL, error)) return false;
+        }
+        //when it was built this is the same memory, with what the tape didn't use given back.
+        entries = (pla_tape_entry *)pla_linear_allocate(allocator, (usize)entry_count * sizeof(pla_tape_entry), alignment);
+        if(!entries) return pla_set_parse_error(error, pla_parse_error_out_of_memory, 0);
+        if(!built && !pla_build_json_tape_reporting(json_chunk.size, json_chunk.data, &entry_count, entries, error)){
+                pla_linear_reset_to(allocator, mark);
+                return false;
+        }
+        pla_json_tape tape = {.entries = entries, .entry_count = entry_count, .json = json_chunk.data, .json_size = json_chunk.size};
+
         pla_GLTF_sizes sizes;
-        if(!pla_parse_gltf_arena_style(data_size, data, &sizes, NULL, NULL)) return false;
-        if(*buffer_size != pla_get_buffer_size_from_sizes(sizes)) return false;
         pla_GLTF_arena arena;
-        if(!pla_set_arena(&sizes, *buffer_size, buffer, &arena)) return false;
-        return pla_parse_gltf_arena_style(data_size, data, &sizes, &arena, out_gltf);
+        usize size = 0;
+        u8 * buffer = PLA_NULL;
+        bool parsed = pla_parse_gltf_reporting(data_size, data, &tape, &sizes, PLA_NULL, PLA_NULL, error);
+        if(parsed){
+                size = pla_get_buffer_size_from_sizes(sizes);
+                buffer = (u8 *)pla_linear_allocate(allocator, size, alignment);
+                if(!buffer) parsed = pla_set_parse_error(error, pla_parse_error_out_of_memory, 0);
+        }
+        parsed = parsed && pla_set_arena(&sizes, size, buffer, &arena) && pla_parse_gltf_reporting(data_size, data, &tape, &sizes, &arena, out_gltf, error);
+        if(!parsed) pla_linear_reset_to(allocator, mark);
+        return parsed;
 }
 
+//Scene traversal.
+//Children and scene roots are runs in the index pool, so a scene flattens in to one array that is walked front to back.
+
+//Lists the nodes of a scene breadth first, every node comes after its parent. out_parents gets the position of each ones parent in out_nodes, PLA_INDEX_NONE for the roots.
+//out_nodes and out_parents need room for gltf->nodes_size indices, out_parents can be null. the output is its own queue so there is no stack and no recursion.
+//returns false if the scene or a node index is out of range or more than nodes_size nodes are reached, which a cycle does.
+inline bool pla_flatten_scene(pla_GLTF const * gltf, u32 scene, u32 * out_count, u32 * out_nodes, u32 * out_parents) NOEXCEPT{
+        *out_count = 0;
+        if(scene >= gltf->scenes_size) return false;
+        u32 capacity = gltf->nodes_size;
+        u32 count = 0;
+        pla_scene const * s = &gltf->scenes[scene];
+        for(u32 i = 0; i < s->node_count; ++i){
+                if(s->nodes[i] >= capacity || count >= capacity) return false;
+                out_nodes[count] = s->nodes[i];
+                if(out_parents) out_parents[count] = PLA_INDEX_NONE;
+                ++count;
+        }
+        for(u32 i = 0; i < count; ++i){
+                pla_node const * node = &gltf->nodes[out_nodes[i]];
+                for(u32 c = 0; c < node->child_count; ++c){
+                        if(node->children[c] >= capacity || count >= capacity) return false;
+                        out_nodes[count] = node->children[c];
+                        if(out_parents) out_parents[count] = i;
+                        ++count;
+                }
+        }
+        *out_count = count;
+        return true;
+}
+
+//out = a * b, column major 4x4.
+static inline void pla_multiply_matrices(f32 const * a, f32 const * b, f32 * out){
+        for(u32 column = 0; column < 4; ++column){
+                for(u32 row = 0; row < 4; ++row){
+                        f32 sum = 0;
+                        for(u32 k = 0; k < 4; ++k) sum += a[k * 4 + row] * b[column * 4 + k];
+                        out[column * 4 + row] = sum;
+                }
+        }
+}
+
+//World transforms of a flattened scene in one forward pass, out_matrices gets 16 column major floats per node in the order of nodes.
+inline void pla_compute_world_matrices(pla_GLTF const * gltf, u32 count, u32 const * nodes, u32 const * parents, f32 * out_matrices) NOEXCEPT{
+        for(u32 i = 0; i < count; ++i){
+                f32 const * local = gltf->nodes[nodes[i]].matrix;
+                f32 * world = out_matrices + (usize)i * 16;
+                if(parents[i] == PLA_INDEX_NONE){
+                        memcpy(world, local, sizeof(f32) * 16);
+                        continue;
+                }
+                pla_multiply_matrices(out_matrices + (usize)parents[i] * 16, local, world);
+        }
+}
+
+//World transform of every node of a scene at its node index, 16 column major floats each, out_matrices has room for gltf->nodes_size. nodes outside the scene aren't written.
+//the flattened scene is a temporary in the calling thread's scratch.
+inline bool pla_get_scene_world_matrices(pla_GLTF const * gltf, u32 scene, f32 * out_matrices) NOEXCEPT{
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        u32 * nodes = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * 2 * ((usize)gltf->nodes_size + 1), sizeof(u32));
+        if(!nodes) return false;
+        u32 * parents = nodes + gltf->nodes_size + 1;
+        u32 count = 0;
+        bool ok = pla_flatten_scene(gltf, scene, &count, nodes, parents);
+        for(u32 i = 0; i < count; ++i){
+                f32 const * local = gltf->nodes[nodes[i]].matrix;
+                f32 * world = out_matrices + (usize)nodes[i] * 16;
+                if(parents[i] == PLA_INDEX_NONE){
+                        memcpy(world, local, sizeof(f32) * 16);
+                        continue;
+                }
+                //parents come first so theirs is already written.
+                pla_multiply_matrices(out_matrices + (usize)nodes[parents[i]] * 16, local, world);
+        }
+        pla_linear_reset_to(scratch, mark);
+        return ok;
+}
+
+//Returns a pointer to the first element of the accessor in the bin chunk, or null if the accessor doesn't fit in it.
+static inline u8 const * pla_get_accessor_data(pla_GLTF const * gltf, pla_accessor const * accessor, u32 * out_stride){
+        if(accessor->buffer_view >= gltf->buffer_views_size) return PLA_NULL;
+        pla_buffer_view const * view = &gltf->buffer_views[accessor->buffer_view];
+        u32 element_size = pla_GLTF_component_type_byte_count[accessor->component_type] * pla_GLTF_type_component_count[accessor->type];
+        u32 stride = view->byte_stride ? view->byte_stride : element_size;
+        u64 end = accessor->count ? accessor->byte_offset + (u64)stride * (accessor->count - 1) + element_size : accessor->byte_offset;
+        if(end > view->byte_length) return PLA_NULL;
+        *out_stride = stride;
+        //compressed views are read from where they were decoded to.
+        if(view->meshopt.mode != pla_meshopt_mode_none) return view->data ? view->data + accessor->byte_offset : PLA_NULL;
+        if(view->buffer >= gltf->buffers_size || !gltf->buffers[view->buffer].data) return PLA_NULL;
+        pla_buffer const * buffer = &gltf->buffers[view->buffer];
+        if((u64)view->byte_offset + end > buffer->byte_length) return PLA_NULL;
+        return buffer->data + view->byte_offset + accessor->byte_offset;
+}
+
+//Converts count elements starting at first into tightly packed floats, normalized integers are mapped to [0, 1] or [-1, 1].
+static inline void pla_unpack_accessor_f32(u8 const * data, u32 stride, pla_GLTF_component_type component_type, u32 component_count, bool normalized, u32 first, u32 count, f32 * out){
+        data += (usize)stride * first;
+        //The switch is hoisted out of the loops so each one is a straight conversion.
+        #define unpack_loop(type, scale) \
+                for(u32 i = 0; i < count; ++i){ \
+                        type element[16]; \
+                        memcpy(element, data + (usize)stride * i, sizeof(type) * component_count); \
+                        for(u32 comp = 0; comp < component_count; ++comp) out[i * component_count + comp] = (f32)element[comp] * scale; \
+                }
+        //packed small integers go through the dispatched kernels.
+        #define unpack_small(type, kernel, scale) \
+                if(stride == sizeof(type) * component_count) pla_get_kernels()->kernel(data, (usize)count * component_count, scale, out); \
+                else unpack_loop(type, scale)
+        switch(component_type){
+                case pla_GLTF_component_type_s8:  { f32 scale = normalized ? 1.0f / 127.0f : 1.0f; unpack_small(s8, convert_s8, scale) break; }
+                case pla_GLTF_component_type_u8:  { f32 scale = normalized ? 1.0f / 255.0f : 1.0f; unpack_small(u8, convert_u8, scale) break; }
+                case pla_GLTF_component_type_s16: { f32 scale = normalized ? 1.0f / 32767.0f : 1.0f; unpack_small(s16, convert_s16, scale) break; }
+                case pla_GLTF_component_type_u16: { f32 scale = normalized ? 1.0f / 65535.0f : 1.0f; unpack_small(u16, convert_u16, scale) break; }
+                case pla_GLTF_component_type_u32: { unpack_loop(u32, 1.0f) break; }
+                case pla_GLTF_component_type_f32: { unpack_loop(f32, 1.0f) break; }
+                default: break;
+        }
+        #undef unpack_small
+        #undef unpack_loop
+        //signed normalized values can go one past -1.
+        if(normalized && (component_type == pla_GLTF_component_type_s8 || component_type == pla_GLTF_component_type_s16)){
+                for(u32 i = 0; i < count * component_count; ++i) out[i] = out[i] < -1.0f ? -1.0f : out[i];
+        }
+}
+
+typedef enum pla_vertex_encoding{
+        //the attribute is left out of the packed vertex.
+        pla_vertex_encoding_none,
+        pla_vertex_encoding_f32,
+        pla_vertex_encoding_f16,
+        //u16 normalized into the bounds of the attribute, decode with the stream scale and bias.
+        pla_vertex_encoding_unorm16_bounds,
+        pla_vertex_encoding_snorm16,
+        pla_vertex_encoding_unorm16,
+        pla_vertex_encoding_unorm8,
+        //unit vectors as 2 components, a 4th source component (tangent w) is kept as a sign after them.
+        pla_vertex_encoding_octahedral_snorm16,
+        pla_vertex_encoding_octahedral_snorm8,
+        //integers like joint indices.
+        pla_vertex_encoding_u8,
+        pla_vertex_encoding_u16,
+        pla_vertex_encoding_MAX_ENUM,
+} pla_vertex_encoding;
+
+u8 const pla_vertex_encoding_component_byte_count[pla_vertex_encoding_MAX_ENUM] = {0, 4, 2, 2, 2, 2, 1, 2, 1, 1, 2};
+
+typedef struct pla_quantize_config{
+        pla_vertex_encoding encodings[pla_mesh_primitive_attribute_name_MAX_ENUM];
+        //packs TEXCOORD_1, COLOR_1 and so on instead of only the first set.
+        bool pack_all_sets;
+} pla_quantize_config;
+
+//positions in the bounds, octahedral normals and tangents, half float uvs.
+INTERNAL pla_quantize_config pla_default_quantize_config(void) NOEXCEPT{
+        pla_quantize_config config = {};
+        config.encodings[pla_POSITION] = pla_vertex_encoding_unorm16_bounds;
+        config.encodings[pla_NORMAL] = pla_vertex_encoding_octahedral_snorm16;
+        config.encodings[pla_TANGENT] = pla_vertex_encoding_octahedral_snorm16;
+        config.encodings[pla_TEXCOORD] = pla_vertex_encoding_f16;
+        config.encodings[pla_COLOR] = pla_vertex_encoding_unorm8;
+        config.encodings[pla_JOINTS] = pla_vertex_encoding_u8;
+        config.encodings[pla_WEIGHTS] = pla_vertex_encoding_unorm8;
+        config.pack_all_sets = false;
+        return config;
+}
+
+typedef struct pla_vertex_stream{
+        pla_mesh_primitive_attribute_name name;
+        s8 set_index;
+        pla_vertex_encoding encoding;
+        u32 accessor;
+        u16 offset;
+        u8 source_component_count;
+        u8 component_count;
+        //decoded = quantized * scale + bias, only used by the bounds encoding.
+        f32 scale[4];
+        f32 bias[4];
+        //largest difference between a decoded component and the source, filled in when encoding.
+        f32 max_error;
+} pla_vertex_stream;
+
+#define PLA_MAX_VERTEX_STREAMS 16
+
+typedef struct pla_vertex_layout{
+        pla_vertex_stream streams[PLA_MAX_VERTEX_STREAMS];
+        u32 stream_count;
+        u32 stride;
+        u32 vertex_count;
+} pla_vertex_layout;
+
+INTERNAL u16 pla_f32_to_f16(f32 value) NOEXCEPT{
+        u32 bits = 0;
+        memcpy(&bits, &value, 4);
+        u32 sign = (bits >> 16) & 0x8000;
+        u32 abs_bits = bits & 0x7fffffff;
+        //rebias the exponent and round, then pick flush to zero, infinity or nan without branching.
+        u32 half = (abs_bits - (112u << 23) + (1u << 12)) >> 13;
+        half = abs_bits < (113u << 23) ? 0 : half;
+        half = abs_bits >= (143u << 23) ? 0x7c00 : half;
+        half = abs_bits > (255u << 23) ? 0x7e00 : half;
+        return (u16)(sign | half);
+}
+
+INTERNAL f32 pla_f16_to_f32(u16 half) NOEXCEPT{
+        u32 sign = (u32)(half & 0x8000) << 16;
+        u32 exponent_mantissa = half & 0x7fff;
+        u32 bits = (exponent_mantissa + (112u << 10)) << 13;
+        bits = exponent_mantissa < (1u << 10) ? 0 : bits;
+        bits = exponent_mantissa >= (31u << 10) ? bits + (112u << 23) : bits;
+        bits |= sign;
+        f32 value = 0;
+        memcpy(&value, &bits, 4);
+        return value;
+}
+
+static inline s32 pla_round_to_s32(f32 value){ return (s32)(value + (value >= 0 ? 0.5f : -0.5f)); }
+static inline f32 pla_clamp_f32(f32 value, f32 min, f32 max){ return value < min ? min : value > max ? max : value; }
+
+static inline bool pla_vertex_encoding_is_octahedral(pla_vertex_encoding encoding){
+        return encoding == pla_vertex_encoding_octahedral_snorm16 || encoding == pla_vertex_encoding_octahedral_snorm8;
+}
+
+//Builds the interleaved layout, every stream starts 4 byte aligned.
+static inline bool pla_build_vertex_layout(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_quantize_config const * config, pla_vertex_layout * layout){
+        memset(layout, 0, sizeof(*layout));
+        u32 offset = 0;
+        bool has_vertex_count = false;
+        for(u32 i = 0; i < primitive->attribute_count; ++i){
+                pla_mesh_primitive_attribute attribute = primitive->attributes[i];
+                pla_vertex_encoding encoding = config->encodings[attribute.name];
+                if(encoding == pla_vertex_encoding_none || encoding >= pla_vertex_encoding_MAX_ENUM) continue;
+                if(attribute.set_index != 0 && !config->pack_all_sets) continue;
+                if(attribute.accessor >= gltf->accessors_size) return false;
+                if(layout->stream_count == PLA_MAX_VERTEX_STREAMS) return false;
+
+                pla_accessor const * accessor = &gltf->accessors[attribute.accessor];
+                if(has_vertex_count && accessor->count != layout->vertex_count) return false;
+                layout->vertex_count = accessor->count;
+                has_vertex_count = true;
+
+                u8 source_component_count = pla_GLTF_type_component_count[accessor->type];
+                if(source_component_count > 4) return false;
+                u8 component_count = source_component_count;
+                if(pla_vertex_encoding_is_octahedral(encoding)){
+                        if(source_component_count < 3) return false;
+                        component_count = source_component_count == 4 ? 4 : 2;
+                }
+
+                pla_vertex_stream * stream = &layout->streams[layout->stream_count++];
+                stream->name = attribute.name;
+                stream->set_index = attribute.set_index;
+                stream->encoding = encoding;
+                stream->accessor = attribute.accessor;
+                stream->offset = offset;
+                stream->source_component_count = source_component_count;
+                stream->component_count = component_count;
+                for(u32 comp = 0; comp < 4; ++comp){
+                        stream->scale[comp] = 1.0f;
+                        stream->bias[comp] = 0.0f;
+                }
+                offset += get_aligned_size_to(component_count * pla_vertex_encoding_component_byte_count[encoding], 4);
+        }
+        layout->stride = offset;
+        return true;
+}
+
+//integer attributes and the ones the spec only allows as normalized integers.
+static inline bool pla_attribute_is_normalized(pla_mesh_primitive_attribute_name name, pla_GLTF_component_type component_type){
+        if(component_type == pla_GLTF_component_type_f32) return false;
+        return name == pla_TEXCOORD || name == pla_COLOR || name == pla_WEIGHTS;
+}
+
+#define PLA_QUANTIZE_CHUNK 64
+
+//finds the bounds of a stream so the bounds encoding can use the whole u16 range.
+static inline bool pla_compute_stream_bounds(pla_GLTF const * gltf, pla_vertex_stream * stream){
+        pla_accessor const * accessor = &gltf->accessors[stream->accessor];
+        u32 stride = 0;
+        u8 const * data = pla_get_accessor_data(gltf, accessor, &stride);
+        if(!data) return false;
+        u32 comps = stream->source_component_count;
+        f32 min[4] = {INFINITY, INFINITY, INFINITY, INFINITY};
+        f32 max[4] = {-INFINITY, -INFINITY, -INFINITY, -INFINITY};
+        f32 values[PLA_QUANTIZE_CHUNK * 4];
+        for(u32 first = 0; first < accessor->count; first += PLA_QUANTIZE_CHUNK){
+                u32 count = accessor->count - first < PLA_QUANTIZE_CHUNK ? accessor->count - first : PLA_QUANTIZE_CHUNK;
+                pla_unpack_accessor_f32(data, stride, accessor->component_type, comps, pla_attribute_is_normalized(stream->name, accessor->component_type), first, count, values);
+                for(u32 i = 0; i < count; ++i){
+                        for(u32 comp = 0; comp < comps; ++comp){
+                                f32 value = values[i * comps + comp];
+                                min[comp] = value < min[comp] ? value : min[comp];
+                                max[comp] = value > max[comp] ? value : max[comp];
+                        }
+                }
+        }
+        for(u32 comp = 0; comp < comps; ++comp){
+                f32 extent = accessor->count ? max[comp] - min[comp] : 0.0f;
+                stream->bias[comp] = accessor->count ? min[comp] : 0.0f;
+                stream->scale[comp] = extent / 65535.0f;
+        }
+        return true;
+}
+
+//Maps a unit vector on to the octahedron and unfolds the lower half, out gets 2 values in [-1, 1].
+static inline void pla_octahedral_encode(f32 x, f32 y, f32 z, f32 * out){
+        f32 length = fabsf(x) + fabsf(y) + fabsf(z);
+        f32 inverse = length > 0 ? 1.0f / length : 0.0f;
+        x *= inverse;
+        y *= inverse;
+        f32 folded_x = (1.0f - fabsf(y)) * (x >= 0 ? 1.0f : -1.0f);
+        f32 folded_y = (1.0f - fabsf(x)) * (y >= 0 ? 1.0f : -1.0f);
+        out[0] = z < 0 ? folded_x : x;
+        out[1] = z < 0 ? folded_y : y;
+}
+
+static inline void pla_octahedral_decode(f32 x, f32 y, f32 * out){
+        f32 z = 1.0f - fabsf(x) - fabsf(y);
+        f32 t = z < 0 ? -z : 0.0f;
+        x += x >= 0 ? -t : t;
+        y += y >= 0 ? -t : t;
+        f32 length = sqrtf(x * x + y * y + z * z);
+        f32 inverse = length > 0 ? 1.0f / length : 0.0f;
+        out[0] = x * inverse;
+        out[1] = y * inverse;
+        out[2] = z * inverse;
+}
+
+//Encodes count unpacked elements in to the interleaved vertices and returns the largest error.
+static inline f32 pla_encode_vertex_stream(pla_vertex_stream const * stream, f32 const * values, u32 count, u32 stride, u8 * out){
+        u32 comps = stream->source_component_count;
+        f32 max_error = 0.0f;
+        //flat arrays so the encode loops stay simple enough to vectorize.
+        s32 quantized[PLA_QUANTIZE_CHUNK * 4];
+        f32 decoded[PLA_QUANTIZE_CHUNK * 4];
+        f32 source[PLA_QUANTIZE_CHUNK * 4];
+        u32 total = count * stream->component_count;
+
+        if(pla_vertex_encoding_is_octahedral(stream->encoding)){
+                f32 range = stream->encoding == pla_vertex_encoding_octahedral_snorm16 ? 32767.0f : 127.0f;
+                u32 out_comps = stream->component_count;
+                for(u32 i = 0; i < count; ++i){
+                        f32 const * v = values + i * comps;
+                        f32 octahedral[2];
+                        pla_octahedral_encode(v[0], v[1], v[2], octahedral);
+                        quantized[i * out_comps + 0] = pla_round_to_s32(pla_clamp_f32(octahedral[0], -1.0f, 1.0f) * range);
+                        quantized[i * out_comps + 1] = pla_round_to_s32(pla_clamp_f32(octahedral[1], -1.0f, 1.0f) * range);
+                        if(out_comps == 4){
+                                quantized[i * out_comps + 2] = v[3] < 0 ? -(s32)range : (s32)range;
+                                quantized[i * out_comps + 3] = 0;
+                        }
+                        f32 normal[3];
+                        pla_octahedral_decode(quantized[i * out_comps] / range, quantized[i * out_comps + 1] / range, normal);
+                        f32 length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                        f32 inverse = length > 0 ? 1.0f / length : 0.0f;
+                        for(u32 comp = 0; comp < 3; ++comp){
+                                f32 error = fabsf(normal[comp] - v[comp] * inverse);
+                                max_error = error > max_error ? error : max_error;
+                        }
+                }
+        }else{
+                for(u32 i = 0; i < total; ++i) source[i] = values[i];
+                switch(stream->encoding){
+                        case pla_vertex_encoding_f32:
+                                for(u32 i = 0; i < total; ++i) decoded[i] = source[i];
+                                break;
+                        case pla_vertex_encoding_f16:
+                                for(u32 i = 0; i < total; ++i) quantized[i] = pla_f32_to_f16(source[i]);
+                                for(u32 i = 0; i < total; ++i) decoded[i] = pla_f16_to_f32((u16)quantized[i]);
+                                break;
+                        case pla_vertex_encoding_unorm16_bounds:
+                                for(u32 i = 0; i < total; ++i){
+                                        u32 comp = i % comps;
+                                        f32 inverse_scale = stream->scale[comp] > 0 ? 1.0f / stream->scale[comp] : 0.0f;
+                                        quantized[i] = pla_round_to_s32(pla_clamp_f32((source[i] - stream->bias[comp]) * inverse_scale, 0.0f, 65535.0f));
+                                        decoded[i] = quantized[i] * stream->scale[comp] + stream->bias[comp];
+                                }
+                                break;
+                        case pla_vertex_encoding_snorm16:
+                                for(u32 i = 0; i < total; ++i) quantized[i] = pla_round_to_s32(pla_clamp_f32(source[i], -1.0f, 1.0f) * 32767.0f);
+                                for(u32 i = 0; i < total; ++i) decoded[i] = quantized[i] / 32767.0f;
+                                break;
+                        case pla_vertex_encoding_unorm16:
+                                for(u32 i = 0; i < total; ++i) quantized[i] = pla_round_to_s32(pla_clamp_f32(source[i], 0.0f, 1.0f) * 65535.0f);
+                                for(u32 i = 0; i < total; ++i) decoded[i] = quantized[i] / 65535.0f;
+                                break;
+                        case pla_vertex_encoding_unorm8:
+                                for(u32 i = 0; i < total; ++i) quantized[i] = pla_round_to_s32(pla_clamp_f32(source[i], 0.0f, 1.0f) * 255.0f);
+                                for(u32 i = 0; i < total; ++i) decoded[i] = quantized[i] / 255.0f;
+                                break;
+                        case pla_vertex_encoding_u8:
+                                for(u32 i = 0; i < total; ++i) quantized[i] = pla_round_to_s32(pla_clamp_f32(source[i], 0.0f, 255.0f));
+                                for(u32 i = 0; i < total; ++i) decoded[i] = (f32)quantized[i];
+                                break;
+                        case pla_vertex_encoding_u16:
+                                for(u32 i = 0; i < total; ++i) quantized[i] = pla_round_to_s32(pla_clamp_f32(source[i], 0.0f, 65535.0f));
+                                for(u32 i = 0; i < total; ++i) decoded[i] = (f32)quantized[i];
+                                break;
+                        default: return INFINITY;
+                }
+                for(u32 i = 0; i < total; ++i){
+                        f32 error = fabsf(decoded[i] - source[i]);
+                        max_error = error > max_error ? error : max_error;
+                }
+        }
+
+        u32 out_comps = stream->component_count;
+        u32 byte_count = pla_vertex_encoding_component_byte_count[stream->encoding];
+        for(u32 i = 0; i < count; ++i){
+                u8 * vertex = out + (usize)stride * i + stream->offset;
+                for(u32 comp = 0; comp < out_comps; ++comp){
+                        s32 value = quantized[i * out_comps + comp];
+                        if(byte_count == 4){
+                                memcpy(vertex + comp * 4, &values[i * comps + comp], 4);
+                        }else if(byte_count == 2){
+                                u16 packed = (u16)value;
+                                memcpy(vertex + comp * 2, &packed, 2);
+                        }else{
+                                vertex[comp] = (u8)value;
+                        }
+                }
+        }
+        return max_error;
+}
+
+//Its expected that you call this twice, once with a null buffer to get the layout and the buffer size, then again with the same layout and a buffer that size.
+inline bool pla_quantize_primitive(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_quantize_config const * config, pla_vertex_layout * layout, usize * buffer_size, u8 * buffer){
+        if(!gltf || !primitive || !layout || !buffer_size) return false;
+        if(!buffer){
+                if(!config) return false;
+                if(!pla_build_vertex_layout(gltf, primitive, config, layout)) return false;
+                for(u32 i = 0; i < layout->stream_count; ++i){
+                        pla_vertex_stream * stream = &layout->streams[i];
+                        if(stream->encoding == pla_vertex_encoding_unorm16_bounds && !pla_compute_stream_bounds(gltf, stream)) return false;
+                }
+                *buffer_size = (usize)layout->stride * layout->vertex_count;
+                return true;
+        }
+        if(*buffer_size != (usize)layout->stride * layout->vertex_count) return false;
+        memset(buffer, 0, *buffer_size);
+
+        f32 values[PLA_QUANTIZE_CHUNK * 4];
+        for(u32 s = 0; s < layout->stream_count; ++s){
+                pla_vertex_stream * stream = &layout->streams[s];
+                pla_accessor const * accessor = &gltf->accessors[stream->accessor];
+                u32 stride = 0;
+                u8 const * data = pla_get_accessor_data(gltf, accessor, &stride);
+                if(!data) return false;
+                bool normalized = pla_attribute_is_normalized(stream->name, accessor->component_type);
+                stream->max_error = 0.0f;
+                for(u32 first = 0; first < layout->vertex_count; first += PLA_QUANTIZE_CHUNK){
+                        u32 count = layout->vertex_count - first < PLA_QUANTIZE_CHUNK ? layout->vertex_count - first : PLA_QUANTIZE_CHUNK;
+                        pla_unpack_accessor_f32(data, stride, accessor->component_type, stream->source_component_count, normalized, first, count, values);
+                        f32 error = pla_encode_vertex_stream(stream, values, count, layout->stride, buffer + (usize)layout->stride * first);
+                        stream->max_error = error > stream->max_error ? error : stream->max_error;
+                }
+        }
+        return true;
+}
+
+//Writing a parsed document back out as a glb.
+//The json is rebuilt by walking the original json chunk, members the structs hold are written from the structs
+//and everything else is copied over byte for byte, so unknown extensions and extras survive the round trip.
+//Every root array that is parsed is written from its structs, values at their spec defaults are left out.
+//a node is written with the matrix if it had one and with translation, rotation and scale otherwise, the other is ignored.
+//Strings are written verbatim, so a pla_str you change has to be escaped for json already.
+
+typedef struct pla_json_writer{
+        //null while measuring.
+        u8 * data;
+        usize size;
+        usize capacity;
+        bool needs_comma;
+        //set when a value has no json form, like a nan float.
+        bool failed;
+} pla_json_writer;
+
+static inline void pla_json_write_raw(pla_json_writer * w, void const * bytes, usize size){
+        if(w->data && w->size + size <= w->capacity) memcpy(w->data + w->size, bytes, size);
+        w->size += size;
+}
+
+static inline void pla_json_write_c_str(pla_json_writer * w, c_str str){ pla_json_write_raw(w, str, strlen(str)); }
+
+static inline void pla_json_write_separator(pla_json_writer * w){
+        if(w->needs_comma) pla_json_write_raw(w, ",", 1);
+        w->needs_comma = true;
+}
+
+static inline void pla_json_write_key(pla_json_writer * w, c_str key){
+        pla_json_write_separator(w);
+        pla_json_write_raw(w, "\"", 1);
+        pla_json_write_c_str(w, key);
+        pla_json_write_raw(w, "\":", 2);
+        w->needs_comma = false;
+}
+
+static inline void pla_json_write_string(pla_json_writer * w, pla_str str){
+        pla_json_write_separator(w);
+        pla_json_write_raw(w, "\"", 1);
+        pla_json_write_raw(w, str.data, str.length);
+        pla_json_write_raw(w, "\"", 1);
+}
+
+static inline void pla_json_write_quoted_c_str(pla_json_writer * w, c_str str){
+        pla_json_write_separator(w);
+        pla_json_write_raw(w, "\"", 1);
+        pla_json_write_c_str(w, str);
+        pla_json_write_raw(w, "\"", 1);
+}
+
+static inline void pla_json_write_u32(pla_json_writer * w, u32 value){
+        pla_json_write_separator(w);
+        u8 digits[10];
+        u32 digit_count = 0;
+        do{
+                digits[9 - digit_count++] = '0' + value % 10;
+                value /= 10;
+        }while(value);
+        pla_json_write_raw(w, digits + 10 - digit_count, digit_count);
+}
+
+//The shortest decimal of up to 9 significant digits that reads back as the same float, written with an exponent outside of 1e-5 to 1e9.
+static inline void pla_json_write_f32(pla_json_writer * w, f32 value){
+        pla_json_write_separator(w);
+        if(!isfinite(value)){
+                w->failed = true;
+                return;
+        }
+        if(value == 0){
+                pla_json_write_raw(w, "0", 1);
+                return;
+        }
+        f64 magnitude = fabs((f64)value);
+        s32 exponent = (s32)floor(log10(magnitude));
+        u64 digits = 0;
+        u32 digit_count = 1;
+        for(; digit_count <= 9; ++digit_count){
+                digits = (u64)llround(magnitude * pow(10.0, (f64)((s32)digit_count - 1 - exponent)));
+                if((f32)((f64)digits * pow(10.0, (f64)(exponent - (s32)digit_count + 1))) == (f32)magnitude) break;
+        }
+        if(digit_count > 9) digit_count = 9;
+        //rounding up can carry in to another digit, like 9.9999 to 10.
+        if(digits >= pla_u64_powers_of_10[digit_count]){
+                digits /= 10;
+                ++exponent;
+        }
+        while(digit_count > 1 && digits % 10 == 0){
+                digits /= 10;
+                --digit_count;
+        }
+        u8 decimal[9];
+        for(u32 d = digit_count; d--; digits /= 10) decimal[d] = '0' + digits % 10;
+
+        u8 text[32];
+        usize length = 0;
+        if(value < 0) text[length++] = '-';
+        if(exponent >= 0 && exponent < 9){
+                for(u32 d = 0; d < digit_count || d <= (u32)exponent; ++d){
+                        if(d == (u32)exponent + 1) text[length++] = '.';
+                        text[length++] = d < digit_count ? decimal[d] : '0';
+                }
+        }else if(exponent < 0 && exponent >= -5){
+                text[length++] = '0';
+                text[length++] = '.';
+                for(s32 z = -1; z > exponent; --z) text[length++] = '0';
+                for(u32 d = 0; d < digit_count; ++d) text[length++] = decimal[d];
+        }else{
+                text[length++] = decimal[0];
+                if(digit_count > 1) text[length++] = '.';
+                for(u32 d = 1; d < digit_count; ++d) text[length++] = decimal[d];
+                text[length++] = 'e';
+                if(exponent < 0) text[length++] = '-';
+                u32 e = (u32)(exponent < 0 ? -exponent : exponent);
+                if(e >= 10) text[length++] = '0' + e / 10;
+                text[length++] = '0' + e % 10;
+        }
+        pla_json_write_raw(w, text, length);
+}
+
+static inline void pla_json_write_begin(pla_json_writer * w, u8 symbol){
+        pla_json_write_separator(w);
+        pla_json_write_raw(w, &symbol, 1);
+        w->needs_comma = false;
+}
+
+static inline void pla_json_write_end(pla_json_writer * w, u8 symbol){
+        pla_json_write_raw(w, &symbol, 1);
+        w->needs_comma = true;
+}
+
+static inline void pla_json_write_u32_array(pla_json_writer * w, c_str key, u32 const * values, u32 count){
+        pla_json_write_key(w, key);
+        pla_json_write_begin(w, '[');
+        for(u32 i = 0; i < count; ++i) pla_json_write_u32(w, values[i]);
+        pla_json_write_end(w, ']');
+}
+
+static inline void pla_json_write_f32_array(pla_json_writer * w, c_str key, f32 const * values, u32 count){
+        pla_json_write_key(w, key);
+        pla_json_write_begin(w, '[');
+        for(u32 i = 0; i < count; ++i) pla_json_write_f32(w, values[i]);
+        pla_json_write_end(w, ']');
+}
+
+static inline bool pla_f32s_are(f32 const * values, u32 count, f32 value){
+        for(u32 i = 0; i < count; ++i) if(values[i] != value) return false;
+        return true;
+}
+
+//copies the members of the object that opens after c whose keys the caller writes itself, returns the offset of the closing squigily.
+//a c of SIZE_MAX is an object the source didn't have, nothing is copied.
+static inline usize pla_json_copy_unwritten_members(pla_json_writer * w, parse_state p, bool (*is_written)(pla_str key)){
+        if(p.c == SIZE_MAX) return SIZE_MAX;
+        u32 member_count = 0;
+        if(try_count_items_in_array_or_object(p, &member_count) == SIZE_MAX) return SIZE_MAX;
+        parse('{');
+        if(member_count == 0) return check_next_symbol_is(p, close_squirle);
+        for(u32 i = 0; i < member_count; ++i){
+                pla_str key = {0};
+                p.c = try_parse_string(p, &key);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+                usize member_begin = (usize)(key.data - 1 - p.data);
+                p.c = try_skip_value(p);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+                if(!is_written(key)){
+                        pla_json_write_separator(w);
+                        pla_json_write_raw(w, p.data + member_begin, p.c + 1 - member_begin);
+                }
+                p.c = check_next_symbol_is(p, comma | close_squirle);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+        }
+        return p.c;
+}
+
+//returns the offset of the colon after key in the object that opens after c.
+static inline usize pla_json_find_member(parse_state p, c_str name){
+        u32 member_count = 0;
+        if(try_count_items_in_array_or_object(p, &member_count) == SIZE_MAX) return SIZE_MAX;
+        parse('{');
+        for(u32 i = 0; i < member_count; ++i){
+                pla_str key = {0};
+                p.c = try_parse_string(p, &key);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+                if(pla_str_is_equal(key, name)) return check_next_symbol_is(p, colon);
+                p.c = try_skip_value(p);
+                p.c = check_next_symbol_is(p, comma | close_squirle);
+                if(p.c == SIZE_MAX) return SIZE_MAX;
+        }
+        return SIZE_MAX;
+}
+
+static inline bool pla_is_written_asset_key(pla_str key){
+        return pla_str_is_equal(key, "generator") || pla_str_is_equal(key, "version");
+}
+
+static inline usize pla_write_asset(pla_json_writer * w, parse_state p, pla_asset const * asset){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_asset_key);
+        if(asset->generator.data){
+                pla_json_write_key(w, "generator");
+                pla_json_write_string(w, asset->generator);
+        }
+        pla_json_write_key(w, "version");
+        pla_json_write_string(w, asset->version);
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_buffer_key(pla_str key){
+        return pla_str_is_equal(key, "uri") || pla_str_is_equal(key, "byteLength");
+}
+
+static inline usize pla_write_buffers(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_buffer const * buffer){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_buffer_key);
+        if(buffer->uri.data){
+                pla_json_write_key(w, "uri");
+                pla_json_write_string(w, buffer->uri);
+        }
+        pla_json_write_key(w, "byteLength");
+        pla_json_write_u32(w, (u32)buffer->byte_length);
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_buffer_view_key(pla_str key){
+        #define X(_, name, __, ___) if(pla_str_is_equal(key, name)) return true;
+        BUFFER_VIEW_COMPONENTS
+        #undef X
+        return false;
+}
+
+static inline usize pla_write_buffer_views(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_buffer_view const * view){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_buffer_view_key);
+        pla_json_write_key(w, "buffer");
+        pla_json_write_u32(w, view->buffer);
+        pla_json_write_key(w, "byteLength");
+        pla_json_write_u32(w, view->byte_length);
+        //the rest are optional and zero when they're missing.
+        if(view->byte_offset){
+                pla_json_write_key(w, "byteOffset");
+                pla_json_write_u32(w, view->byte_offset);
+        }
+        if(view->byte_stride){
+                pla_json_write_key(w, "byteStride");
+                pla_json_write_u32(w, view->byte_stride);
+        }
+        if(view->target){
+                pla_json_write_key(w, "target");
+                pla_json_write_u32(w, view->target);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+//min and max aren't parsed yet so they're copied from the original.
+static inline bool pla_is_written_accessor_key(pla_str key){
+        if(pla_str_is_equal(key, "min") || pla_str_is_equal(key, "max")) return false;
+        #define X(_, name, __, ___) if(pla_str_is_equal(key, name)) return true;
+        ACESSOR_COMPONENTS
+        #undef X
+        return false;
+}
+
+static inline usize pla_write_accessors(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_accessor const * accessor){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_accessor_key);
+        if(accessor->buffer_view != PLA_INDEX_NONE){
+                pla_json_write_key(w, "bufferView");
+                pla_json_write_u32(w, accessor->buffer_view);
+        }
+        if(accessor->byte_offset){
+                pla_json_write_key(w, "byteOffset");
+                pla_json_write_u32(w, accessor->byte_offset);
+        }
+        pla_json_write_key(w, "componentType");
+        pla_json_write_separator(w);
+        pla_json_write_c_str(w, pla_GLTF_component_type_strings[accessor->component_type]);
+        pla_json_write_key(w, "count");
+        pla_json_write_u32(w, accessor->count);
+        if(accessor->normalized){
+                pla_json_write_key(w, "normalized");
+                pla_json_write_separator(w);
+                pla_json_write_c_str(w, "true");
+        }
+        pla_json_write_key(w, "type");
+        pla_json_write_quoted_c_str(w, pla_GLTF_type_strings[accessor->type]);
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_mesh_primitive_attribute_key(pla_str key){
+        pla_mesh_primitive_attribute attribute = {0};
+        return lookup_mesh_primitive_attribute_name(key, &attribute);
+}
+
+static inline bool pla_is_written_mesh_primitive_key(pla_str key){
+        return pla_str_is_equal(key, "attributes") || pla_str_is_equal(key, "targets") || pla_str_is_equal(key, "indices") || pla_str_is_equal(key, "material") || pla_str_is_equal(key, "mode");
+}
+
+//writes the object of attributes that opens after c, merged so custom ones like _BATCHID are kept.
+static inline usize pla_write_mesh_primitive_attributes(pla_json_writer * w, parse_state p, pla_mesh_primitive_attribute const * attributes, u32 attribute_count){
+        pla_json_write_begin(w, '{');
+        usize end = pla_json_copy_unwritten_members(w, p, pla_is_written_mesh_primitive_attribute_key);
+        for(u32 i = 0; i < attribute_count; ++i){
+                pla_mesh_primitive_attribute attribute = attributes[i];
+                pla_json_write_separator(w);
+                pla_json_write_raw(w, "\"", 1);
+                pla_json_write_c_str(w, pla_mesh_primitive_attribute_name_strings[attribute.name]);
+                if(attribute.name >= pla_TEXCOORD){
+                        pla_json_write_raw(w, "_", 1);
+                        w->needs_comma = false;
+                        pla_json_write_u32(w, (u32)attribute.set_index);
+                }
+                pla_json_write_raw(w, "\":", 2);
+                w->needs_comma = false;
+                pla_json_write_u32(w, attribute.accessor);
+        }
+        pla_json_write_end(w, '}');
+        return end;
+}
+
+static inline usize pla_write_mesh_primitive(pla_json_writer * w, parse_state p, pla_mesh_primitive const * primitive){
+        pla_json_write_begin(w, '{');
+        parse_state attributes_p = p;
+        attributes_p.c = pla_json_find_member(p, "attributes");
+        if(attributes_p.c == SIZE_MAX) return SIZE_MAX;
+        pla_json_write_key(w, "attributes");
+        if(pla_write_mesh_primitive_attributes(w, attributes_p, primitive->attributes, primitive->attribute_count) == SIZE_MAX) return SIZE_MAX;
+
+        if(primitive->target_count){
+                parse_state targets_p = p;
+                targets_p.c = pla_json_find_member(p, "targets");
+                if(targets_p.c != SIZE_MAX) targets_p.c = check_next_symbol_is(targets_p, open_square);
+                pla_json_write_key(w, "targets");
+                pla_json_write_begin(w, '[');
+                for(u32 i = 0; i < primitive->target_count; ++i){
+                        targets_p.c = pla_write_mesh_primitive_attributes(w, targets_p, primitive->targets[i].attributes, primitive->targets[i].attribute_count);
+                        if(targets_p.c != SIZE_MAX) targets_p.c = check_next_symbol_is(targets_p, comma | close_square);
+                }
+                pla_json_write_end(w, ']');
+        }
+
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_mesh_primitive_key);
+        if(primitive->indices != PLA_INDEX_NONE){
+                pla_json_write_key(w, "indices");
+                pla_json_write_u32(w, primitive->indices);
+        }
+        if(primitive->material != PLA_INDEX_NONE){
+                pla_json_write_key(w, "material");
+                pla_json_write_u32(w, primitive->material);
+        }
+        if(primitive->mode != 4){
+                pla_json_write_key(w, "mode");
+                pla_json_write_u32(w, primitive->mode);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_mesh_key(pla_str key){
+        return pla_str_is_equal(key, "name") || pla_str_is_equal(key, "primitives") || pla_str_is_equal(key, "weights");
+}
+
+static inline usize pla_write_meshes(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_mesh const * mesh){
+        pla_json_write_begin(w, '{');
+        parse_state primitives_p = p;
+        primitives_p.c = pla_json_find_member(p, "primitives");
+        primitives_p.c = check_next_symbol_is(primitives_p, open_square);
+        if(primitives_p.c == SIZE_MAX) return SIZE_MAX;
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_mesh_key);
+        if(mesh->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, mesh->name);
+        }
+        if(mesh->weight_count) pla_json_write_f32_array(w, "weights", mesh->weights, mesh->weight_count);
+        pla_json_write_key(w, "primitives");
+        pla_json_write_begin(w, '[');
+        for(u32 i = 0; i < mesh->primitive_count; ++i){
+                primitives_p.c = pla_write_mesh_primitive(w, primitives_p, &mesh->primitives[i]);
+                if(primitives_p.c == SIZE_MAX) return SIZE_MAX;
+                primitives_p.c = check_next_symbol_is(primitives_p, comma | close_square);
+                if(primitives_p.c == SIZE_MAX) return SIZE_MAX;
+        }
+        pla_json_write_end(w, ']');
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_scene_key(pla_str key){
+        return pla_str_is_equal(key, "name") || pla_str_is_equal(key, "nodes");
+}
+
+static inline usize pla_write_scenes(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_scene const * scene){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_scene_key);
+        if(scene->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, scene->name);
+        }
+        if(scene->node_count) pla_json_write_u32_array(w, "nodes", scene->nodes, scene->node_count);
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_node_key(pla_str key){
+        c_str const keys[] = {"name", "mesh", "skin", "children", "translation", "rotation", "scale", "matrix"};
+        return pla_str_in(key, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+//nodes that had a matrix get their matrix back, the others their translation, rotation and scale.
+static inline usize pla_write_nodes(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_node const * node){
+        bool has_matrix = pla_json_find_member(p, "matrix") != SIZE_MAX;
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_node_key);
+        if(node->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, node->name);
+        }
+        if(node->mesh != PLA_INDEX_NONE){
+                pla_json_write_key(w, "mesh");
+                pla_json_write_u32(w, node->mesh);
+        }
+        if(node->skin != PLA_INDEX_NONE){
+                pla_json_write_key(w, "skin");
+                pla_json_write_u32(w, node->skin);
+        }
+        if(node->child_count) pla_json_write_u32_array(w, "children", node->children, node->child_count);
+        if(has_matrix) pla_json_write_f32_array(w, "matrix", node->matrix, 16);
+        else{
+                if(!pla_f32s_are(node->translation, 3, 0)) pla_json_write_f32_array(w, "translation", node->translation, 3);
+                if(!pla_f32s_are(node->rotation, 3, 0) || node->rotation[3] != 1) pla_json_write_f32_array(w, "rotation", node->rotation, 4);
+                if(!pla_f32s_are(node->scale, 3, 1)) pla_json_write_f32_array(w, "scale", node->scale, 3);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_skin_key(pla_str key){
+        c_str const keys[] = {"name", "inverseBindMatrices", "skeleton", "joints"};
+        return pla_str_in(key, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+static inline usize pla_write_skins(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_skin const * skin){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_skin_key);
+        if(skin->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, skin->name);
+        }
+        if(skin->inverse_bind_matrices != PLA_INDEX_NONE){
+                pla_json_write_key(w, "inverseBindMatrices");
+                pla_json_write_u32(w, skin->inverse_bind_matrices);
+        }
+        if(skin->skeleton != PLA_INDEX_NONE){
+                pla_json_write_key(w, "skeleton");
+                pla_json_write_u32(w, skin->skeleton);
+        }
+        pla_json_write_u32_array(w, "joints", skin->joints, skin->joint_count);
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_animation_channel_key(pla_str key){
+        return pla_str_is_equal(key, "sampler") || pla_str_is_equal(key, "target");
+}
+
+static inline bool pla_is_written_animation_target_key(pla_str key){
+        return pla_str_is_equal(key, "node") || pla_str_is_equal(key, "path");
+}
+
+//paths from extensions aren't held so theirs is copied.
+static inline bool pla_is_written_animation_target_node_key(pla_str key){
+        return pla_str_is_equal(key, "node");
+}
+
+static inline usize pla_write_animation_channel(pla_json_writer * w, parse_state p, pla_animation_channel const * channel){
+        parse_state target_p = p;
+        target_p.c = pla_json_find_member(p, "target");
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_animation_channel_key);
+        pla_json_write_key(w, "sampler");
+        pla_json_write_u32(w, channel->sampler);
+        pla_json_write_key(w, "target");
+        pla_json_write_begin(w, '{');
+        bool has_path = channel->target_path != pla_animation_path_MAX_ENUM;
+        pla_json_copy_unwritten_members(w, target_p, has_path ? pla_is_written_animation_target_key : pla_is_written_animation_target_node_key);
+        if(channel->target_node != PLA_INDEX_NONE){
+                pla_json_write_key(w, "node");
+                pla_json_write_u32(w, channel->target_node);
+        }
+        if(has_path){
+                pla_json_write_key(w, "path");
+                pla_json_write_quoted_c_str(w, pla_animation_path_strings[channel->target_path]);
+        }
+        pla_json_write_end(w, '}');
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_animation_sampler_key(pla_str key){
+        return pla_str_is_equal(key, "input") || pla_str_is_equal(key, "output") || pla_str_is_equal(key, "interpolation");
+}
+
+static inline usize pla_write_animation_sampler(pla_json_writer * w, parse_state p, pla_animation_sampler const * sampler){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_animation_sampler_key);
+        pla_json_write_key(w, "input");
+        pla_json_write_u32(w, sampler->input);
+        pla_json_write_key(w, "output");
+        pla_json_write_u32(w, sampler->output);
+        if(sampler->interpolation != pla_animation_interpolation_linear){
+                pla_json_write_key(w, "interpolation");
+                pla_json_write_quoted_c_str(w, pla_animation_interpolation_strings[sampler->interpolation]);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_animation_key(pla_str key){
+        return pla_str_is_equal(key, "name") || pla_str_is_equal(key, "channels") || pla_str_is_equal(key, "samplers");
+}
+
+static inline usize pla_write_animations(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_animation const * animation){
+        parse_state channels_p = p;
+        channels_p.c = pla_json_find_member(p, "channels");
+        if(channels_p.c != SIZE_MAX) channels_p.c = check_next_symbol_is(channels_p, open_square);
+        parse_state samplers_p = p;
+        samplers_p.c = pla_json_find_member(p, "samplers");
+        if(samplers_p.c != SIZE_MAX) samplers_p.c = check_next_symbol_is(samplers_p, open_square);
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_animation_key);
+        if(animation->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, animation->name);
+        }
+        pla_json_write_key(w, "channels");
+        pla_json_write_begin(w, '[');
+        for(u32 i = 0; i < animation->channel_count; ++i){
+                channels_p.c = pla_write_animation_channel(w, channels_p, &animation->channels[i]);
+                if(channels_p.c != SIZE_MAX) channels_p.c = check_next_symbol_is(channels_p, comma | close_square);
+        }
+        pla_json_write_end(w, ']');
+        pla_json_write_key(w, "samplers");
+        pla_json_write_begin(w, '[');
+        for(u32 i = 0; i < animation->sampler_count; ++i){
+                samplers_p.c = pla_write_animation_sampler(w, samplers_p, &animation->samplers[i]);
+                if(samplers_p.c != SIZE_MAX) samplers_p.c = check_next_symbol_is(samplers_p, comma | close_square);
+        }
+        pla_json_write_end(w, ']');
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_texture_info_key(pla_str key){
+        c_str const keys[] = {"index", "texCoord", "scale", "strength"};
+        return pla_str_in(key, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+//writes the texture info under key when it has a texture, merged with the one in the object p is at. scale_key is null for infos without one.
+static inline void pla_write_texture_info(pla_json_writer * w, parse_state p, c_str key, c_str scale_key, pla_texture_info const * info){
+        if(info->index == PLA_INDEX_NONE) return;
+        parse_state info_p = p;
+        if(p.c != SIZE_MAX) info_p.c = pla_json_find_member(p, key);
+        pla_json_write_key(w, key);
+        pla_json_write_begin(w, '{');
+        pla_json_copy_unwritten_members(w, info_p, pla_is_written_texture_info_key);
+        pla_json_write_key(w, "index");
+        pla_json_write_u32(w, info->index);
+        if(info->tex_coord){
+                pla_json_write_key(w, "texCoord");
+                pla_json_write_u32(w, info->tex_coord);
+        }
+        if(scale_key && info->scale != 1){
+                pla_json_write_key(w, scale_key);
+                pla_json_write_f32(w, info->scale);
+        }
+        pla_json_write_end(w, '}');
+}
+
+static inline bool pla_is_written_material_pbr_key(pla_str key){
+        c_str const keys[] = {"baseColorFactor", "baseColorTexture", "metallicFactor", "roughnessFactor", "metallicRoughnessTexture"};
+        return pla_str_in(key, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+static inline bool pla_is_written_material_key(pla_str key){
+        c_str const keys[] = {"name", "pbrMetallicRoughness", "normalTexture", "occlusionTexture", "emissiveTexture", "emissiveFactor", "alphaMode", "alphaCutoff", "doubleSided"};
+        return pla_str_in(key, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+//values at their spec defaults are left out.
+static inline usize pla_write_materials(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_material const * material){
+        parse_state material_p = p;
+        parse_state pbr_p = p;
+        pbr_p.c = pla_json_find_member(p, "pbrMetallicRoughness");
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_material_key);
+        if(material->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, material->name);
+        }
+        bool has_pbr = pbr_p.c != SIZE_MAX || !pla_f32s_are(material->base_color_factor, 4, 1) || material->metallic_factor != 1 || material->roughness_factor != 1
+                || material->base_color_texture.index != PLA_INDEX_NONE || material->metallic_roughness_texture.index != PLA_INDEX_NONE;
+        if(has_pbr){
+                pla_json_write_key(w, "pbrMetallicRoughness");
+                pla_json_write_begin(w, '{');
+                pla_json_copy_unwritten_members(w, pbr_p, pla_is_written_material_pbr_key);
+                if(!pla_f32s_are(material->base_color_factor, 4, 1)) pla_json_write_f32_array(w, "baseColorFactor", material->base_color_factor, 4);
+                pla_write_texture_info(w, pbr_p, "baseColorTexture", PLA_NULL, &material->base_color_texture);
+                if(material->metallic_factor != 1){
+                        pla_json_write_key(w, "metallicFactor");
+                        pla_json_write_f32(w, material->metallic_factor);
+                }
+                if(material->roughness_factor != 1){
+                        pla_json_write_key(w, "roughnessFactor");
+                        pla_json_write_f32(w, material->roughness_factor);
+                }
+                pla_write_texture_info(w, pbr_p, "metallicRoughnessTexture", PLA_NULL, &material->metallic_roughness_texture);
+                pla_json_write_end(w, '}');
+        }
+        pla_write_texture_info(w, material_p, "normalTexture", "scale", &material->normal_texture);
+        pla_write_texture_info(w, material_p, "occlusionTexture", "strength", &material->occlusion_texture);
+        pla_write_texture_info(w, material_p, "emissiveTexture", PLA_NULL, &material->emissive_texture);
+        if(!pla_f32s_are(material->emissive_factor, 3, 0)) pla_json_write_f32_array(w, "emissiveFactor", material->emissive_factor, 3);
+        if(material->alpha_mode != pla_alpha_mode_opaque){
+                pla_json_write_key(w, "alphaMode");
+                pla_json_write_quoted_c_str(w, pla_alpha_mode_strings[material->alpha_mode]);
+        }
+        if(material->alpha_cutoff != 0.5f){
+                pla_json_write_key(w, "alphaCutoff");
+                pla_json_write_f32(w, material->alpha_cutoff);
+        }
+        if(material->double_sided){
+                pla_json_write_key(w, "doubleSided");
+                pla_json_write_separator(w);
+                pla_json_write_c_str(w, "true");
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_texture_key(pla_str key){
+        #define X(_, name, __, ___) if(pla_str_is_equal(key, name)) return true;
+        TEXTURE_COMPONENTS
+        #undef X
+        return false;
+}
+
+static inline usize pla_write_textures(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_texture const * texture){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_texture_key);
+        if(texture->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, texture->name);
+        }
+        if(texture->sampler != PLA_INDEX_NONE){
+                pla_json_write_key(w, "sampler");
+                pla_json_write_u32(w, texture->sampler);
+        }
+        if(texture->source != PLA_INDEX_NONE){
+                pla_json_write_key(w, "source");
+                pla_json_write_u32(w, texture->source);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_sampler_key(pla_str key){
+        #define X(_, name, __, ___) if(pla_str_is_equal(key, name)) return true;
+        SAMPLER_COMPONENTS
+        #undef X
+        return false;
+}
+
+static inline usize pla_write_samplers(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_sampler const * sampler){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_sampler_key);
+        if(sampler->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, sampler->name);
+        }
+        //filters are 0 when not given and the wraps default to REPEAT.
+        u32 const values[4] = {sampler->mag_filter, sampler->min_filter, sampler->wrap_s, sampler->wrap_t};
+        c_str const keys[4] = {"magFilter", "minFilter", "wrapS", "wrapT"};
+        u32 const defaults[4] = {0, 0, 10497, 10497};
+        for(u32 i = 0; i < 4; ++i){
+                if(values[i] == defaults[i]) continue;
+                pla_json_write_key(w, keys[i]);
+                pla_json_write_u32(w, values[i]);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+static inline bool pla_is_written_image_key(pla_str key){
+        #define X(_, name, __, ___) if(pla_str_is_equal(key, name)) return true;
+        IMAGE_COMPONENTS
+        #undef X
+        return false;
+}
+
+static inline usize pla_write_images(pla_json_writer * w, parse_state p, pla_GLTF const * gltf, pla_image const * image){
+        pla_json_write_begin(w, '{');
+        p.c = pla_json_copy_unwritten_members(w, p, pla_is_written_image_key);
+        if(image->name.data){
+                pla_json_write_key(w, "name");
+                pla_json_write_string(w, image->name);
+        }
+        if(image->uri.data){
+                pla_json_write_key(w, "uri");
+                pla_json_write_string(w, image->uri);
+        }
+        if(image->mime_type.data){
+                pla_json_write_key(w, "mimeType");
+                pla_json_write_string(w, image->mime_type);
+        }
+        if(image->buffer_view != PLA_INDEX_NONE){
+                pla_json_write_key(w, "bufferView");
+                pla_json_write_u32(w, image->buffer_view);
+        }
+        pla_json_write_end(w, '}');
+        return p.c;
+}
+
+//Root arrays that are written from the structs, anything else in the root is copied.
+#define WRITTEN_ROOT_ARRAYS \
+        X("scenes", scenes)\
+        X("nodes", nodes)\
+        X("meshes", meshes)\
+        X("accessors", accessors)\
+        X("bufferViews", buffer_views)\
+        X("buffers", buffers)\
+        X("skins", skins)\
+        X("animations", animations)\
+        X("materials", materials)\
+        X("textures", textures)\
+        X("images", images)\
+        X("samplers", samplers)
+
+//Writes the json of a parsed document, with a null w->data it only measures.
+inline bool pla_write_GLTF_json(pla_GLTF const * gltf, pla_json_writer * w){
+        if(!gltf->json || gltf->json_size == 0) return false;
+        u32 tape_cursor = 0;
+        parse_state p = {.c = 0, .size = gltf->json_size, .data = gltf->json, .tape = gltf->tape.entries ? &gltf->tape : PLA_NULL, .tape_cursor = &tape_cursor};
+        if(c_byte(p) != '{') return false;
+        u32 root_comp_count = 0;
+        if(count_items_in_array_or_object_at(p, &root_comp_count) == SIZE_MAX) return false;
+
+        pla_json_write_begin(w, '{');
+        for(u32 root_object_index = 0; root_object_index < root_comp_count; ++root_object_index){
+                pla_str key = {0};
+                p.c = try_parse_string(p, &key);
+                if(p.c == SIZE_MAX) return false;
+                usize member_begin = (usize)(key.data - 1 - p.data);
+                parse_state value_p = p;
+                value_p.c = check_next_symbol_is(p, colon);
+                p.c = try_skip_value(p);
+                if(p.c == SIZE_MAX || value_p.c == SIZE_MAX) return false;
+
+                if(pla_str_is_equal(key, "asset")){
+                        pla_json_write_key(w, "asset");
+                        if(pla_write_asset(w, value_p, &gltf->asset) == SIZE_MAX) return false;
+                }else if(pla_str_is_equal(key, "scene")){
+                        pla_json_write_key(w, "scene");
+                        pla_json_write_u32(w, gltf->scene);
+                }
+                #define X(name, prop) \
+                else if(pla_str_is_equal(key, name)){ \
+                        pla_json_write_key(w, name); \
+                        pla_json_write_begin(w, '['); \
+                        value_p.c = check_next_symbol_is(value_p, open_square); \
+                        for(u32 i = 0; i < gltf->prop##_size; ++i){ \
+                                value_p.c = pla_write_##prop(w, value_p, gltf, &gltf->prop[i]); \
+                                if(value_p.c == SIZE_MAX) return false; \
+                                value_p.c = check_next_symbol_is(value_p, comma | close_square); \
+                        } \
+                        pla_json_write_end(w, ']'); \
+                }
+                WRITTEN_ROOT_ARRAYS
+                #undef X
+                else{
+                        pla_json_write_separator(w);
+                        pla_json_write_raw(w, p.data + member_begin, p.c + 1 - member_begin);
+                }
+                p.c = check_next_symbol_is(p, comma | close_squirle);
+                if(p.c == SIZE_MAX) return false;
+        }
+        pla_json_write_end(w, '}');
+        return !w->failed;
+}
+
+//Same layout as struct iovec so the slices can be handed straight to writev.
+typedef struct pla_write_slice{
+        void const * data;
+        usize size;
+} pla_write_slice;
+
+typedef struct pla_writer{
+        void * user_data;
+        //writes all of the slices in order, returns false on failure.
+        bool (*write)(void * user_data, pla_write_slice const * slices, u32 slice_count);
+} pla_writer;
+
+typedef struct pla_memory_writer{
+        u8 * data;
+        usize size;
+        usize capacity;
+} pla_memory_writer;
+
+//pla_writer callback that appends to a pla_memory_writer.
+static inline bool pla_write_to_memory(void * user_data, pla_write_slice const * slices, u32 slice_count){
+        pla_memory_writer * memory = (pla_memory_writer *)user_data;
+        for(u32 i = 0; i < slice_count; ++i){
+                if(memory->size + slices[i].size > memory->capacity) return false;
+                memcpy(memory->data + memory->size, slices[i].data, slices[i].size);
+                memory->size += slices[i].size;
+        }
+        return true;
+}
+
+//Its expected that you call this twice, once with a null json buffer to get its size, then again with a buffer that size.
+//The bin chunk is never copied, its handed to the writer as its own slice.
+inline bool pla_write_GLB(pla_GLTF const * gltf, usize * json_buffer_size, u8 * json_buffer, pla_writer const * writer){
+        if(!gltf || !json_buffer_size) return false;
+        pla_json_writer w = {0};
+        if(!json_buffer){
+                if(!pla_write_GLTF_json(gltf, &w)) return false;
+                *json_buffer_size = get_aligned_size_to(w.size, 4);
+                return true;
+        }
+        if(!writer || !writer->write) return false;
+        w.data = json_buffer;
+        w.capacity = *json_buffer_size;
+        if(!pla_write_GLTF_json(gltf, &w)) return false;
+        if(get_aligned_size_to(w.size, 4) != *json_buffer_size) return false;
+        memset(json_buffer + w.size, ' ', *json_buffer_size - w.size);
+
+        bool has_bin = gltf->bin && gltf->bin_size;
+        u32 bin_size = (u32)get_aligned_size_to(gltf->bin_size, 4);
+        u64 total_size = 12 + 8 + *json_buffer_size + (has_bin ? 8 + bin_size : 0);
+        if(total_size > UINT32_MAX) return false;
+
+        u32 header[5] = {glTF, 2, (u32)total_size, (u32)*json_buffer_size, JSON};
+        u32 bin_header[2] = {bin_size, BIN};
+        u8 const padding[4] = {0};
+        pla_write_slice slices[5] = {
+                {header, sizeof(header)},
+                {json_buffer, *json_buffer_size},
+                {bin_header, sizeof(bin_header)},
+                {gltf->bin, gltf->bin_size},
+                {padding, bin_size - gltf->bin_size},
+        };
+        u32 slice_count = has_bin ? (bin_size != gltf->bin_size ? 5 : 4) : 2;
+        return writer->write(writer->user_data, slices, slice_count);
+}
+
+//Lets the caller run independent jobs on their own threads, with a null job system everything runs on the calling thread.
+typedef struct pla_job_system{
+        void * user_data;
+        //has to call job(job_data, i) for every i in [0, count) and only return once they've all finished.
+        void (*parallel_for)(void * user_data, u32 count, void (*job)(void * job_data, u32 index), void * job_data);
+} pla_job_system;
+
+static inline void pla_parallel_for(pla_job_system const * jobs, u32 count, void (*job)(void * job_data, u32 index), void * job_data){
+        if(jobs && jobs->parallel_for) jobs->parallel_for(jobs->user_data, count, job, job_data);
+        else for(u32 i = 0; i < count; ++i) job(job_data, i);
+}
+
+//Where external buffers come from, uris are passed as they are in the json (relative and percent encoded).
+typedef struct pla_file_system{
+        void * user_data;
+        //the data has to stay valid until close is called with it.
+        bool (*open)(void * user_data, pla_str uri, u8 const ** out_data, usize * out_size, void ** out_handle);
+        void (*close)(void * user_data, void * handle, u8 const * data, usize size);
+} pla_file_system;
+
+//0x80 marks bytes that aren't base64, both the standard and url alphabets are accepted.
+u8 const pla_base64_values[256] = {
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3e, 0x80, 0x3e, 0x80, 0x3f,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+        0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x3f,
+        0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+//Decodes 4 characters at a time without branching on the characters, bad characters are collected and checked once at the end.
+static inline bool pla_base64_decode(pla_str in, u8 * out, usize out_size, usize * out_length){
+        usize length = in.length;
+        while(length && in.data[length - 1] == '=') --length;
+        usize decoded_length = length / 4 * 3 + (length % 4 ? length % 4 - 1 : 0);
+        if(length % 4 == 1 || decoded_length > out_size) return false;
+
+        u8 invalid = 0;
+        usize quad_count = length / 4;
+        for(usize i = 0; i < quad_count; ++i){
+                u8 const * chars = in.data + i * 4;
+                u32 a = pla_base64_values[chars[0]];
+                u32 b = pla_base64_values[chars[1]];
+                u32 c = pla_base64_values[chars[2]];
+                u32 d = pla_base64_values[chars[3]];
+                invalid |= a | b | c | d;
+                u32 bits = a << 18 | b << 12 | c << 6 | d;
+                out[i * 3 + 0] = (u8)(bits >> 16);
+                out[i * 3 + 1] = (u8)(bits >> 8);
+                out[i * 3 + 2] = (u8)bits;
+        }
+        usize tail = length % 4;
+        if(tail){
+                u8 const * chars = in.data + quad_count * 4;
+                u32 bits = 0;
+                for(usize i = 0; i < tail; ++i){
+                        u32 value = pla_base64_values[chars[i]];
+                        invalid |= value;
+                        bits |= value << (18 - 6 * i);
+                }
+                out[quad_count * 3] = (u8)(bits >> 16);
+                if(tail == 3) out[quad_count * 3 + 1] = (u8)(bits >> 8);
+        }
+        if(invalid & 0x80) return false;
+        *out_length = decoded_length;
+        return true;
+}
+
+//Bytes of memory pla_resolve_buffers needs to decode the buffers that are embedded as data uris.
+inline usize pla_get_buffer_memory_size(pla_GLTF const * gltf){
+        usize size = 0;
+        for(u32 i = 0; i < gltf->buffers_size; ++i){
+                if(pla_uri_is_data(gltf->buffers[i].uri)) size += get_aligned_size(gltf->buffers[i].byte_length);
+        }
+        return size;
+}
+
+typedef struct{
+        pla_GLTF * gltf;
+        pla_file_system const * file_system;
+} pla_resolve_buffers_job;
+
+static inline void pla_resolve_buffer(void * job_data, u32 index){
+        pla_resolve_buffers_job * job = (pla_resolve_buffers_job *)job_data;
+        pla_buffer * buffer = &job->gltf->buffers[index];
+        if(!buffer->uri.data) return;
+        if(pla_uri_is_data(buffer->uri)){
+                //the destination was handed out before the jobs started.
+                u8 * destination = (u8 *)buffer->data;
+                usize length = 0;
+                buffer->data = PLA_NULL;
+                if(!pla_base64_decode(pla_data_uri_payload(buffer->uri), destination, buffer->byte_length, &length) || length < buffer->byte_length) return;
+                buffer->data = destination;
+                return;
+        }
+        pla_file_system const * file_system = job->file_system;
+        if(!file_system || !file_system->open) return;
+        u8 const * data = PLA_NULL;
+        usize size = 0;
+        void * handle = PLA_NULL;
+        if(!file_system->open(file_system->user_data, buffer->uri, &data, &size, &handle)) return;
+        if(size < buffer->byte_length){
+                if(file_system->close) file_system->close(file_system->user_data, handle, data, size);
+                return;
+        }
+        buffer->file_handle = handle;
+        buffer->file_size = size;
+        buffer->data = data;
+}
+
+//Loads every buffer that isn't the glb bin chunk, external files come from the file system and data uris are decoded in to memory.
+//Each buffer is its own job so a job system backed by a thread pool overlaps the file reads with the decoding.
+//memory has to be at least pla_get_buffer_memory_size bytes, it can be null if there are no data uris.
+inline bool pla_resolve_buffers(pla_GLTF * gltf, pla_file_system const * file_system, pla_job_system const * jobs, usize memory_size, u8 * memory){
+        if(!gltf) return false;
+        if(pla_get_buffer_memory_size(gltf) > memory_size) return false;
+        usize offset = 0;
+        for(u32 i = 0; i < gltf->buffers_size; ++i){
+                pla_buffer * buffer = &gltf->buffers[i];
+                if(!pla_uri_is_data(buffer->uri)) continue;
+                buffer->data = memory + offset;
+                offset += get_aligned_size(buffer->byte_length);
+        }
+        pla_resolve_buffers_job job = {gltf, file_system};
+        pla_parallel_for(jobs, gltf->buffers_size, pla_resolve_buffer, &job);
+        //buffers without a uri that aren't the bin chunk are compression fallbacks and have no data.
+        for(u32 i = 0; i < gltf->buffers_size; ++i) if(gltf->buffers[i].uri.data && !gltf->buffers[i].data) return false;
+        return true;
+}
+
+//Closes the files pla_resolve_buffers opened.
+inline void pla_release_buffers(pla_GLTF * gltf, pla_file_system const * file_system){
+        for(u32 i = 0; i < gltf->buffers_size; ++i){
+                pla_buffer * buffer = &gltf->buffers[i];
+                if(!buffer->uri.data || pla_uri_is_data(buffer->uri)) continue;
+                if(buffer->data && file_system && file_system->close) file_system->close(file_system->user_data, buffer->file_handle, buffer->data, buffer->file_size);
+                buffer->data = PLA_NULL;
+                buffer->file_handle = PLA_NULL;
+        }
+}
+
+#ifdef PLA_USE_POSIX
+//Page placement.
+//Big bin chunks and arenas are walked by memory bound loops, huge pages cut the tlb misses and putting memory on the numa node of the thread that works on it keeps the reads off the socket interconnect.
+//the numa and huge page calls are linux only, elsewhere the memory is plain pages.
+
+typedef enum pla_huge_pages{
+        pla_huge_pages_none,
+        //2MB aligned memory with madvise(MADV_HUGEPAGE), backed with huge pages when the kernel has them.
+        pla_huge_pages_transparent,
+        //MAP_HUGETLB from the reserved pool (vm.nr_hugepages), transparent when the pool is empty.
+        pla_huge_pages_explicit,
+        pla_huge_pages_MAX_ENUM,
+} pla_huge_pages;
+
+char const * const pla_huge_pages_strings[pla_huge_pages_MAX_ENUM] = {"none", "transparent", "explicit"};
+
+#define PLA_HUGE_PAGE_SIZE (2u << 20)
+//the kernel puts pages where they're first touched.
+#define PLA_NUMA_ANY UINT32_MAX
+//the node of the thread that maps the memory.
+#define PLA_NUMA_LOCAL (UINT32_MAX - 1)
+
+typedef struct pla_page_placement{
+        pla_huge_pages huge_pages;
+        //a node below 64, PLA_NUMA_ANY or PLA_NUMA_LOCAL.
+        u32 numa_node;
+} pla_page_placement;
+
+//The numa node of the cpu the calling thread is on, 0 where that isn't known.
+inline u32 pla_get_current_numa_node(void) NOEXCEPT{
+#if defined(__linux__) && defined(SYS_getcpu)
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if(syscall(SYS_getcpu, &cpu, &node, PLA_NULL) == 0) return node;
+#endif
+        return 0;
+}
+
+//Bytes a mapping of size takes, what pla_unmap_pages is given back.
+inline usize pla_get_page_mapping_size(pla_page_placement const * placement, usize size) NOEXCEPT{
+        usize page_size = placement && placement->huge_pages != pla_huge_pages_none ? PLA_HUGE_PAGE_SIZE : (usize)sysconf(_SC_PAGESIZE);
+        return get_aligned_size_to(size ? size : 1, page_size);
+}
+
+//Maps alignment aligned anonymous memory by mapping more and trimming the ends.
+static inline u8 * pla_map_aligned(usize size, usize alignment){
+        usize length = size + alignment;
+        void * mapping = mmap(PLA_NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(mapping == MAP_FAILED) return PLA_NULL;
+        u8 * begin = (u8 *)mapping;
+        u8 * start = (u8 *)get_aligned_size_to((usize)begin, alignment);
+        if(start > begin) munmap(begin, (usize)(start - begin));
+        usize tail = (usize)(begin + length - (start + size));
+        if(tail) munmap(start + size, tail);
+        return start;
+}
+
+//Anonymous memory placed as placement says, null placement is plain pages. pages are untouched so the numa policy decides where they go.
+inline void * pla_map_pages(pla_page_placement const * placement, usize size) NOEXCEPT{
+        usize length = pla_get_page_mapping_size(placement, size);
+        pla_huge_pages huge_pages = placement ? placement->huge_pages : pla_huge_pages_none;
+        u8 * pages = PLA_NULL;
+#if defined(MAP_HUGETLB)
+        if(huge_pages == pla_huge_pages_explicit){
+                void * mapping = mmap(PLA_NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if(mapping != MAP_FAILED) pages = (u8 *)mapping;
+        }
+#endif
+        if(!pages && huge_pages != pla_huge_pages_none){
+                pages = pla_map_aligned(length, PLA_HUGE_PAGE_SIZE);
+                if(!pages) return PLA_NULL;
+#if defined(MADV_HUGEPAGE)
+                madvise(pages, length, MADV_HUGEPAGE);
+#endif
+        }
+        if(!pages){
+                void * mapping = mmap(PLA_NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if(mapping == MAP_FAILED) return PLA_NULL;
+                pages = (u8 *)mapping;
+        }
+#if defined(__linux__) && defined(SYS_mbind)
+        u32 node = placement ? placement->numa_node : PLA_NUMA_ANY;
+        if(node == PLA_NUMA_LOCAL) node = pla_get_current_numa_node();
+        if(node < 64){
+                //MPOL_PREFERRED, the pages go elsewhere when the node is full instead of failing.
+                unsigned long mask = 1ul << node;
+                syscall(SYS_mbind, pages, length, 1, &mask, 65ul, 0u);
+        }
+#endif
+        return pages;
+}
+
+inline void pla_unmap_pages(pla_page_placement const * placement, void * pages, usize size) NOEXCEPT{
+        if(pages) munmap(pages, pla_get_page_mapping_size(placement, size));
+}
+
+static inline void * pla_page_allocate(void * user_data, usize size){
+        return pla_map_pages((pla_page_placement const *)user_data, size);
+}
+
+static inline void pla_page_free(void * user_data, void * pointer, usize size){
+        pla_unmap_pages((pla_page_placement const *)user_data, pointer, size);
+}
+
+//Allocator that maps every allocation as placement says, placement has to outlive it. its only freed with a size, through free_sized.
+//as the backing of a pla_linear_allocator give it a region_alignment of PLA_HUGE_PAGE_SIZE so regions are whole huge pages.
+inline pla_allocator pla_get_page_allocator(pla_page_placement const * placement) NOEXCEPT{
+        pla_allocator allocator = {(void *)placement, pla_page_allocate, PLA_NULL, pla_page_free};
+        return allocator;
+}
+
+//File system that maps files relative to a directory.
+//uris that are absolute paths or have a .. segment are refused so a file can only name files under directory, symlinks in there are still followed.
+//with a placement files are read in to memory placed like it instead of being mapped, file mappings only get small pages and land wherever the page cache put them.
+typedef struct pla_posix_file_system{
+        c_str directory;
+        pla_page_placement const * placement;
+} pla_posix_file_system;
+
+static inline u8 pla_hex_value(u8 c){
+        if(c >= '0' && c <= '9') return c - '0';
+        if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return 0xff;
+}
+
+//true if the decoded uri starts with a / or has a .. segment.
+static inline bool pla_path_leaves_directory(char const * path, usize length){
+        if(length && path[0] == '/') return true;
+        for(usize begin = 0; begin < length;){
+                usize end = begin;
+                while(end < length && path[end] != '/') ++end;
+                if(end - begin == 2 && path[begin] == '.' && path[begin + 1] == '.') return true;
+                begin = end + 1;
+        }
+        return false;
+}
+
+static inline bool pla_posix_open(void * user_data, pla_str uri, u8 const ** out_data, usize * out_size, void ** out_handle){
+        pla_posix_file_system * file_system = (pla_posix_file_system *)user_data;
+        char path[4096];
+        usize length = strlen(file_system->directory);
+        if(length + 1 + uri.length + 1 > sizeof(path)) return false;
+        memcpy(path, file_system->directory, length);
+        if(length) path[length++] = '/';
+        usize uri_begin = length;
+        for(usize i = 0; i < uri.length; ++i){
+                u8 c = uri.data[i];
+                if(c == '%' && i + 2 < uri.length && pla_hex_value(uri.data[i + 1]) != 0xff && pla_hex_value(uri.data[i + 2]) != 0xff){
+                        c = (u8)(pla_hex_value(uri.data[i + 1]) << 4 | pla_hex_value(uri.data[i + 2]));
+                        i += 2;
+                }
+                //a %00 would cut the path short.
+                if(c == '\0') return false;
+                path[length++] = (char)c;
+        }
+        path[length] = '\0';
+        if(pla_path_leaves_directory(path + uri_begin, length - uri_begin)) return false;
+
+        int file = open(path, O_RDONLY);
+        if(file < 0) return false;
+        struct stat info;
+        if(fstat(file, &info) != 0 || info.st_size == 0){
+                close(file);
+                return false;
+        }
+        usize size = (usize)info.st_size;
+        if(file_system->placement){
+                //the handle is the placement the pages were mapped with.
+                u8 * pages = (u8 *)pla_map_pages(file_system->placement, size);
+                usize done = 0;
+                while(pages && done < size){
+                        ssize_t read = pread(file, pages + done, size - done, (off_t)done);
+                        if(read <= 0) break;
+                        done += (usize)read;
+                }
+                close(file);
+                if(done < size){
+                        pla_unmap_pages(file_system->placement, pages, size);
+                        return false;
+                }
+                *out_data = pages;
+                *out_size = size;
+                *out_handle = (void *)file_system->placement;
+                return true;
+        }
+        void * data = mmap(PLA_NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(data == MAP_FAILED) return false;
+        *out_data = (u8 const *)data;
+        *out_size = size;
+        *out_handle = PLA_NULL;
+        return true;
+}
+
+static inline void pla_posix_close(void * user_data, void * handle, u8 const * data, usize size){
+        if(handle) pla_unmap_pages((pla_page_placement const *)handle, (void *)data, size);
+        else munmap((void *)data, size);
+}
+
+static inline pla_file_system pla_get_posix_file_system(pla_posix_file_system * posix){
+        pla_file_system file_system = {posix, pla_posix_open, pla_posix_close};
+        return file_system;
+}
+#endif
+
+//EXT_meshopt_compression decoding.
+//The codecs follow the meshoptimizer bitstream (vertex codec version 0, index codecs version 0 and 1).
+
+#define PLA_MESHOPT_BYTE_GROUP_SIZE 16
+#define PLA_MESHOPT_BYTE_GROUP_DECODE_LIMIT 24
+#define PLA_MESHOPT_VERTEX_BLOCK_SIZE_BYTES 8192
+#define PLA_MESHOPT_VERTEX_BLOCK_MAX_SIZE 256
+#define PLA_MESHOPT_TAIL_MAX_SIZE 32
+
+//Unpacks 16 deltas stored with 0, 2, 4 or 8 bits each, values that don't fit are stored after the packed bits.
+//The selects instead of branches keep this a straight line of loads and stores.
+static inline u8 const * pla_meshopt_decode_bytes_group(u8 const * data, u8 * out, u32 bitslog2){
+        switch(bitslog2){
+                case 0:
+                        memset(out, 0, PLA_MESHOPT_BYTE_GROUP_SIZE);
+                        return data;
+                case 1:
+                case 2: {
+                        u32 bits = 1u << bitslog2;
+                        u32 sentinel = (1u << bits) - 1;
+                        u32 per_byte = 8 / bits;
+                        u8 const * extra = data + PLA_MESHOPT_BYTE_GROUP_SIZE / per_byte;
+                        for(u32 i = 0; i < PLA_MESHOPT_BYTE_GROUP_SIZE / per_byte; ++i){
+                                u8 byte = data[i];
+                                for(u32 j = 0; j < per_byte; ++j){
+                                        u8 value = (u8)(byte >> (8 - bits));
+                                        byte = (u8)(byte << bits);
+                                        bool is_extra = value == sentinel;
+                                        *out++ = is_extra ? *extra : value;
+                                        extra += is_extra;
+                                }
+                        }
+                        return extra;
+                }
+                default:
+                        memcpy(out, data, PLA_MESHOPT_BYTE_GROUP_SIZE);
+                        return data + PLA_MESHOPT_BYTE_GROUP_SIZE;
+        }
+}
+
+static inline u8 const * pla_meshopt_decode_bytes(u8 const * data, u8 const * data_end, u8 * out, usize out_size){
+        u8 const * header = data;
+        usize header_size = (out_size / PLA_MESHOPT_BYTE_GROUP_SIZE + 3) / 4;
+        if((usize)(data_end - data) < header_size) return PLA_NULL;
+        data += header_size;
+        for(usize i = 0; i < out_size; i += PLA_MESHOPT_BYTE_GROUP_SIZE){
+                //a group never reads more than this, so the groups themselves don't need checks.
+                if((usize)(data_end - data) < PLA_MESHOPT_BYTE_GROUP_DECODE_LIMIT) return PLA_NULL;
+                usize group = i / PLA_MESHOPT_BYTE_GROUP_SIZE;
+                u32 bitslog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+                data = pla_meshopt_decode_bytes_group(data, out + i, bitslog2);
+        }
+        return data;
+}
+
+static inline u8 const * pla_meshopt_decode_vertex_block(u8 const * data, u8 const * data_end, u8 * out, usize vertex_count, usize vertex_size, u8 * last_vertex){
+        u8 deltas[PLA_MESHOPT_VERTEX_BLOCK_MAX_SIZE];
+        usize aligned_count = get_aligned_size_to(vertex_count, PLA_MESHOPT_BYTE_GROUP_SIZE);
+        for(usize k = 0; k < vertex_size; ++k){
+                data = pla_meshopt_decode_bytes(data, data_end, deltas, aligned_count);
+                if(!data) return PLA_NULL;
+                u8 previous = last_vertex[k];
+                for(usize i = 0; i < vertex_count; ++i){
+                        u8 delta = deltas[i];
+                        u8 value = (u8)((-(s32)(delta & 1) ^ (delta >> 1)) + previous);
+                        out[i * vertex_size + k] = value;
+                        previous = value;
+                }
+        }
+        memcpy(last_vertex, out + vertex_size * (vertex_count - 1), vertex_size);
+        return data;
+}
+
+//Each byte of the vertex is stored as its own stream of zigzag deltas, in blocks of up to 256 vertices.
+static inline bool pla_meshopt_decode_vertex_buffer(u8 * out, usize vertex_count, usize vertex_size, u8 const * data, usize data_size){
+        if(vertex_size == 0 || vertex_size > 256 || vertex_size % 4 != 0) return false;
+        u8 const * data_end = data + data_size;
+        if(data_size < 1 + vertex_size) return false;
+        u8 header = *data++;
+        if((header & 0xf0) != 0xa0 || (header & 0x0f) > 0) return false;
+
+        u8 last_vertex[256];
+        memcpy(last_vertex, data_end - vertex_size, vertex_size);
+        usize block_size = PLA_MESHOPT_VERTEX_BLOCK_SIZE_BYTES / vertex_size;
+        block_size &= ~(usize)(PLA_MESHOPT_BYTE_GROUP_SIZE - 1);
+        block_size = block_size < PLA_MESHOPT_VERTEX_BLOCK_MAX_SIZE ? block_size : PLA_MESHOPT_VERTEX_BLOCK_MAX_SIZE;
+
+        for(usize offset = 0; offset < vertex_count; offset += block_size){
+                usize count = offset + block_size < vertex_count ? block_size : vertex_count - offset;
+                data = pla_meshopt_decode_vertex_block(data, data_end, out + offset * vertex_size, count, vertex_size, last_vertex);
+                if(!data) return false;
+        }
+        usize tail_size = vertex_size < PLA_MESHOPT_TAIL_MAX_SIZE ? PLA_MESHOPT_TAIL_MAX_SIZE : vertex_size;
+        return (usize)(data_end - data) == tail_size;
+}
+
+static inline u32 pla_meshopt_decode_vbyte(u8 const ** data){
+        u8 lead = *(*data)++;
+        if(lead < 128) return lead;
+        u32 result = lead & 127;
+        u32 shift = 7;
+        for(u32 i = 0; i < 4; ++i){
+                u8 group = *(*data)++;
+                result |= (u32)(group & 127) << shift;
+                shift += 7;
+                if(group < 128) break;
+        }
+        return result;
+}
+
+static inline u32 pla_meshopt_decode_index(u8 const ** data, u32 last){
+        u32 value = pla_meshopt_decode_vbyte(data);
+        return last + ((value >> 1) ^ (u32)-(s32)(value & 1));
+}
+
+static inline void pla_meshopt_write_triangle(u8 * out, usize i, usize index_size, u32 a, u32 b, u32 c){
+        if(index_size == 2){
+                u16 triangle[3] = {(u16)a, (u16)b, (u16)c};
+                memcpy(out + i * 2, triangle, sizeof(triangle));
+        }else{
+                u32 triangle[3] = {a, b, c};
+                memcpy(out + i * 4, triangle, sizeof(triangle));
+        }
+}
+
+#define pla_meshopt_push_vertex(v, condition) vertex_fifo[vertex_fifo_offset] = (v); vertex_fifo_offset = (vertex_fifo_offset + (condition)) & 15;
+#define pla_meshopt_push_edge(a, b) edge_fifo[edge_fifo_offset][0] = (a); edge_fifo[edge_fifo_offset][1] = (b); edge_fifo_offset = (edge_fifo_offset + 1) & 15;
+
+//Triangles are coded against a fifo of recent edges and vertices, one code byte per triangle.
+static inline bool pla_meshopt_decode_index_buffer(u8 * out, usize index_count, usize index_size, u8 const * data, usize data_size){
+        if(index_count % 3 != 0 || (index_size != 2 && index_size != 4)) return false;
+        if(data_size < 1 + index_count / 3 + 16) return false;
+        if((data[0] & 0xf0) != 0xe0) return false;
+        u32 version = data[0] & 0x0f;
+        if(version > 1) return false;
+
+        u32 edge_fifo[16][2];
+        u32 vertex_fifo[16];
+        memset(edge_fifo, -1, sizeof(edge_fifo));
+        memset(vertex_fifo, -1, sizeof(vertex_fifo));
+        usize edge_fifo_offset = 0;
+        usize vertex_fifo_offset = 0;
+        u32 next = 0;
+        u32 last = 0;
+        u32 fec_max = version >= 1 ? 13 : 15;
+
+        u8 const * code = data + 1;
+        u8 const * cursor = code + index_count / 3;
+        u8 const * safe_end = data + data_size - 16;
+        u8 const * codeaux_table = safe_end;
+
+        for(usize i = 0; i < index_count; i += 3){
+                //a triangle reads at most 16 bytes, which is what the codeaux table leaves as slack.
+                if(cursor > safe_end) return false;
+                u8 codetri = *code++;
+                if(codetri < 0xf0){
+                        u32 fe = codetri >> 4;
+                        u32 a = edge_fifo[(edge_fifo_offset - 1 - fe) & 15][0];
+                        u32 b = edge_fifo[(edge_fifo_offset - 1 - fe) & 15][1];
+                        u32 fec = codetri & 15;
+                        if(fec < fec_max){
+                                u32 cf = vertex_fifo[(vertex_fifo_offset - 1 - fec) & 15];
+                                u32 c = fec == 0 ? next : cf;
+                                u32 fec0 = fec == 0;
+                                next += fec0;
+                                pla_meshopt_write_triangle(out, i, index_size, a, b, c);
+                                pla_meshopt_push_vertex(c, fec0)
+                                pla_meshopt_push_edge(c, b)
+                                pla_meshopt_push_edge(a, c)
+                        }else{
+                                //13 and 14 are -1 and +1 from the last free index.
+                                u32 c = fec != 15 ? last + (fec - (fec ^ 3)) : pla_meshopt_decode_index(&cursor, last);
+                                last = c;
+                                pla_meshopt_write_triangle(out, i, index_size, a, b, c);
+                                pla_meshopt_push_vertex(c, 1)
+                                pla_meshopt_push_edge(c, b)
+                                pla_meshopt_push_edge(a, c)
+                        }
+                }else if(codetri < 0xfe){
+                        u8 codeaux = codeaux_table[codetri & 15];
+                        u32 feb = codeaux >> 4;
+                        u32 fec = codeaux & 15;
+                        u32 a = next++;
+                        u32 bf = vertex_fifo[(vertex_fifo_offset - feb) & 15];
+                        u32 b = feb == 0 ? next : bf;
+                        u32 feb0 = feb == 0;
+                        next += feb0;
+                        u32 cf = vertex_fifo[(vertex_fifo_offset - fec) & 15];
+                        u32 c = fec == 0 ? next : cf;
+                        u32 fec0 = fec == 0;
+                        next += fec0;
+                        pla_meshopt_write_triangle(out, i, index_size, a, b, c);
+                        pla_meshopt_push_vertex(a, 1)
+                        pla_meshopt_push_vertex(b, feb0)
+                        pla_meshopt_push_vertex(c, fec0)
+                        pla_meshopt_push_edge(b, a)
+                        pla_meshopt_push_edge(c, b)
+                        pla_meshopt_push_edge(a, c)
+                }else{
+                        u8 codeaux = *cursor++;
+                        u32 fea = codetri == 0xfe ? 0 : 15;
+                        u32 feb = codeaux >> 4;
+                        u32 fec = codeaux & 15;
+                        if(codeaux == 0) next = 0;
+                        u32 a = fea == 0 ? next++ : 0;
+                        u32 b = feb == 0 ? next++ : vertex_fifo[(vertex_fifo_offset - feb) & 15];
+                        u32 c = fec == 0 ? next++ : vertex_fifo[(vertex_fifo_offset - fec) & 15];
+                        if(fea == 15) last = a = pla_meshopt_decode_index(&cursor, last);
+                        if(feb == 15) last = b = pla_meshopt_decode_index(&cursor, last);
+                        if(fec == 15) last = c = pla_meshopt_decode_index(&cursor, last);
+                        pla_meshopt_write_triangle(out, i, index_size, a, b, c);
+                        pla_meshopt_push_vertex(a, 1)
+                        pla_meshopt_push_vertex(b, (feb == 0) | (feb == 15))
+                        pla_meshopt_push_vertex(c, (fec == 0) | (fec == 15))
+                        pla_meshopt_push_edge(b, a)
+                        pla_meshopt_push_edge(c, b)
+                        pla_meshopt_push_edge(a, c)
+                }
+        }
+        return cursor == safe_end;
+}
+
+#undef pla_meshopt_push_vertex
+#undef pla_meshopt_push_edge
+
+//Indices that aren't triangles, each one is a zigzag delta from one of two previous indices.
+static inline bool pla_meshopt_decode_index_sequence(u8 * out, usize index_count, usize index_size, u8 const * data, usize data_size){
+        if(index_size != 2 && index_size != 4) return false;
+        if(data_size < 1 + index_count + 4) return false;
+        if((data[0] & 0xf0) != 0xd0 || (data[0] & 0x0f) > 1) return false;
+        u8 const * cursor = data + 1;
+        u8 const * safe_end = data + data_size - 4;
+        u32 last[2] = {0, 0};
+        for(usize i = 0; i < index_count; ++i){
+                if(cursor >= safe_end) return false;
+                u32 value = pla_meshopt_decode_vbyte(&cursor);
+                u32 baseline = value & 1;
+                value >>= 1;
+                u32 index = last[baseline] + ((value >> 1) ^ (u32)-(s32)(value & 1));
+                last[baseline] = index;
+                if(index_size == 2){
+                        u16 index16 = (u16)index;
+                        memcpy(out + i * 2, &index16, 2);
+                }else memcpy(out + i * 4, &index, 4);
+        }
+        return cursor == safe_end;
+}
+
+#define pla_meshopt_round(value) (s32)((value) + ((value) >= 0.0f ? 0.5f : -0.5f))
+
+static inline void pla_meshopt_unfilter_octahedral8(s8 * data, usize count){
+        for(usize i = 0; i < count; ++i){
+                f32 x = data[i * 4 + 0];
+                f32 y = data[i * 4 + 1];
+                f32 z = data[i * 4 + 2] - fabsf(x) - fabsf(y);
+                f32 t = z >= 0.0f ? 0.0f : z;
+                x += x >= 0.0f ? t : -t;
+                y += y >= 0.0f ? t : -t;
+                f32 scale = 127.0f / sqrtf(x * x + y * y + z * z);
+                data[i * 4 + 0] = (s8)pla_meshopt_round(x * scale);
+                data[i * 4 + 1] = (s8)pla_meshopt_round(y * scale);
+                data[i * 4 + 2] = (s8)pla_meshopt_round(z * scale);
+        }
+}
+
+static inline void pla_meshopt_unfilter_octahedral16(s16 * data, usize count){
+        for(usize i = 0; i < count; ++i){
+                f32 x = data[i * 4 + 0];
+                f32 y = data[i * 4 + 1];
+                f32 z = data[i * 4 + 2] - fabsf(x) - fabsf(y);
+                f32 t = z >= 0.0f ? 0.0f : z;
+                x += x >= 0.0f ? t : -t;
+                y += y >= 0.0f ? t : -t;
+                f32 scale = 32767.0f / sqrtf(x * x + y * y + z * z);
+                data[i * 4 + 0] = (s16)pla_meshopt_round(x * scale);
+                data[i * 4 + 1] = (s16)pla_meshopt_round(y * scale);
+                data[i * 4 + 2] = (s16)pla_meshopt_round(z * scale);
+        }
+}
+
+static inline void pla_meshopt_unfilter_quaternion(s16 * data, usize count){
+        f32 const scale = 1.0f / sqrtf(2.0f);
+        for(usize i = 0; i < count; ++i){
+                s32 scale_bits = data[i * 4 + 3] | 3;
+                f32 component_scale = scale / (f32)scale_bits;
+                f32 x = data[i * 4 + 0] * component_scale;
+                f32 y = data[i * 4 + 1] * component_scale;
+                f32 z = data[i * 4 + 2] * component_scale;
+                f32 ww = 1.0f - x * x - y * y - z * z;
+                f32 w = sqrtf(ww >= 0.0f ? ww : 0.0f);
+                s32 xf = pla_meshopt_round(x * 32767.0f);
+                s32 yf = pla_meshopt_round(y * 32767.0f);
+                s32 zf = pla_meshopt_round(z * 32767.0f);
+                s32 wf = (s32)(w * 32767.0f + 0.5f);
+                //the largest component was dropped, the low bits say which one.
+                s32 max_component = data[i * 4 + 3] & 3;
+                data[i * 4 + ((max_component + 1) & 3)] = (s16)xf;
+                data[i * 4 + ((max_component + 2) & 3)] = (s16)yf;
+                data[i * 4 + ((max_component + 3) & 3)] = (s16)zf;
+                data[i * 4 + ((max_component + 0) & 3)] = (s16)wf;
+        }
+}
+
+static inline void pla_meshopt_unfilter_exponential(u32 * data, usize count){
+        for(usize i = 0; i < count; ++i){
+                u32 value = data[i];
+                s32 mantissa = (s32)(value << 8) >> 8;
+                s32 exponent = (s32)value >> 24;
+                //ldexp without the libm call.
+                u32 bits = (u32)(exponent + 127) << 23;
+                f32 scale = 0;
+                memcpy(&scale, &bits, 4);
+                f32 result = scale * (f32)mantissa;
+                memcpy(&data[i], &result, 4);
+        }
+}
+
+#undef pla_meshopt_round
+
+//Bytes of memory the compressed buffer views decode in to.
+inline usize pla_get_meshopt_memory_size(pla_GLTF const * gltf){
+        usize size = 0;
+        for(u32 i = 0; i < gltf->buffer_views_size; ++i){
+                pla_meshopt_compression const * meshopt = &gltf->buffer_views[i].meshopt;
+                if(meshopt->mode != pla_meshopt_mode_none) size += get_aligned_size((usize)meshopt->count * meshopt->byte_stride);
+        }
+        return size;
+}
+
+typedef struct{
+        pla_GLTF * gltf;
+} pla_decode_meshopt_job;
+
+static inline void pla_decode_meshopt_buffer_view(void * job_data, u32 index){
+        pla_GLTF * gltf = ((pla_decode_meshopt_job *)job_data)->gltf;
+        pla_buffer_view * view = &gltf->buffer_views[index];
+        pla_meshopt_compression const * meshopt = &view->meshopt;
+        if(meshopt->mode == pla_meshopt_mode_none) return;
+        //the destination was handed out before the jobs started, its only kept if decoding works.
+        u8 * out = (u8 *)view->data;
+        view->data = PLA_NULL;
+        if(meshopt->buffer >= gltf->buffers_size) return;
+        pla_buffer const * buffer = &gltf->buffers[meshopt->buffer];
+        if(!buffer->data || (u64)meshopt->byte_offset + meshopt->byte_length > buffer->byte_length) return;
+        u8 const * data = buffer->data + meshopt->byte_offset;
+
+        bool decoded = false;
+        switch(meshopt->mode){
+                case pla_meshopt_mode_attributes: decoded = pla_meshopt_decode_vertex_buffer(out, meshopt->count, meshopt->byte_stride, data, meshopt->byte_length); break;
+                case pla_meshopt_mode_triangles: decoded = pla_meshopt_decode_index_buffer(out, meshopt->count, meshopt->byte_stride, data, meshopt->byte_length); break;
+                case pla_meshopt_mode_indices: decoded = pla_meshopt_decode_index_sequence(out, meshopt->count, meshopt->byte_stride, data, meshopt->byte_length); break;
+                default: break;
+        }
+        if(!decoded) return;
+
+        switch(meshopt->filter){
+                case pla_meshopt_filter_octahedral:
+                        if(meshopt->byte_stride == 4) pla_meshopt_unfilter_octahedral8((s8 *)out, meshopt->count);
+                        else if(meshopt->byte_stride == 8) pla_meshopt_unfilter_octahedral16((s16 *)out, meshopt->count);
+                        else return;
+                        break;
+                case pla_meshopt_filter_quaternion:
+                        if(meshopt->byte_stride != 8) return;
+                        pla_meshopt_unfilter_quaternion((s16 *)out, meshopt->count);
+                        break;
+                case pla_meshopt_filter_exponential:
+                        if(meshopt->byte_stride % 4 != 0) return;
+                        pla_meshopt_unfilter_exponential((u32 *)out, (usize)meshopt->count * meshopt->byte_stride / 4);
+                        break;
+                default: break;
+        }
+        view->data = out;
+}
+
+//Decodes every EXT_meshopt_compression buffer view in to memory, at least pla_get_meshopt_memory_size bytes.
+//Buffers have to be resolved first, each view is its own job so the job system can spread them over threads.
+inline bool pla_decode_meshopt_buffer_views(pla_GLTF * gltf, pla_job_system const * jobs, usize memory_size, u8 * memory){
+        if(!gltf) return false;
+        if(pla_get_meshopt_memory_size(gltf) > memory_size) return false;
+        usize offset = 0;
+        for(u32 i = 0; i < gltf->buffer_views_size; ++i){
+                pla_buffer_view * view = &gltf->buffer_views[i];
+                if(view->meshopt.mode == pla_meshopt_mode_none) continue;
+                usize size = (usize)view->meshopt.count * view->meshopt.byte_stride;
+                if(size > view->byte_length) return false;
+                view->data = memory + offset;
+                offset += get_aligned_size(size);
+        }
+        pla_decode_meshopt_job job = {gltf};
+        pla_parallel_for(jobs, gltf->buffer_views_size, pla_decode_meshopt_buffer_view, &job);
+        for(u32 i = 0; i < gltf->buffer_views_size; ++i){
+                if(gltf->buffer_views[i].meshopt.mode != pla_meshopt_mode_none && !gltf->buffer_views[i].data) return false;
+        }
+        return true;
+}
+
+//Skinning, repacks JOINTS_n / WEIGHTS_n for gpu skinning.
+typedef enum pla_skin_weight_format{
+        pla_skin_weight_format_unorm8,
+        pla_skin_weight_format_unorm16,
+        pla_skin_weight_format_MAX_ENUM,
+} pla_skin_weight_format;
+
+typedef struct pla_skin_packing{
+        //normalized weights under this are dropped, the largest weight of a vertex is always kept.
+        f32 weight_threshold;
+        pla_skin_weight_format weight_format;
+} pla_skin_packing;
+
+INTERNAL pla_skin_packing pla_default_skin_packing(void) NOEXCEPT{
+        pla_skin_packing packing = {};
+        packing.weight_threshold = 1.0f / 255.0f;
+        packing.weight_format = pla_skin_weight_format_unorm8;
+        return packing;
+}
+
+//4 u8 joints then 4 u8 or u16 weights.
+INTERNAL u32 pla_get_skin_influence_stride(pla_skin_weight_format format) NOEXCEPT{
+        return format == pla_skin_weight_format_unorm16 ? 12 : 8;
+}
+
+//JOINTS_0 / WEIGHTS_0 and JOINTS_1 / WEIGHTS_1 are merged.
+#define PLA_MAX_SKIN_SETS 2
+#define PLA_SKIN_CHUNK 64
+
+//Works on count vertices of 4 weights and 4 joints: negative weights are clamped, the weights are normalized, the ones under threshold are dropped with their joint set to 0 and whats left is normalized again.
+//every step is a fixed 4 wide select so the loop has no branches on the data.
+inline void pla_normalize_skin_weights(u32 count, f32 * weights, u32 * joints, f32 threshold) NOEXCEPT{
+        for(u32 v = 0; v < count; ++v){
+                f32 * w = weights + (usize)v * 4;
+                u32 * j = joints + (usize)v * 4;
+                f32 sum = 0;
+                f32 largest = 0;
+                for(u32 k = 0; k < 4; ++k){
+                        w[k] = w[k] > 0 ? w[k] : 0;
+                        sum += w[k];
+                        largest = w[k] > largest ? w[k] : largest;
+                }
+                f32 inverse = sum > 0 ? 1.0f / sum : 0;
+                f32 kept_sum = 0;
+                for(u32 k = 0; k < 4; ++k){
+                        f32 value = w[k] * inverse;
+                        bool keep = value > 0 && (value >= threshold || w[k] == largest);
+                        w[k] = keep ? value : 0;
+                        j[k] = keep ? j[k] : 0;
+                        kept_sum += w[k];
+                }
+                inverse = kept_sum > 0 ? 1.0f / kept_sum : 0;
+                for(u32 k = 0; k < 4; ++k) w[k] *= inverse;
+        }
+}
+
+//Repacks the skinning attributes of a primitive to 4 u8 joints and 4 u8 / u16 normalized weights per vertex, see pla_get_skin_influence_stride.
+//up to 8 influences are cut down to the 4 largest, which are written largest first and always add up to exactly 255 / 65535.
+//vertices without any weight are bound fully to joint 0.
+//skin is the one of the node the mesh is on, fails if a joint isn't below its joint count or one that keeps its weight doesn't fit in a u8.
+//call it without a buffer to get the size.
+inline bool pla_pack_skin_influences(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_skin const * skin, pla_skin_packing const * packing, usize * buffer_size, u8 * buffer) NOEXCEPT{
+        if(!gltf || !primitive || !skin || !packing || !buffer_size) return false;
+        if(packing->weight_format >= pla_skin_weight_format_MAX_ENUM) return false;
+
+        pla_accessor const * joint_accessors[PLA_MAX_SKIN_SETS] = {0};
+        pla_accessor const * weight_accessors[PLA_MAX_SKIN_SETS] = {0};
+        for(u32 i = 0; i < primitive->attribute_count; ++i){
+                pla_mesh_primitive_attribute const * attribute = &primitive->attributes[i];
+                if(attribute->name != pla_JOINTS && attribute->name != pla_WEIGHTS) continue;
+                if(attribute->set_index < 0 || attribute->set_index >= PLA_MAX_SKIN_SETS) continue;
+                if(attribute->accessor >= gltf->accessors_size) return false;
+                pla_accessor const * accessor = &gltf->accessors[attribute->accessor];
+                if(attribute->name == pla_JOINTS) joint_accessors[attribute->set_index] = accessor;
+                else weight_accessors[attribute->set_index] = accessor;
+        }
+        u32 set_count = 0;
+        while(set_count < PLA_MAX_SKIN_SETS && joint_accessors[set_count] && weight_accessors[set_count]) ++set_count;
+        if(set_count == 0) return false;
+
+        u32 vertex_count = joint_accessors[0]->count;
+        for(u32 s = 0; s < set_count; ++s){
+                if(joint_accessors[s]->count != vertex_count || weight_accessors[s]->count != vertex_count) return false;
+                if(pla_GLTF_type_component_count[joint_accessors[s]->type] != 4 || pla_GLTF_type_component_count[weight_accessors[s]->type] != 4) return false;
+                //joints are unsigned bytes or shorts, so they unpack to whole floats that fit a u32.
+                if(!pla_is_joint_component_type(joint_accessors[s]->component_type)) return false;
+        }
+
+        u32 stride = pla_get_skin_influence_stride(packing->weight_format);
+        usize size = (usize)vertex_count * stride;
+        if(!buffer){
+                *buffer_size = size;
+                return true;
+        }
+        if(*buffer_size < size) return false;
+
+        u8 const * joint_data[PLA_MAX_SKIN_SETS];
+        u8 const * weight_data[PLA_MAX_SKIN_SETS];
+        u32 joint_strides[PLA_MAX_SKIN_SETS];
+        u32 weight_strides[PLA_MAX_SKIN_SETS];
+        for(u32 s = 0; s < set_count; ++s){
+                joint_data[s] = pla_get_accessor_data(gltf, joint_accessors[s], &joint_strides[s]);
+                weight_data[s] = pla_get_accessor_data(gltf, weight_accessors[s], &weight_strides[s]);
+                if(!joint_data[s] || !weight_data[s]) return false;
+        }
+
+        f32 max_weight = packing->weight_format == pla_skin_weight_format_unorm16 ? 65535.0f : 255.0f;
+        for(u32 first = 0; first < vertex_count; first += PLA_SKIN_CHUNK){
+                u32 count = vertex_count - first < PLA_SKIN_CHUNK ? vertex_count - first : PLA_SKIN_CHUNK;
+                f32 set_joints[PLA_MAX_SKIN_SETS][PLA_SKIN_CHUNK * 4];
+                f32 set_weights[PLA_MAX_SKIN_SETS][PLA_SKIN_CHUNK * 4];
+                for(u32 s = 0; s < set_count; ++s){
+                        pla_unpack_accessor_f32(joint_data[s], joint_strides[s], joint_accessors[s]->component_type, 4, false, first, count, set_joints[s]);
+                        //weights are either floats or normalized integers.
+                        bool normalized = weight_accessors[s]->component_type != pla_GLTF_component_type_f32;
+                        pla_unpack_accessor_f32(weight_data[s], weight_strides[s], weight_accessors[s]->component_type, 4, normalized, first, count, set_weights[s]);
+                }
+
+                //keep the 4 largest, largest first.
+                f32 weights[PLA_SKIN_CHUNK * 4];
+                u32 joints[PLA_SKIN_CHUNK * 4];
+                for(u32 v = 0; v < count; ++v){
+                        f32 candidate_weights[PLA_MAX_SKIN_SETS * 4];
+                        u32 candidate_joints[PLA_MAX_SKIN_SETS * 4];
+                        u32 candidate_count = set_count * 4;
+                        for(u32 s = 0; s < set_count; ++s){
+                                for(u32 k = 0; k < 4; ++k){
+                                        candidate_weights[s * 4 + k] = set_weights[s][v * 4 + k];
+                                        candidate_joints[s * 4 + k] = (u32)set_joints[s][v * 4 + k];
+                                        if(candidate_joints[s * 4 + k] >= skin->joint_count) return false;
+                                }
+                        }
+                        for(u32 k = 0; k < 4; ++k){
+                                u32 best = 0;
+                                for(u32 c = 1; c < candidate_count; ++c) best = candidate_weights[c] > candidate_weights[best] ? c : best;
+                                weights[v * 4 + k] = candidate_weights[best] > 0 ? candidate_weights[best] : 0;
+                                joints[v * 4 + k] = candidate_joints[best];
+                                candidate_weights[best] = -INFINITY;
+                        }
+                }
+
+                pla_normalize_skin_weights(count, weights, joints, packing->weight_threshold);
+
+                for(u32 v = 0; v < count; ++v){
+                        u8 * out = buffer + (usize)(first + v) * stride;
+                        s32 quantized[4];
+                        s32 sum = 0;
+                        for(u32 k = 0; k < 4; ++k){
+                                if(joints[v * 4 + k] > 255) return false;
+                                out[k] = (u8)joints[v * 4 + k];
+                                //nan and out of range weights from a broken file are clamped before rounding.
+                                f32 weight = weights[v * 4 + k] > 0 ? weights[v * 4 + k] : 0;
+                                quantized[k] = pla_round_to_s32((weight < 1 ? weight : 1) * max_weight);
+                                sum += quantized[k];
+                        }
+                        //the rounding error goes on the largest weight so the sum is exact.
+                        quantized[0] += (s32)max_weight - sum;
+                        for(u32 k = 0; k < 4; ++k){
+                                if(packing->weight_format == pla_skin_weight_format_unorm16){
+                                        u16 packed = (u16)quantized[k];
+                                        memcpy(out + 4 + k * 2, &packed, 2);
+                                }else out[4 + k] = (u8)quantized[k];
+                        }
+                }
+        }
+        return true;
+}
+
+//Animation sampling.
+//A clip is an animation baked into structure of arrays tracks: key times in one array and each component of the values in its own row, so the keys a sample reads are next to each other.
+
+typedef struct pla_animation_track{
+        u32 node;
+        pla_animation_path path;
+        pla_animation_interpolation interpolation;
+        //3 for translation and scale, 4 for rotation, the morph target count for weights.
+        u32 component_count;
+        u32 key_count;
+        f32 const * times;
+        //component c of key k is values[c * value_stride + k], cubic splines store in tangent, value, out tangent for each key so k goes up to 3 * key_count.
+        f32 const * values;
+        u32 value_stride;
+        //where the track writes its component_count floats in a sample of the clip.
+        u32 output_offset;
+} pla_animation_track;
+
+typedef struct pla_animation_clip{
+        pla_animation_track * tracks;
+        u32 track_count;
+        //floats in one sample of the whole clip.
+        u32 output_size;
+        f32 start_time;
+        f32 end_time;
+} pla_animation_clip;
+
+//values per key of a sampler output, 3 per key for cubic splines.
+static inline u32 pla_get_animation_key_elements(pla_animation_interpolation interpolation){
+        return interpolation == pla_animation_interpolation_cubic_spline ? 3 : 1;
+}
+
+//Gets the accessors of a channel, fails if the channel can't be baked.
+static inline bool pla_get_animation_channel_accessors(pla_GLTF const * gltf, pla_animation const * animation, pla_animation_channel const * channel, pla_accessor const ** out_input, pla_accessor const ** out_output, u32 * out_component_count){
+        if(channel->sampler >= animation->sampler_count) return false;
+        pla_animation_sampler const * sampler = &animation->samplers[channel->sampler];
+        if(sampler->input >= gltf->accessors_size || sampler->output >= gltf->accessors_size) return false;
+        if(sampler->interpolation >= pla_animation_interpolation_MAX_ENUM) return false;
+        pla_accessor const * input = &gltf->accessors[sampler->input];
+        pla_accessor const * output = &gltf->accessors[sampler->output];
+        if(input->component_type != pla_GLTF_component_type_f32 || pla_GLTF_type_component_count[input->type] != 1) return false;
+        u32 elements = pla_get_animation_key_elements(sampler->interpolation) * input->count;
+        u32 component_count = 0;
+        switch(channel->target_path){
+                case pla_animation_path_translation:
+                case pla_animation_path_scale: component_count = 3; break;
+                case pla_animation_path_rotation: component_count = 4; break;
+                case pla_animation_path_weights: component_count = elements ? output->count / elements : 0; break;
+                default: return false;
+        }
+        if(pla_GLTF_type_component_count[output->type] * (u64)output->count != (u64)component_count * elements) return false;
+        *out_input = input;
+        *out_output = output;
+        *out_component_count = component_count;
+        return true;
+}
+
+#define PLA_ANIMATION_CHUNK 64
+
+//Bakes an animation into a clip, channels that don't target a node are left out.
+//call it without a buffer to get the size.
+inline bool pla_bake_animation_clip(pla_GLTF const * gltf, pla_animation const * animation, usize * buffer_size, u8 * buffer, pla_animation_clip * out_clip) NOEXCEPT{
+        if(!gltf || !animation || !buffer_size) return false;
+        u32 track_count = 0;
+        usize float_count = 0;
+        for(u32 i = 0; i < animation->channel_count; ++i){
+                pla_animation_channel const * channel = &animation->channels[i];
+                if(channel->target_node == PLA_INDEX_NONE) continue;
+                pla_accessor const * input;
+                pla_accessor const * output;
+                u32 component_count;
+                if(!pla_get_animation_channel_accessors(gltf, animation, channel, &input, &output, &component_count)) return false;
+                ++track_count;
+                float_count += input->count + (usize)component_count * pla_get_animation_key_elements(animation->samplers[channel->sampler].interpolation) * input->count;
+        }
+        usize tracks_size = get_aligned_size(track_count * sizeof(pla_animation_track));
+        usize size = tracks_size + float_count * sizeof(f32);
+        if(!buffer){
+                *buffer_size = size;
+                return true;
+        }
+        if(!out_clip || *buffer_size < size) return false;
+
+        pla_animation_track * tracks = (pla_animation_track *)buffer;
+        f32 * floats = (f32 *)(buffer + tracks_size);
+        pla_animation_clip clip = {.tracks = tracks, .track_count = 0, .output_size = 0, .start_time = INFINITY, .end_time = -INFINITY};
+        for(u32 i = 0; i < animation->channel_count; ++i){
+                pla_animation_channel const * channel = &animation->channels[i];
+                if(channel->target_node == PLA_INDEX_NONE) continue;
+                pla_accessor const * input;
+                pla_accessor const * output;
+                u32 component_count;
+                if(!pla_get_animation_channel_accessors(gltf, animation, channel, &input, &output, &component_count)) return false;
+                pla_animation_interpolation interpolation = animation->samplers[channel->sampler].interpolation;
+                u32 stride = 0;
+                u8 const * input_data = pla_get_accessor_data(gltf, input, &stride);
+                if(!input_data) return false;
+                f32 * times = floats;
+                pla_unpack_accessor_f32(input_data, stride, input->component_type, 1, false, 0, input->count, times);
+                floats += input->count;
+
+                u8 const * output_data = pla_get_accessor_data(gltf, output, &stride);
+                if(!output_data) return false;
+                //outputs that aren't floats are always normalized.
+                bool normalized = output->component_type != pla_GLTF_component_type_f32;
+                u32 value_stride = pla_get_animation_key_elements(interpolation) * input->count;
+                f32 * values = floats;
+                floats += (usize)component_count * value_stride;
+                //transpose to one row per component, a chunk at a time.
+                u32 output_components = pla_GLTF_type_component_count[output->type];
+                for(u32 first = 0; first < output->count; first += PLA_ANIMATION_CHUNK){
+                        u32 count = output->count - first < PLA_ANIMATION_CHUNK ? output->count - first : PLA_ANIMATION_CHUNK;
+                        f32 chunk[PLA_ANIMATION_CHUNK * 16];
+                        pla_unpack_accessor_f32(output_data, stride, output->component_type, output_components, normalized, first, count, chunk);
+                        for(u32 e = 0; e < count * output_components; ++e){
+                                usize flat = (usize)first * output_components + e;
+                                u32 key = (u32)(flat / component_count);
+                                u32 comp = (u32)(flat % component_count);
+                                values[(usize)comp * value_stride + key] = chunk[e];
+                        }
+                }
+
+                pla_animation_track * track = &tracks[clip.track_count++];
+                track->node = channel->target_node;
+                track->path = channel->target_path;
+                track->interpolation = interpolation;
+                track->component_count = component_count;
+                track->key_count = input->count;
+                track->times = times;
+                track->values = values;
+                track->value_stride = value_stride;
+                track->output_offset = clip.output_size;
+                clip.output_size += component_count;
+                if(input->count){
+                        clip.start_time = times[0] < clip.start_time ? times[0] : clip.start_time;
+                        clip.end_time = times[input->count - 1] > clip.end_time ? times[input->count - 1] : clip.end_time;
+                }
+        }
+        if(clip.start_time > clip.end_time) clip.start_time = clip.end_time = 0;
+        *out_clip = clip;
+        return true;
+}
+
+//Finds the key k with times[k] <= time < times[k + 1], time has to be inside the track.
+//the cursor is checked first and then the key after it since time mostly moves forward a little, otherwise its a binary search.
+static inline u32 pla_find_animation_key(f32 const * times, u32 key_count, f32 time, u32 cursor){
+        if(cursor + 1 < key_count && times[cursor] <= time){
+                if(time < times[cursor + 1]) return cursor;
+                if(cursor + 2 < key_count && time < times[cursor + 2]) return cursor + 1;
+        }
+        u32 low = 0;
+        u32 high = key_count - 1;
+        while(low + 1 < high){
+                u32 middle = low + (high - low) / 2;
+                if(times[middle] <= time) low = middle;
+                else high = middle;
+        }
+        return low;
+}
+
+//Samples one track at time into its component_count floats in out, cursor is the key the last sample landed on.
+inline void pla_sample_animation_track(pla_animation_track const * track, f32 time, u32 * cursor, f32 * out) NOEXCEPT{
+        u32 comps = track->component_count;
+        u32 elements = pla_get_animation_key_elements(track->interpolation);
+        //the value of a key sits in the middle of the tangents for cubic splines.
+        u32 value_element = elements == 3 ? 1 : 0;
+        f32 const * values = track->values;
+        u32 stride = track->value_stride;
+        if(track->key_count == 0){
+                for(u32 c = 0; c < comps; ++c) out[c] = 0;
+                return;
+        }
+        u32 last = track->key_count - 1;
+        if(track->key_count == 1 || time <= track->times[0] || time >= track->times[last]){
+                u32 key = time >= track->times[last] ? last : 0;
+                *cursor = key;
+                for(u32 c = 0; c < comps; ++c) out[c] = values[c * stride + key * elements + value_element];
+                return;
+        }
+        u32 key = pla_find_animation_key(track->times, track->key_count, time, *cursor);
+        *cursor = key;
+        f32 delta = track->times[key + 1] - track->times[key];
+        f32 t = delta > 0 ? (time - track->times[key]) / delta : 0;
+
+        switch(track->interpolation){
+                case pla_animation_interpolation_step:
+                        for(u32 c = 0; c < comps; ++c) out[c] = values[c * stride + key];
+                        break;
+                case pla_animation_interpolation_linear:
+                        if(track->path == pla_animation_path_rotation){
+                                f32 a[4], b[4];
+                                f32 cos_angle = 0;
+                                for(u32 c = 0; c < 4; ++c){
+                                        a[c] = values[c * stride + key];
+                                        b[c] = values[c * stride + key + 1];
+                                        cos_angle += a[c] * b[c];
+                                }
+                                //take the short way round.
+                                f32 sign = cos_angle < 0 ? -1.0f : 1.0f;
+                                cos_angle *= sign;
+                                f32 wa = 1.0f - t;
+                                f32 wb = t;
+                                //slerp, close quaternions fall back to a normalized lerp.
+                                if(cos_angle < 0.9995f){
+                                        f32 angle = acosf(cos_angle);
+                                        f32 inverse_sin = 1.0f / sinf(angle);
+                                        wa = sinf((1.0f - t) * angle) * inverse_sin;
+                                        wb = sinf(t * angle) * inverse_sin;
+                                }
+                                f32 length = 0;
+                                for(u32 c = 0; c < 4; ++c){
+                                        out[c] = a[c] * wa + b[c] * wb * sign;
+                                        length += out[c] * out[c];
+                                }
+                                f32 inverse_length = length > 0 ? 1.0f / sqrtf(length) : 0;
+                                for(u32 c = 0; c < 4; ++c) out[c] *= inverse_length;
+                        }else{
+                                for(u32 c = 0; c < comps; ++c){
+                                        f32 a = values[c * stride + key];
+                                        f32 b = values[c * stride + key + 1];
+                                        out[c] = a + (b - a) * t;
+                                }
+                        }
+                        break;
+                case pla_animation_interpolation_cubic_spline: {
+                        f32 t2 = t * t;
+                        f32 t3 = t2 * t;
+                        f32 h00 = 2 * t3 - 3 * t2 + 1;
+                        f32 h10 = t3 - 2 * t2 + t;
+                        f32 h01 = -2 * t3 + 3 * t2;
+                        f32 h11 = t3 - t2;
+                        f32 length = 0;
+                        for(u32 c = 0; c < comps; ++c){
+                                f32 const * row = values + c * stride;
+                                f32 p0 = row[key * 3 + 1];
+                                f32 m0 = row[key * 3 + 2] * delta;
+                                f32 p1 = row[(key + 1) * 3 + 1];
+                                f32 m1 = row[(key + 1) * 3] * delta;
+                                out[c] = h00 * p0 + h10 * m0 + h01 * p1 + h11 * m1;
+                                length += out[c] * out[c];
+                        }
+                        if(track->path == pla_animation_path_rotation){
+                                f32 inverse_length = length > 0 ? 1.0f / sqrtf(length) : 0;
+                                for(u32 c = 0; c < 4; ++c) out[c] *= inverse_length;
+                        }
+                        break;
+                }
+                default: break;
+        }
+}
+
+//Samples every track of the clip into out (output_size floats), cursors has one u32 per track and should start zeroed.
+inline void pla_sample_animation_clip(pla_animation_clip const * clip, f32 time, u32 * cursors, f32 * out) NOEXCEPT{
+        for(u32 i = 0; i < clip->track_count; ++i){
+                pla_animation_track const * track = &clip->tracks[i];
+                pla_sample_animation_track(track, time, &cursors[i], out + track->output_offset);
+        }
+}
+
+//a bit over 77 hours at 60 fps.
+#define PLA_MAX_RESAMPLED_FRAMES (1u << 24)
+
+//Frames needed to resample a clip, the first is at start_time and the last at end_time.
+//0 if the frame rate isn't above 0, the times aren't finite or it would be more than PLA_MAX_RESAMPLED_FRAMES.
+INTERNAL u32 pla_get_resampled_frame_count(pla_animation_clip const * clip, f32 frame_rate) NOEXCEPT{
+        if(!(frame_rate > 0)) return 0;
+        f32 frames = (clip->end_time - clip->start_time) * frame_rate;
+        if(!isfinite(frames) || frames >= (f32)PLA_MAX_RESAMPLED_FRAMES) return 0;
+        if(frames <= 0) return 1;
+        //a little slack so a clip that is a whole number of frames long doesn't get an extra one from rounding.
+        return (u32)ceilf(frames - 1e-3f) + 1;
+}
+
+//Resamples the clip at a fixed frame rate into out, pla_get_resampled_frame_count frames of output_size floats.
+//tracks are done one at a time across every frame so each keeps its cursor and keys in cache.
+//fails without writing anything if pla_get_resampled_frame_count is 0.
+inline bool pla_resample_animation_clip(pla_animation_clip const * clip, f32 frame_rate, f32 * out) NOEXCEPT{
+        u32 frame_count = pla_get_resampled_frame_count(clip, frame_rate);
+        if(frame_count == 0) return false;
+        for(u32 i = 0; i < clip->track_count; ++i){
+                pla_animation_track const * track = &clip->tracks[i];
+                u32 cursor = 0;
+                for(u32 frame = 0; frame < frame_count; ++frame){
+                        f32 time = clip->start_time + (f32)frame / frame_rate;
+                        time = time < clip->end_time ? time : clip->end_time;
+                        pla_sample_animation_track(track, time, &cursor, out + (usize)frame * clip->output_size + track->output_offset);
+                }
+        }
+        return true;
+}
+
+typedef struct pla_resample_job{
+        pla_animation_clip const * clips;
+        f32 frame_rate;
+        f32 * const * outs;
+} pla_resample_job;
+
+static inline void pla_resample_animation_clip_job(void * job_data, u32 index){
+        pla_resample_job const * job = (pla_resample_job const *)job_data;
+        pla_resample_animation_clip(&job->clips[index], job->frame_rate, job->outs[index]);
+}
+
+//Resamples many clips, one job per clip, outs[i] is the output for clips[i].
+//fails without writing anything if a clip can't be resampled, see pla_get_resampled_frame_count.
+inline bool pla_resample_animation_clips(pla_animation_clip const * clips, u32 clip_count, f32 frame_rate, f32 * const * outs, pla_job_system const * jobs) NOEXCEPT{
+        for(u32 i = 0; i < clip_count; ++i){
+                if(pla_get_resampled_frame_count(&clips[i], frame_rate) == 0) return false;
+        }
+        pla_resample_job job = {.clips = clips, .frame_rate = frame_rate, .outs = outs};
+        pla_parallel_for(jobs, clip_count, pla_resample_animation_clip_job, &job);
+        return true;
+}
+
+//Images.
+//Nothing here runs while parsing, a tool that only wants geometry never touches the image bytes.
+
+//Returns the bytes of a buffer view once its buffer is resolved, compressed views return their decoded bytes.
+inline u8 const * pla_get_buffer_view_data(pla_GLTF const * gltf, u32 buffer_view, usize * out_size) NOEXCEPT{
+        if(buffer_view >= gltf->buffer_views_size) return PLA_NULL;
+        pla_buffer_view const * view = &gltf->buffer_views[buffer_view];
+        if(view->meshopt.mode != pla_meshopt_mode_none){
+                if(!view->data) return PLA_NULL;
+                *out_size = view->byte_length;
+                return view->data;
+        }
+        if(view->buffer >= gltf->buffers_size) return PLA_NULL;
+        pla_buffer const * buffer = &gltf->buffers[view->buffer];
+        if(!buffer->data || (u64)view->byte_offset + view->byte_length > buffer->byte_length) return PLA_NULL;
+        *out_size = view->byte_length;
+        return buffer->data + view->byte_offset;
+}
+
+static inline u32 pla_read_u32_big_endian(u8 const * data){
+        return (u32)data[0] << 24 | (u32)data[1] << 16 | (u32)data[2] << 8 | (u32)data[3];
+}
+
+static inline u16 pla_read_u16_big_endian(u8 const * data){
+        return (u16)(data[0] << 8 | data[1]);
+}
+
+//Reads the format, size and channel count from a png or jpeg header without decoding anything.
+inline bool pla_read_image_header(u8 const * data, usize size, pla_image_format * out_format, u32 * out_width, u32 * out_height, u8 * out_channel_count) NOEXCEPT{
+        if(size >= 26 && memcmp(data, "\x89PNG\r\n\x1a\n", 8) == 0 && memcmp(data + 12, "IHDR", 4) == 0){
+                //channels by color type: grey, -, rgb, palette, grey alpha, -, rgba.
+                u8 const channels[7] = {1, 0, 3, 3, 2, 0, 4};
+                u8 color_type = data[25];
+                if(color_type > 6 || channels[color_type] == 0) return false;
+                *out_format = pla_image_format_png;
+                *out_width = pla_read_u32_big_endian(data + 16);
+                *out_height = pla_read_u32_big_endian(data + 20);
+                *out_channel_count = channels[color_type];
+                return true;
+        }
+        if(size >= 4 && data[0] == 0xFF && data[1] == 0xD8){
+                //walk the segments til the start of frame.
+                usize c = 2;
+                while(c + 4 <= size){
+                        if(data[c] != 0xFF) return false;
+                        u8 marker = data[c + 1];
+                        if(marker == 0xFF){
+                                ++c;
+                                continue;
+                        }
+                        if(marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)){
+                                c += 2;
+                                continue;
+                        }
+                        if(marker == 0xD9 || marker == 0xDA) return false;
+                        bool is_start_of_frame = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+                        if(is_start_of_frame){
+                                if(c + 10 > size) return false;
+                                *out_format = pla_image_format_jpeg;
+                                *out_height = pla_read_u16_big_endian(data + c + 5);
+                                *out_width = pla_read_u16_big_endian(data + c + 7);
+                                *out_channel_count = data[c + 9];
+                                return true;
+                        }
+                        c += 2 + pla_read_u16_big_endian(data + c + 2);
+                }
+        }
+        return false;
+}
+
+//Bytes of memory pla_resolve_images needs to decode the images that are embedded as data uris.
+inline usize pla_get_image_memory_size(pla_GLTF const * gltf) NOEXCEPT{
+        usize size = 0;
+        for(u32 i = 0; i < gltf->images_size; ++i){
+                pla_image const * image = &gltf->images[i];
+                if(image->buffer_view != PLA_INDEX_NONE || !pla_uri_is_data(image->uri)) continue;
+                size += get_aligned_size(pla_data_uri_payload(image->uri).length / 4 * 3 + 3);
+        }
+        return size;
+}
+
+typedef struct{
+        pla_GLTF * gltf;
+        pla_file_system const * file_system;
+} pla_resolve_images_job;
+
+static inline void pla_resolve_image(void * job_data, u32 index){
+        pla_resolve_images_job * job = (pla_resolve_images_job *)job_data;
+        pla_image * image = &job->gltf->images[index];
+        if(image->buffer_view != PLA_INDEX_NONE){
+                image->data = pla_get_buffer_view_data(job->gltf, image->buffer_view, &image->data_size);
+        }else if(pla_uri_is_data(image->uri)){
+                //the destination and its size were handed out before the jobs started.
+                u8 * destination = (u8 *)image->data;
+                usize length = 0;
+                image->data = PLA_NULL;
+                if(!pla_base64_decode(pla_data_uri_payload(image->uri), destination, image->data_size, &length)) return;
+                image->data = destination;
+                image->data_size = length;
+        }else if(image->uri.data){
+                pla_file_system const * file_system = job->file_system;
+                if(!file_system || !file_system->open) return;
+                u8 const * data = PLA_NULL;
+                usize size = 0;
+                void * handle = PLA_NULL;
+                if(!file_system->open(file_system->user_data, image->uri, &data, &size, &handle)) return;
+                image->file_handle = handle;
+                image->file_size = size;
+                image->data = data;
+                image->data_size = size;
+        }
+        if(!image->data) return;
+        //formats other than png and jpeg are left unknown for you to look at.
+        if(!pla_read_image_header(image->data, image->data_size, &image->format, &image->width, &image->height, &image->channel_count)){
+                image->format = pla_image_format_unknown;
+                image->width = image->height = 0;
+                image->channel_count = 0;
+        }
+}
+
+//Finds the encoded bytes of every image and reads their headers, one job per image.
+//images in buffer views are slices of the resolved buffers so call pla_resolve_buffers first, files come from the file system and data uris are decoded in to memory.
+//memory has to be at least pla_get_image_memory_size bytes, it can be null if there are no data uris.
+inline bool pla_resolve_images(pla_GLTF * gltf, pla_file_system const * file_system, pla_job_system const * jobs, usize memory_size, u8 * memory) NOEXCEPT{
+        if(!gltf) return false;
+        if(pla_get_image_memory_size(gltf) > memory_size) return false;
+        usize offset = 0;
+        for(u32 i = 0; i < gltf->images_size; ++i){
+                pla_image * image = &gltf->images[i];
+                if(image->buffer_view != PLA_INDEX_NONE || !pla_uri_is_data(image->uri)) continue;
+                image->data = memory + offset;
+                image->data_size = pla_data_uri_payload(image->uri).length / 4 * 3 + 3;
+                offset += get_aligned_size(image->data_size);
+        }
+        pla_resolve_images_job job = {gltf, file_system};
+        pla_parallel_for(jobs, gltf->images_size, pla_resolve_image, &job);
+        for(u32 i = 0; i < gltf->images_size; ++i){
+                pla_image const * image = &gltf->images[i];
+                if((image->uri.data || image->buffer_view != PLA_INDEX_NONE) && !image->data) return false;
+        }
+        return true;
+}
+
+//Closes the files pla_resolve_images opened.
+inline void pla_release_images(pla_GLTF * gltf, pla_file_system const * file_system) NOEXCEPT{
+        for(u32 i = 0; i < gltf->images_size; ++i){
+                pla_image * image = &gltf->images[i];
+                //the handle can be null, the posix file system gives mapped files none.
+                if(image->buffer_view != PLA_INDEX_NONE || !image->uri.data || pla_uri_is_data(image->uri)) continue;
+                if(image->data && file_system && file_system->close) file_system->close(file_system->user_data, image->file_handle, image->data, image->file_size);
+                image->data = PLA_NULL;
+                image->file_handle = PLA_NULL;
+        }
+}
+
+//Decodes images to pixels, plug in the png / jpeg decoder you already use.
+typedef struct pla_image_decoder{
+        void * user_data;
+        //has to write image->width * image->height rgba8 pixels to out_pixels.
+        bool (*decode)(void * user_data, pla_image const * image, u8 * out_pixels);
+} pla_image_decoder;
+
+//Bytes pla_decode_images needs for the rgba8 pixels of the images, image_indices can be null for every image.
+inline usize pla_get_image_pixels_memory_size(pla_GLTF const * gltf, u32 const * image_indices, u32 image_count) NOEXCEPT{
+        if(!image_indices) image_count = gltf->images_size;
+        usize size = 0;
+        for(u32 i = 0; i < image_count; ++i){
+                u32 index = image_indices ? image_indices[i] : i;
+                if(index >= gltf->images_size) continue;
+                size += get_aligned_size((usize)gltf->images[index].width * gltf->images[index].height * 4);
+        }
+        return size;
+}
+
+typedef struct{
+        pla_GLTF * gltf;
+        u32 const * image_indices;
+        pla_image_decoder const * decoder;
+} pla_decode_images_job;
+
+static inline void pla_decode_image(void * job_data, u32 i){
+        pla_decode_images_job * job = (pla_decode_images_job *)job_data;
+        pla_image * image = &job->gltf->images[job->image_indices ? job->image_indices[i] : i];
+        if(!job->decoder->decode(job->decoder->user_data, image, image->pixels)) image->pixels = PLA_NULL;
+}
+
+//Decodes the images you ask for in to memory, one job per image, after pla_resolve_images.
+//memory has to be at least pla_get_image_pixels_memory_size bytes for the same images.
+inline bool pla_decode_images(pla_GLTF * gltf, u32 const * image_indices, u32 image_count, pla_image_decoder const * decoder, pla_job_system const * jobs, usize memory_size, u8 * memory) NOEXCEPT{
+        if(!gltf || !decoder || !decoder->decode) return false;
+        if(!image_indices) image_count = gltf->images_size;
+        if(pla_get_image_pixels_memory_size(gltf, image_indices, image_count) > memory_size) return false;
+        usize offset = 0;
+        for(u32 i = 0; i < image_count; ++i){
+                u32 index = image_indices ? image_indices[i] : i;
+                if(index >= gltf->images_size) return false;
+                pla_image * image = &gltf->images[index];
+                //headers are read when resolving, images without one can't be sized.
+                if(!image->data || image->width == 0 || image->height == 0) return false;
+                image->pixels = memory + offset;
+                offset += get_aligned_size((usize)image->width * image->height * 4);
+        }
+        pla_decode_images_job job = {gltf, image_indices, decoder};
+        pla_parallel_for(jobs, image_count, pla_decode_image, &job);
+        for(u32 i = 0; i < image_count; ++i) if(!gltf->images[image_indices ? image_indices[i] : i].pixels) return false;
+        return true;
+}
+
+//Sparse accessors and morph targets.
+
+#define PLA_SPARSE_CHUNK 64
+#define PLA_MORPH_CHUNK 256
+
+static inline u32 pla_read_sparse_index(u8 const * indices, pla_GLTF_component_type type, u32 i){
+        switch(type){
+                case pla_GLTF_component_type_u8: return indices[i];
+                case pla_GLTF_component_type_u16: { u16 index; memcpy(&index, indices + (usize)i * 2, 2); return index; }
+                case pla_GLTF_component_type_u32: { u32 index; memcpy(&index, indices + (usize)i * 4, 4); return index; }
+                default: return UINT32_MAX;
+        }
+}
+
+//Unpacks count elements of an accessor starting at first into floats and applies the sparse substitutions on top.
+//accessors without a buffer view start as zeros. any range works so big accessors can be split across jobs, a count of 0 just checks the accessor can be read.
+inline bool pla_read_accessor_f32(pla_GLTF const * gltf, pla_accessor const * accessor, u32 first, u32 count, f32 * out) NOEXCEPT{
+        if(first > accessor->count || count > accessor->count - first) return false;
+        u32 comps = pla_GLTF_type_component_count[accessor->type];
+        if(accessor->buffer_view != PLA_INDEX_NONE){
+                u32 stride = 0;
+                u8 const * data = pla_get_accessor_data(gltf, accessor, &stride);
+                if(!data) return false;
+                pla_unpack_accessor_f32(data, stride, accessor->component_type, comps, accessor->normalized, first, count, out);
+        }else{
+                for(usize i = 0; i < (usize)count * comps; ++i) out[i] = 0;
+        }
+
+        pla_accessor_sparse const * sparse = &accessor->sparse;
+        if(sparse->count == 0) return true;
+        usize indices_size = 0;
+        usize values_size = 0;
+        u8 const * indices = pla_get_buffer_view_data(gltf, sparse->indices_buffer_view, &indices_size);
+        u8 const * values = pla_get_buffer_view_data(gltf, sparse->values_buffer_view, &values_size);
+        if(!indices || !values) return false;
+        pla_GLTF_component_type index_type = sparse->indices_component_type;
+        if(index_type != pla_GLTF_component_type_u8 && index_type != pla_GLTF_component_type_u16 && index_type != pla_GLTF_component_type_u32) return false;
+        u32 element_size = pla_GLTF_component_type_byte_count[accessor->component_type] * comps;
+        if(sparse->indices_byte_offset + (u64)sparse->count * pla_GLTF_component_type_byte_count[index_type] > indices_size) return false;
+        if(sparse->values_byte_offset + (u64)sparse->count * element_size > values_size) return false;
+        indices += sparse->indices_byte_offset;
+        values += sparse->values_byte_offset;
+
+        //the indices are strictly increasing so only the ones inside the range are looked at.
+        u32 low = 0;
+        u32 high = sparse->count;
+        while(low < high){
+                u32 middle = low + (high - low) / 2;
+                if(pla_read_sparse_index(indices, index_type, middle) < first) low = middle + 1;
+                else high = middle;
+        }
+        u32 end = first + count;
+        for(u32 begin = low; begin < sparse->count; begin += PLA_SPARSE_CHUNK){
+                u32 chunk_count = sparse->count - begin < PLA_SPARSE_CHUNK ? sparse->count - begin : PLA_SPARSE_CHUNK;
+                f32 chunk[PLA_SPARSE_CHUNK * 16];
+                pla_unpack_accessor_f32(values, element_size, accessor->component_type, comps, accessor->normalized, begin, chunk_count, chunk);
+                for(u32 i = 0; i < chunk_count; ++i){
+                        u32 index = pla_read_sparse_index(indices, index_type, begin + i);
+                        if(index >= end) return true;
+                        //only a broken file has them out of order.
+                        if(index < first) continue;
+                        for(u32 c = 0; c < comps; ++c) out[(usize)(index - first) * comps + c] = chunk[i * comps + c];
+                }
+        }
+        return true;
+}
+
+static inline pla_accessor const * pla_find_attribute_accessor(pla_GLTF const * gltf, pla_mesh_primitive_attribute const * attributes, u32 attribute_count, pla_mesh_primitive_attribute_name name){
+        for(u32 i = 0; i < attribute_count; ++i){
+                if(attributes[i].name != name || attributes[i].set_index != 0) continue;
+                return attributes[i].accessor < gltf->accessors_size ? &gltf->accessors[attributes[i].accessor] : PLA_NULL;
+        }
+        return PLA_NULL;
+}
+
+//Number of vertex indices a primitive draws, the count of its indices or of its POSITION when it has none. 0 if neither can be found.
+inline u32 pla_get_primitive_index_count(pla_GLTF const * gltf, pla_mesh_primitive const * primitive) NOEXCEPT{
+        if(primitive->indices != PLA_INDEX_NONE) return primitive->indices < gltf->accessors_size ? gltf->accessors[primitive->indices].count : 0;
+        pla_accessor const * position = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+        return position ? position->count : 0;
+}
+
+//Reads count of the vertex indices a primitive draws starting at first as u32, a primitive without indices draws first, first + 1, ...
+//plain u8, u16 and u32 index accessors are read straight, sparse ones go through floats so they're exact up to 2^24.
+inline bool pla_read_primitive_indices(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, u32 first, u32 count, u32 * out) NOEXCEPT{
+        u32 index_count = pla_get_primitive_index_count(gltf, primitive);
+        if(first > index_count || count > index_count - first) return false;
+        if(primitive->indices == PLA_INDEX_NONE){
+                for(u32 i = 0; i < count; ++i) out[i] = first + i;
+                return true;
+        }
+        pla_accessor const * accessor = &gltf->accessors[primitive->indices];
+        if(accessor->type != pla_GLTF_SCALAR) return false;
+        pla_GLTF_component_type type = accessor->component_type;
+        if(type != pla_GLTF_component_type_u8 && type != pla_GLTF_component_type_u16 && type != pla_GLTF_component_type_u32) return false;
+        if(accessor->sparse.count == 0 && accessor->buffer_view != PLA_INDEX_NONE){
+                u32 stride = 0;
+                u8 const * data = pla_get_accessor_data(gltf, accessor, &stride);
+                if(!data) return false;
+                u32 size = pla_GLTF_component_type_byte_count[type];
+                if(stride == size){
+                        for(u32 i = 0; i < count; ++i) out[i] = pla_read_sparse_index(data, type, first + i);
+                }else{
+                        for(u32 i = 0; i < count; ++i) out[i] = pla_read_sparse_index(data + (usize)stride * (first + i), type, 0);
+                }
+                return true;
+        }
+        for(u32 begin = 0; begin < count; begin += PLA_SPARSE_CHUNK){
+                u32 chunk_count = count - begin < PLA_SPARSE_CHUNK ? count - begin : PLA_SPARSE_CHUNK;
+                f32 chunk[PLA_SPARSE_CHUNK];
+                if(!pla_read_accessor_f32(gltf, accessor, first + begin, chunk_count, chunk)) return false;
+                for(u32 i = 0; i < chunk_count; ++i) out[begin + i] = (u32)chunk[i];
+        }
+        return true;
+}
+
+//Triangles of a triangle list, strip or fan primitive, 0 for points and lines.
+inline u32 pla_get_primitive_triangle_count(pla_GLTF const * gltf, pla_mesh_primitive const * primitive) NOEXCEPT{
+        u32 index_count = pla_get_primitive_index_count(gltf, primitive);
+        switch(primitive->mode){
+                case 4: return index_count / 3;
+                case 5: case 6: return index_count > 2 ? index_count - 2 : 0;
+                default: return 0;
+        }
+}
+
+//Reads the vertex indices of count triangles starting at first, 3 per triangle in out, with strips and fans unrolled in to lists.
+//every other strip triangle has its second and third corner swapped so they all keep the winding of the first, like the spec draws them.
+inline bool pla_read_primitive_triangles(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, u32 first, u32 count, u32 * out) NOEXCEPT{
+        u32 triangle_count = pla_get_primitive_triangle_count(gltf, primitive);
+        if(first > triangle_count || count > triangle_count - first) return false;
+        if(!count) return true;
+        if(primitive->mode == 4) return pla_read_primitive_indices(gltf, primitive, first * 3, count * 3, out);
+        u32 center = 0;
+        if(primitive->mode == 6 && !pla_read_primitive_indices(gltf, primitive, 0, 1, &center)) return false;
+        //a window of the indices, triangle t uses t, t + 1 and t + 2.
+        for(u32 begin = 0; begin < count; begin += PLA_SPARSE_CHUNK){
+                u32 chunk_count = count - begin < PLA_SPARSE_CHUNK ? count - begin : PLA_SPARSE_CHUNK;
+                u32 window[PLA_SPARSE_CHUNK + 2];
+                if(!pla_read_primitive_indices(gltf, primitive, first + begin, chunk_count + 2, window)) return false;
+                for(u32 i = 0; i < chunk_count; ++i){
+                        u32 const * w = window + i;
+                        u32 * triangle = out + (usize)(begin + i) * 3;
+                        if(primitive->mode == 6){
+                                triangle[0] = center;
+                                triangle[1] = w[1];
+                                triangle[2] = w[2];
+                                continue;
+                        }
+                        u32 odd = (first + begin + i) & 1;
+                        triangle[0] = w[0];
+                        triangle[1] = w[1 + odd];
+                        triangle[2] = w[2 - odd];
+                }
+        }
+        return true;
+}
+
+typedef struct{
+        pla_GLTF const * gltf;
+        pla_mesh_primitive const * primitive;
+        pla_mesh_primitive_attribute_name name;
+        pla_accessor const * base;
+        f32 const * weights;
+        u32 weight_count;
+        f32 * out;
+} pla_blend_morph_targets_job;
+
+static inline void pla_blend_morph_targets_chunk(void * job_data, u32 chunk){
+        pla_blend_morph_targets_job const * job = (pla_blend_morph_targets_job const *)job_data;
+        u32 first = chunk * PLA_MORPH_CHUNK;
+        u32 count = job->base->count - first < PLA_MORPH_CHUNK ? job->base->count - first : PLA_MORPH_CHUNK;
+        u32 comps = pla_GLTF_type_component_count[job->base->type];
+        f32 * out = job->out + (usize)first * comps;
+        //every accessor was checked before the jobs started.
+        pla_read_accessor_f32(job->gltf, job->base, first, count, out);
+
+        u32 target_count = job->primitive->target_count < job->weight_count ? job->primitive->target_count : job->weight_count;
+        for(u32 t = 0; t < target_count; ++t){
+                f32 weight = job->weights[t];
+                if(weight == 0) continue;
+                pla_morph_target const * target = &job->primitive->targets[t];
+                pla_accessor const * accessor = pla_find_attribute_accessor(job->gltf, target->attributes, target->attribute_count, job->name);
+                if(!accessor) continue;
+                f32 delta[PLA_MORPH_CHUNK * 4];
+                pla_read_accessor_f32(job->gltf, accessor, first, count, delta);
+                u32 delta_comps = pla_GLTF_type_component_count[accessor->type];
+                //a straight multiply add over the chunk, tangents have a vec3 delta on a vec4 so they step over w.
+                if(delta_comps == comps){
+                        for(u32 i = 0; i < count * comps; ++i) out[i] += weight * delta[i];
+                }else{
+                        for(u32 v = 0; v < count; ++v){
+                                for(u32 c = 0; c < delta_comps; ++c) out[v * comps + c] += weight * delta[v * delta_comps + c];
+                        }
+                }
+        }
+
+        if(job->name == pla_NORMAL || job->name == pla_TANGENT){
+                for(u32 v = 0; v < count; ++v){
+                        f32 * n = out + (usize)v * comps;
+                        f32 length = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+                        f32 inverse_length = length > 0 ? 1.0f / sqrtf(length) : 0;
+                        n[0] *= inverse_length;
+                        n[1] *= inverse_length;
+                        n[2] *= inverse_length;
+                }
+        }
+}
+
+//Blends the morph targets of a primitive on to one of its attributes: out = base + the sum of weights[t] * target t, normals and tangents are renormalized after.
+//weights can be the mesh defaults in pla_mesh.weights or an animation sample, targets past weight_count count as 0.
+//out holds count * components floats of the base attribute, the vertices are split in to jobs of PLA_MORPH_CHUNK.
+inline bool pla_blend_morph_targets(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_mesh_primitive_attribute_name name, f32 const * weights, u32 weight_count, f32 * out, pla_job_system const * jobs) NOEXCEPT{
+        if(!gltf || !primitive || !out || (weight_count && !weights)) return false;
+        if(name != pla_POSITION && name != pla_NORMAL && name != pla_TANGENT) return false;
+        pla_accessor const * base = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, name);
+        if(!base || pla_GLTF_type_component_count[base->type] < 3 || pla_GLTF_type_component_count[base->type] > 4) return false;
+        if(!pla_read_accessor_f32(gltf, base, 0, 0, out)) return false;
+        u32 target_count = primitive->target_count < weight_count ? primitive->target_count : weight_count;
+        for(u32 t = 0; t < target_count; ++t){
+                pla_morph_target const * target = &primitive->targets[t];
+                pla_accessor const * accessor = pla_find_attribute_accessor(gltf, target->attributes, target->attribute_count, name);
+                if(!accessor) continue;
+                if(accessor->count != base->count || pla_GLTF_type_component_count[accessor->type] != 3) return false;
+                if(!pla_read_accessor_f32(gltf, accessor, 0, 0, out)) return false;
+        }
+        pla_blend_morph_targets_job job = {gltf, primitive, name, base, weights, weight_count, out};
+        pla_parallel_for(jobs, (base->count + PLA_MORPH_CHUNK - 1) / PLA_MORPH_CHUNK, pla_blend_morph_targets_chunk, &job);
+        return true;
+}
+
+//JSON queries.
+//Read only lookups over the json tape for extras and extensions we don't parse, nothing is allocated or copied.
+
+typedef enum pla_json_type{
+        pla_json_type_none,
+        pla_json_type_null,
+        pla_json_type_bool,
+        pla_json_type_number,
+        pla_json_type_string,
+        pla_json_type_object,
+        pla_json_type_array,
+} pla_json_type;
+
+typedef struct pla_json_value{
+        //pla_json_type_none if the path isn't there.
+        pla_json_type type;
+        //tape index of the value, to query or walk from.
+        u32 index;
+        //the text of the value, strings are without their quotes and still escaped.
+        pla_str str;
+        //numbers, and 1 or 0 for bools.
+        f64 number;
+        //members of an object or items of an array.
+        u32 count;
+} pla_json_value;
+
+//The value that begins at tape index.
+inline pla_json_value pla_tape_get_value(pla_json_tape const * tape, u32 index) NOEXCEPT{
+        pla_json_value value = {.type = pla_json_type_none, .index = index};
+        if(!tape || index >= tape->entry_count) return value;
+        pla_tape_entry const * entry = &tape->entries[index];
+        switch(entry->token){
+        case pla_token_begin_object:
+                value.type = pla_json_type_object;
+                value.count = entry->count;
+                break;
+        case pla_token_begin_array:
+                value.type = pla_json_type_array;
+                value.count = entry->count;
+                break;
+        case pla_token_value:
+                value.str = pla_tape_get_str(tape, index);
+                if(tape->json[entry->offset] == '"') value.type = pla_json_type_string;
+                else if(pla_str_is_equal(value.str, "true") || pla_str_is_equal(value.str, "false")){
+                        value.type = pla_json_type_bool;
+                        value.number = value.str.data[0] == 't';
+                }
+                else if(pla_str_is_equal(value.str, "null")) value.type = pla_json_type_null;
+                else{
+                        value.type = pla_json_type_number;
+                        value.number = pla_str_to_f64(value.str);
+                }
+                break;
+        default:
+                break;
+        }
+        return value;
+}
+
+//Index of item i of the array that begins at entry array, PLA_INDEX_NONE if its not there.
+//each item is one jump no matter how big it is.
+inline u32 pla_tape_get_item(pla_json_tape const * tape, u32 array, u32 i) NOEXCEPT{
+        if(array >= tape->entry_count || tape->entries[array].token != pla_token_begin_array) return PLA_INDEX_NONE;
+        if(i >= tape->entries[array].count) return PLA_INDEX_NONE;
+        u32 item = array + 1;
+        for(; i; --i) item = pla_tape_next(tape, item);
+        return item;
+}
+
+//Follows a path like "extras.lod_bias" or "extensions.KHR_lights_punctual.lights[2].color[0]" from the value at tape index from.
+//keys with a '.' or '[' in them can't be in a path, use pla_tape_find_member for those.
+inline pla_json_value pla_tape_query(pla_json_tape const * tape, u32 from, c_str path) NOEXCEPT{
+        pla_json_value none = {.type = pla_json_type_none, .index = PLA_INDEX_NONE};
+        if(!tape || !tape->entries || !path) return none;
+        u32 at = from;
+        usize c = 0;
+        while(path[c] && at != PLA_INDEX_NONE){
+                if(path[c] == '.'){
+                        ++c;
+                        continue;
+                }
+                if(path[c] == '['){
+                        u32 i = 0;
+                        for(++c; (u8)(path[c] - '0') <= 9; ++c) i = i * 10 + (path[c] - '0');
+                        if(path[c] != ']') return none;
+                        ++c;
+                        at = pla_tape_get_item(tape, at, i);
+                        continue;
+                }
+                usize length = 0;
+                while(path[c + length] && path[c + length] != '.' && path[c + length] != '[') ++length;
+                if(at >= tape->entry_count || tape->entries[at].token != pla_token_begin_object) return none;
+                u32 end = tape->entries[at].end;
+                u32 member = PLA_INDEX_NONE;
+                for(u32 key = at + 1; key < end; key = pla_tape_next(tape, key + 1)){
+                        pla_str name = pla_tape_get_str(tape, key);
+                        if(name.length == length && memcmp(name.data, path + c, length) == 0){
+                                member = key + 1;
+                                break;
+                        }
+                }
+                at = member;
+                c += length;
+        }
+        if(at == PLA_INDEX_NONE) return none;
+        return pla_tape_get_value(tape, at);
+}
+
+//Follows a path from the root of the json, like "nodes[3].extras.lod_bias".
+inline pla_json_value pla_get(pla_GLTF const * gltf, c_str path) NOEXCEPT{
+        return pla_tape_query(&gltf->tape, 0, path);
+}
+
+//Follows a path from item index of a root array, pla_get_item(gltf, "nodes", node_index, "extras.lod_bias").
+inline pla_json_value pla_get_item(pla_GLTF const * gltf, c_str root_array, u32 index, c_str path) NOEXCEPT{
+        pla_json_value none = {.type = pla_json_type_none, .index = PLA_INDEX_NONE};
+        pla_json_tape const * tape = &gltf->tape;
+        if(!tape->entries) return none;
+        u32 item = pla_tape_get_item(tape, pla_tape_find_member(tape, 0, root_array), index);
+        if(item == PLA_INDEX_NONE) return none;
+        return pla_tape_query(tape, item, path);
+}
+
+//Content hashing.
+//Accessors and meshes are fingerprinted by what they hold, not where they are, so the same prop embedded in many files hashes the same and its conversion only has to happen once.
+
+#define PLA_HASH_PRIME_1 0x9E3779B185EBCA87ull
+#define PLA_HASH_PRIME_2 0xC2B2AE3D27D4EB4Full
+#define PLA_HASH_PRIME_3 0x165667B19E3779F9ull
+#define PLA_HASH_PRIME_4 0x85EBCA77C2B2AE63ull
+#define PLA_HASH_PRIME_5 0x27D4EB2F165667C5ull
+
+//XXH64, so hashes can be checked against any other xxhash implementation.
+typedef struct pla_hash_state{
+        u64 lanes[4];
+        u8 tail[32];
+        u32 tail_size;
+        u64 total_size;
+        u64 seed;
+} pla_hash_state;
+
+INTERNAL u64 pla_rotate_left_u64(u64 value, u32 bits){
+        return (value << bits) | (value >> (64 - bits));
+}
+
+INTERNAL u64 pla_hash_round(u64 lane, u64 input){
+        return pla_rotate_left_u64(lane + input * PLA_HASH_PRIME_2, 31) * PLA_HASH_PRIME_1;
+}
+
+INTERNAL u64 pla_hash_merge_round(u64 hash, u64 lane){
+        return (hash ^ pla_hash_round(0, lane)) * PLA_HASH_PRIME_1 + PLA_HASH_PRIME_4;
+}
+
+static inline u64 pla_read_u64(u8 const * data){
+        u64 value;
+        memcpy(&value, data, 8);
+        return value;
+}
+
+//The four lanes are independent so each 32 byte stripe is four multiplies the cpu runs side by side.
+static inline void pla_hash_stripes(u64 lanes[4], u8 const * data, usize stripe_count){
+        u64 lane0 = lanes[0], lane1 = lanes[1], lane2 = lanes[2], lane3 = lanes[3];
+        for(usize i = 0; i < stripe_count; ++i, data += 32){
+                lane0 = pla_hash_round(lane0, pla_read_u64(data));
+                lane1 = pla_hash_round(lane1, pla_read_u64(data + 8));
+                lane2 = pla_hash_round(lane2, pla_read_u64(data + 16));
+                lane3 = pla_hash_round(lane3, pla_read_u64(data + 24));
+        }
+        lanes[0] = lane0; lanes[1] = lane1; lanes[2] = lane2; lanes[3] = lane3;
+}
+
+inline void pla_hash_init(pla_hash_state * state, u64 seed) NOEXCEPT{
+        *state = (pla_hash_state){0};
+        state->seed = seed;
+        state->lanes[0] = seed + PLA_HASH_PRIME_1 + PLA_HASH_PRIME_2;
+        state->lanes[1] = seed + PLA_HASH_PRIME_2;
+        state->lanes[2] = seed;
+        state->lanes[3] = seed - PLA_HASH_PRIME_1;
+}
+
+inline void pla_hash_update(pla_hash_state * state, void const * data, usize size) NOEXCEPT{
+        u8 const * bytes = (u8 const *)data;
+        state->total_size += size;
+        if(state->tail_size + size < 32){
+                if(size) memcpy(state->tail + state->tail_size, bytes, size);
+                state->tail_size += (u32)size;
+                return;
+        }
+        if(state->tail_size){
+                usize fill = 32 - state->tail_size;
+                memcpy(state->tail + state->tail_size, bytes, fill);
+                pla_hash_stripes(state->lanes, state->tail, 1);
+                bytes += fill;
+                size -= fill;
+                state->tail_size = 0;
+        }
+        pla_hash_stripes(state->lanes, bytes, size / 32);
+        bytes += size & ~(usize)31;
+        size &= 31;
+        memcpy(state->tail, bytes, size);
+        state->tail_size = (u32)size;
+}
+
+inline u64 pla_hash_digest(pla_hash_state const * state) NOEXCEPT{
+        u64 hash;
+        if(state->total_size >= 32){
+                hash = pla_rotate_left_u64(state->lanes[0], 1) + pla_rotate_left_u64(state->lanes[1], 7) + pla_rotate_left_u64(state->lanes[2], 12) + pla_rotate_left_u64(state->lanes[3], 18);
+                for(u32 i = 0; i < 4; ++i) hash = pla_hash_merge_round(hash, state->lanes[i]);
+        }else{
+                hash = state->seed + PLA_HASH_PRIME_5;
+        }
+        hash += state->total_size;
+        u8 const * tail = state->tail;
+        u32 size = state->tail_size;
+        for(; size >= 8; size -= 8, tail += 8) hash = pla_rotate_left_u64(hash ^ pla_hash_round(0, pla_read_u64(tail)), 27) * PLA_HASH_PRIME_1 + PLA_HASH_PRIME_4;
+        if(size >= 4){
+                u32 word;
+                memcpy(&word, tail, 4);
+                hash = pla_rotate_left_u64(hash ^ (u64)word * PLA_HASH_PRIME_1, 23) * PLA_HASH_PRIME_2 + PLA_HASH_PRIME_3;
+                size -= 4;
+                tail += 4;
+        }
+        for(; size; --size, ++tail) hash = pla_rotate_left_u64(hash ^ *tail * PLA_HASH_PRIME_5, 11) * PLA_HASH_PRIME_1;
+        hash ^= hash >> 33;
+        hash *= PLA_HASH_PRIME_2;
+        hash ^= hash >> 29;
+        hash *= PLA_HASH_PRIME_3;
+        hash ^= hash >> 32;
+        return hash;
+}
+
+inline u64 pla_hash_bytes(void const * data, usize size, u64 seed) NOEXCEPT{
+        pla_hash_state state;
+        pla_hash_init(&state, seed);
+        pla_hash_update(&state, data, size);
+        return pla_hash_digest(&state);
+}
+
+//Feeds the type, the elements without their stride and the sparse substitutions of an accessor in to state.
+static inline bool pla_hash_accessor_contents(pla_GLTF const * gltf, pla_accessor const * accessor, pla_hash_state * state){
+        u32 header[5] = {(u32)accessor->component_type, (u32)accessor->type, accessor->count, accessor->normalized, accessor->sparse.count};
+        pla_hash_update(state, header, sizeof(header));
+        u32 element_size = pla_GLTF_component_type_byte_count[accessor->component_type] * pla_GLTF_type_component_count[accessor->type];
+        if(accessor->buffer_view != PLA_INDEX_NONE){
+                u32 stride = 0;
+                u8 const * data = pla_get_accessor_data(gltf, accessor, &stride);
+                if(!data) return false;
+                if(stride == element_size) pla_hash_update(state, data, (usize)element_size * accessor->count);
+                else for(u32 i = 0; i < accessor->count; ++i) pla_hash_update(state, data + (usize)stride * i, element_size);
+        }
+        pla_accessor_sparse const * sparse = &accessor->sparse;
+        if(sparse->count == 0) return true;
+        usize indices_size = 0;
+        usize values_size = 0;
+        u8 const * indices = pla_get_buffer_view_data(gltf, sparse->indices_buffer_view, &indices_size);
+        u8 const * values = pla_get_buffer_view_data(gltf, sparse->values_buffer_view, &values_size);
+        if(!indices || !values) return false;
+        usize index_size = (usize)pla_GLTF_component_type_byte_count[sparse->indices_component_type] * sparse->count;
+        usize value_size = (usize)element_size * sparse->count;
+        if(sparse->indices_byte_offset + index_size > indices_size || sparse->values_byte_offset + value_size > values_size) return false;
+        u32 index_type = sparse->indices_component_type;
+        pla_hash_update(state, &index_type, sizeof(index_type));
+        pla_hash_update(state, indices + sparse->indices_byte_offset, index_size);
+        pla_hash_update(state, values + sparse->values_byte_offset, value_size);
+        return true;
+}
+
+//Hash of what an accessor holds, the same data in any file, buffer view or stride hashes the same.
+inline bool pla_hash_accessor(pla_GLTF const * gltf, pla_accessor const * accessor, u64 * out_hash) NOEXCEPT{
+        pla_hash_state state;
+        pla_hash_init(&state, 0);
+        if(!pla_hash_accessor_contents(gltf, accessor, &state)) return false;
+        *out_hash = pla_hash_digest(&state);
+        return true;
+}
+
+typedef struct pla_hash_accessors_job{
+        pla_GLTF const * gltf;
+        u64 * hashes;
+} pla_hash_accessors_job;
+
+static inline void pla_hash_accessor_job(void * job_data, u32 index){
+        pla_hash_accessors_job const * job = (pla_hash_accessors_job const *)job_data;
+        if(!pla_hash_accessor(job->gltf, &job->gltf->accessors[index], &job->hashes[index])) job->hashes[index] = 0;
+}
+
+//Hashes every accessor, one job per accessor, out_hashes has room for gltf->accessors_size.
+//accessors that can't be read get a hash of 0 and it returns false, the rest are still hashed.
+inline bool pla_hash_accessors(pla_GLTF const * gltf, pla_job_system const * jobs, u64 * out_hashes) NOEXCEPT{
+        pla_hash_accessors_job job = {.gltf = gltf, .hashes = out_hashes};
+        pla_parallel_for(jobs, gltf->accessors_size, pla_hash_accessor_job, &job);
+        bool all_hashed = true;
+        for(u32 i = 0; i < gltf->accessors_size; ++i) all_hashed &= out_hashes[i] != 0;
+        return all_hashed;
+}
+
+//Hash of the geometry of a mesh from the hashes of its accessors (pla_hash_accessors).
+//materials are indices into their own file so they aren't part of it, two files with the same geometry and different materials share a hash.
+inline bool pla_hash_mesh(pla_GLTF const * gltf, pla_mesh const * mesh, u64 const * accessor_hashes, u64 * out_hash) NOEXCEPT{
+        pla_hash_state state;
+        pla_hash_init(&state, 0);
+        u32 primitive_count = mesh->primitive_count;
+        pla_hash_update(&state, &primitive_count, sizeof(primitive_count));
+        #define hash_accessor_index(index) { \
+                u64 hash = 0; \
+                if(index != PLA_INDEX_NONE){ \
+                        if(index >= gltf->accessors_size || accessor_hashes[index] == 0) return false; \
+                        hash = accessor_hashes[index]; \
+                } \
+                pla_hash_update(&state, &hash, sizeof(hash)); \
+        }
+        for(u32 i = 0; i < mesh->primitive_count; ++i){
+                pla_mesh_primitive const * primitive = &mesh->primitives[i];
+                u32 header[3] = {primitive->mode, primitive->attribute_count, primitive->target_count};
+                pla_hash_update(&state, header, sizeof(header));
+                for(u32 a = 0; a < primitive->attribute_count; ++a){
+                        pla_mesh_primitive_attribute const * attribute = &primitive->attributes[a];
+                        s32 name[2] = {(s32)attribute->name, attribute->set_index};
+                        pla_hash_update(&state, name, sizeof(name));
+                        hash_accessor_index(attribute->accessor);
+                }
+                hash_accessor_index(primitive->indices);
+                for(u32 t = 0; t < primitive->target_count; ++t){
+                        pla_morph_target const * target = &primitive->targets[t];
+                        u32 attribute_count = target->attribute_count;
+                        pla_hash_update(&state, &attribute_count, sizeof(attribute_count));
+                        for(u32 a = 0; a < target->attribute_count; ++a){
+                                s32 name[2] = {(s32)target->attributes[a].name, target->attributes[a].set_index};
+                                pla_hash_update(&state, name, sizeof(name));
+                                hash_accessor_index(target->attributes[a].accessor);
+                        }
+                }
+        }
+        #undef hash_accessor_index
+        u32 weight_count = mesh->weight_count;
+        pla_hash_update(&state, &weight_count, sizeof(weight_count));
+        if(weight_count) pla_hash_update(&state, mesh->weights, sizeof(f32) * weight_count);
+        *out_hash = pla_hash_digest(&state);
+        return true;
+}
+
+//Byte for byte check that two accessors hold the same thing, for when a 64 bit hash match isn't enough.
+inline bool pla_accessor_contents_are_equal(pla_GLTF const * gltf_a, pla_accessor const * a, pla_GLTF const * gltf_b, pla_accessor const * b) NOEXCEPT{
+        if(a->component_type != b->component_type || a->type != b->type || a->count != b->count || a->normalized != b->normalized || a->sparse.count != b->sparse.count) return false;
+        if(a->sparse.count && a->sparse.indices_component_type != b->sparse.indices_component_type) return false;
+        if((a->buffer_view == PLA_INDEX_NONE) != (b->buffer_view == PLA_INDEX_NONE)) return false;
+        u32 element_size = pla_GLTF_component_type_byte_count[a->component_type] * pla_GLTF_type_component_count[a->type];
+        if(a->buffer_view != PLA_INDEX_NONE){
+                u32 stride_a = 0;
+                u32 stride_b = 0;
+                u8 const * data_a = pla_get_accessor_data(gltf_a, a, &stride_a);
+                u8 const * data_b = pla_get_accessor_data(gltf_b, b, &stride_b);
+                if(!data_a || !data_b) return false;
+                if(stride_a == element_size && stride_b == element_size){
+                        if(memcmp(data_a, data_b, (usize)element_size * a->count) != 0) return false;
+                }
+                else for(u32 i = 0; i < a->count; ++i) if(memcmp(data_a + (usize)stride_a * i, data_b + (usize)stride_b * i, element_size) != 0) return false;
+        }
+        if(a->sparse.count == 0) return true;
+        usize sizes[4] = {0};
+        u8 const * indices_a = pla_get_buffer_view_data(gltf_a, a->sparse.indices_buffer_view, &sizes[0]);
+        u8 const * indices_b = pla_get_buffer_view_data(gltf_b, b->sparse.indices_buffer_view, &sizes[1]);
+        u8 const * values_a = pla_get_buffer_view_data(gltf_a, a->sparse.values_buffer_view, &sizes[2]);
+        u8 const * values_b = pla_get_buffer_view_data(gltf_b, b->sparse.values_buffer_view, &sizes[3]);
+        if(!indices_a || !indices_b || !values_a || !values_b) return false;
+        usize index_size = (usize)pla_GLTF_component_type_byte_count[a->sparse.indices_component_type] * a->sparse.count;
+        usize value_size = (usize)element_size * a->sparse.count;
+        if(a->sparse.indices_byte_offset + index_size > sizes[0] || b->sparse.indices_byte_offset + index_size > sizes[1]) return false;
+        if(a->sparse.values_byte_offset + value_size > sizes[2] || b->sparse.values_byte_offset + value_size > sizes[3]) return false;
+        return memcmp(indices_a + a->sparse.indices_byte_offset, indices_b + b->sparse.indices_byte_offset, index_size) == 0
+                && memcmp(values_a + a->sparse.values_byte_offset, values_b + b->sparse.values_byte_offset, value_size) == 0;
+}
+
+//Content addressed store shared by a batch of files: maps a content hash to the id of the first thing added with it, like where its converted output went.
+//open addressing over memory you give it, it takes up to three quarters of its capacity.
+typedef struct pla_content_store{
+        //0 marks an empty slot, a hash of 0 is stored as 1.
+        u64 * hashes;
+        u32 * ids;
+        //a power of two.
+        u32 capacity;
+        u32 count;
+} pla_content_store;
+
+//Bytes of memory a store that holds item_count items needs.
+inline usize pla_get_content_store_memory_size(u32 item_count) NOEXCEPT{
+        u32 capacity = 16;
+        while(capacity / 4 * 3 < item_count && capacity < (1u << 31)) capacity *= 2;
+        return get_aligned_size((usize)capacity * sizeof(u64)) + get_aligned_size((usize)capacity * sizeof(u32));
+}
+
+inline bool pla_init_content_store(u32 item_count, usize memory_size, void * memory, pla_content_store * out_store) NOEXCEPT{
+        if(!memory || !out_store || memory_size < pla_get_content_store_memory_size(item_count)) return false;
+        u32 capacity = 16;
+        while(capacity / 4 * 3 < item_count && capacity < (1u << 31)) capacity *= 2;
+        out_store->hashes = (u64 *)memory;
+        out_store->ids = (u32 *)((u8 *)memory + get_aligned_size((usize)capacity * sizeof(u64)));
+        out_store->capacity = capacity;
+        out_store->count = 0;
+        memset(out_store->hashes, 0, (usize)capacity * sizeof(u64));
+        return true;
+}
+
+static inline u32 pla_content_store_slot(pla_content_store const * store, u64 hash){
+        u32 mask = store->capacity - 1;
+        u32 slot = (u32)(hash ^ (hash >> 32)) & mask;
+        while(store->hashes[slot] && store->hashes[slot] != hash) slot = (slot + 1) & mask;
+        return slot;
+}
+
+//The id stored for hash, PLA_INDEX_NONE if nothing has it yet.
+inline u32 pla_content_store_find(pla_content_store const * store, u64 hash) NOEXCEPT{
+        hash = hash ? hash : 1;
+        u32 slot = pla_content_store_slot(store, hash);
+        return store->hashes[slot] ? store->ids[slot] : PLA_INDEX_NONE;
+}
+
+//Adds hash with id if its new and returns the id stored for hash, so a return that isn't id means the work is already done.
+//returns PLA_INDEX_NONE if the store is full.
+inline u32 pla_content_store_add(pla_content_store * store, u64 hash, u32 id) NOEXCEPT{
+        hash = hash ? hash : 1;
+        u32 slot = pla_content_store_slot(store, hash);
+        if(store->hashes[slot]) return store->ids[slot];
+        if(store->count >= store->capacity / 4 * 3) return PLA_INDEX_NONE;
+        store->hashes[slot] = hash;
+        store->ids[slot] = id;
+        ++store->count;
+        return id;
+}
+
+//Incremental re-parse.
+//An edited json is compared with the tape the gltf was parsed from item by item, only the root array items whose bytes changed are parsed again.
+
+typedef enum pla_root_array{
+        #define X(_, __, prop) pla_root_array_##prop,
+        ROOT_ARRAYS
+        #undef X
+        pla_root_array_MAX_ENUM,
+} pla_root_array;
+
+char const * const pla_root_array_names[pla_root_array_MAX_ENUM] = {
+        #define X(_, name, __) name,
+        ROOT_ARRAYS
+        #undef X
+};
+
+typedef struct pla_changed_item{
+        pla_root_array array;
+        u32 index;
+} pla_changed_item;
+
+//One past the last byte of the value that begins at tape index.
+static inline usize pla_tape_value_end_byte(pla_json_tape const * tape, u32 index){
+        pla_tape_entry const * last = &tape->entries[tape->entries[index].end];
+        if(last->token != pla_token_value) return (usize)last->offset + 1;
+        return (usize)last->offset + last->count + (tape->json[last->offset] == '"' ? 2 : 0);
+}
+
+static inline bool pla_tape_values_are_equal(pla_json_tape const * a, u32 a_index, pla_json_tape const * b, u32 b_index){
+        usize a_begin = a->entries[a_index].offset;
+        usize b_begin = b->entries[b_index].offset;
+        usize size = pla_tape_value_end_byte(a, a_index) - a_begin;
+        if(pla_tape_value_end_byte(b, b_index) - b_begin != size) return false;
+        return memcmp(a->json + a_begin, b->json + b_begin, size) == 0;
+}
+
+//Moves a pointer in to the old bytes of an item to the same place in its new bytes.
+static inline void pla_rebase_pointer(u8 const ** pointer, u8 const * old_base, usize size, u8 const * new_base){
+        if(*pointer && *pointer >= old_base && *pointer < old_base + size) *pointer = new_base + (*pointer - old_base);
+}
+
+//Points the strings of an item that didn't change at the new json.
+static inline void pla_rebase_item_strs(pla_GLTF * gltf, pla_root_array array, u32 index, u8 const * old_base, usize size, u8 const * new_base){
+        #define rebase(member) pla_rebase_pointer(&member.data, old_base, size, new_base)
+        switch(array){
+                case pla_root_array_scenes: rebase(gltf->scenes[index].name); break;
+                case pla_root_array_nodes: rebase(gltf->nodes[index].name); break;
+                case pla_root_array_meshes: rebase(gltf->meshes[index].name); break;
+                case pla_root_array_buffers: rebase(gltf->buffers[index].uri); break;
+                case pla_root_array_skins: rebase(gltf->skins[index].name); break;
+                case pla_root_array_animations: rebase(gltf->animations[index].name); break;
+                case pla_root_array_materials: rebase(gltf->materials[index].name); break;
+                case pla_root_array_textures: rebase(gltf->textures[index].name); break;
+                case pla_root_array_samplers: rebase(gltf->samplers[index].name); break;
+                case pla_root_array_images:
+                        rebase(gltf->images[index].name);
+                        rebase(gltf->images[index].uri);
+                        rebase(gltf->images[index].mime_type);
+                        break;
+                default: break;
+        }
+        #undef rebase
+}
+
+//Parses item index of a root array from the json at its tape entry, with out_state->arena null it only counts the pool memory it needs.
+static inline bool pla_reparse_item(parse_state p, GLTF_state * out_state, pla_root_array array, u32 index){
+        bool has_space = out_state->arena != PLA_NULL;
+        switch(array){
+                #define X(_, __, prop) case pla_root_array_##prop: return parse_##prop(p, has_space, out_state, has_space ? &out_state->out_gltf->prop[index] : PLA_NULL) != SIZE_MAX;
+                ROOT_ARRAYS
+                #undef X
+                default: return false;
+        }
+}
+
+//Updates gltf, parsed from an earlier version of the document with its tape, to the edited document in data. tape is a tape of the new json chunk (pla_build_json_tape).
+//its called twice like pla_parse_gltf_arena_style: with patch_arena null it puts the pool memory the changed items need in patch_sizes, then with an arena set up from them (pla_set_arena) it applies the edit.
+//changed_count is the capacity of changed_items going in and how many items changed coming out, changed_items can be null.
+//returns false if anything outside the root array items changed or an array grew or shrank, that takes a full parse. if the second call fails gltf is half updated and needs a full parse too.
+//items that didn't change keep their arena memory and runtime fields, their strings move to the new json. changed items are parsed in to the patch arena and the memory they had is left unused until the next full parse.
+//gltf takes the new json, tape and bin chunk, so the old data can be freed after the second call. bin data isn't compared, content hashes tell you which converted outputs are still good.
+inline bool pla_reparse_gltf(u32 data_size, u8 const * data, pla_json_tape const * tape, pla_GLTF_sizes * patch_sizes, pla_GLTF_arena * patch_arena, pla_GLTF * gltf, u32 * changed_count, pla_changed_item * changed_items) NOEXCEPT{
+        if(!tape || !patch_sizes || !gltf || !changed_count) return false;
+        pla_json_tape const * old_tape = &gltf->tape;
+        if(!old_tape->entries || !tape->entries) return false;
+        pla_chunk json_chunk;
+        pla_chunk binary_chunk;
+        if(!pla_get_glb_chunks(data_size, data, &json_chunk, &binary_chunk)) return false;
+        if(tape->json != json_chunk.data || tape->json_size != json_chunk.size) return false;
+        if(old_tape->entries[0].token != pla_token_begin_object || tape->entries[0].token != pla_token_begin_object) return false;
+        if(old_tape->entries[0].count != tape->entries[0].count) return false;
+
+        GLTF_state out_state = {
+                .sizes = {0},
+                .in_sizes = patch_sizes,
+                .arena = patch_arena,
+                .out_gltf = gltf,
+        };
+        u32 tape_cursor = 0;
+        parse_state p = {.c = 0, .size = json_chunk.size, .data = json_chunk.data, .tape = tape, .tape_cursor = &tape_cursor};
+        u32 capacity = *changed_count;
+        u32 changed = 0;
+        u32 old_key = 1;
+        u32 key = 1;
+        for(u32 member = 0; member < tape->entries[0].count; ++member, old_key = pla_tape_next(old_tape, old_key + 1), key = pla_tape_next(tape, key + 1)){
+                pla_str name = pla_tape_get_str(tape, key);
+                pla_str old_name = pla_tape_get_str(old_tape, old_key);
+                if(name.length != old_name.length || memcmp(name.data, old_name.data, name.length) != 0) return false;
+                u32 old_value = old_key + 1;
+                u32 value = key + 1;
+                pla_root_array array = pla_root_array_MAX_ENUM;
+                for(u32 i = 0; i < pla_root_array_MAX_ENUM; ++i) if(pla_str_is_equal(name, pla_root_array_names[i])) array = (pla_root_array)i;
+                if(array == pla_root_array_MAX_ENUM || tape->entries[value].token != pla_token_begin_array){
+                        if(!pla_tape_values_are_equal(old_tape, old_value, tape, value)) return false;
+                        if(patch_arena && pla_str_is_equal(name, "asset")){
+                                u8 const * old_base = old_tape->json + old_tape->entries[old_value].offset;
+                                u8 const * new_base = tape->json + tape->entries[value].offset;
+                                usize size = pla_tape_value_end_byte(tape, value) - tape->entries[value].offset;
+                                pla_rebase_pointer(&gltf->asset.generator.data, old_base, size, new_base);
+                                pla_rebase_pointer(&gltf->asset.version.data, old_base, size, new_base);
+                        }
+                        continue;
+                }
+                if(old_tape->entries[old_value].token != pla_token_begin_array || old_tape->entries[old_value].count != tape->entries[value].count) return false;
+                u32 old_item = old_value + 1;
+                u32 item = value + 1;
+                for(u32 index = 0; index < tape->entries[value].count; ++index, old_item = pla_tape_next(old_tape, old_item), item = pla_tape_next(tape, item)){
+                        if(pla_tape_values_are_equal(old_tape, old_item, tape, item)){
+                                u8 const * old_base = old_tape->json + old_tape->entries[old_item].offset;
+                                u8 const * new_base = tape->json + tape->entries[item].offset;
+                                usize size = pla_tape_value_end_byte(tape, item) - tape->entries[item].offset;
+                                if(patch_arena) pla_rebase_item_strs(gltf, array, index, old_base, size, new_base);
+                                continue;
+                        }
+                        //parsers start after the byte p.c is on.
+                        p.c = tape->entries[item].offset - 1;
+                        if(!pla_reparse_item(p, &out_state, array, index)) return false;
+                        if(changed_items && changed < capacity) changed_items[changed] = (pla_changed_item){.array = array, .index = index};
+                        ++changed;
+                }
+        }
+        *changed_count = changed;
+        if(!patch_arena){
+                *patch_sizes = out_state.sizes;
+                return true;
+        }
+
+        //the runtime pointers in to the old bin chunk move to the new one.
+        if(gltf->bin && binary_chunk.data){
+                for(u32 i = 0; i < gltf->images_size; ++i) if(gltf->images[i].data >= gltf->bin && gltf->images[i].data < gltf->bin + gltf->bin_size){
+                        usize offset = gltf->images[i].data - gltf->bin;
+                        gltf->images[i].data = offset + gltf->images[i].data_size <= binary_chunk.size ? binary_chunk.data + offset : PLA_NULL;
+                }
+        }
+        gltf->json = json_chunk.data;
+        gltf->json_size = json_chunk.size;
+        gltf->tape = *tape;
+        gltf->bin = binary_chunk.data;
+        gltf->bin_size = binary_chunk.size;
+        if(gltf->buffers_size && !gltf->buffers[0].uri.data && binary_chunk.data){
+                gltf->buffers[0].data = binary_chunk.data;
+                if(gltf->buffers[0].byte_length > binary_chunk.size) return false;
+        }
+        return true;
+}
+
+//Async loading.
+//A load is a chain of stages (read, parse, resolve, decode, convert) that each go to the caller's executor as their own step, so many assets can overlap their reads with other assets' cpu work and the thread that starts a load never waits on it.
+
+typedef enum pla_load_stage{
+        pla_load_stage_read,
+        pla_load_stage_parse,
+        pla_load_stage_resolve,
+        pla_load_stage_decode,
+        pla_load_stage_convert,
+        pla_load_stage_done,
+        pla_load_stage_failed,
+        pla_load_stage_cancelled,
+} pla_load_stage;
+
+typedef struct pla_executor{
+        void * user_data;
+        //has to run step(step_data) later on any thread. stage is the kind of work so reads can go to io threads, lower priorities should run first.
+        void (*submit)(void * user_data, pla_load_stage stage, u32 priority, void (*step)(void * step_data), void * step_data);
+} pla_executor;
+
+typedef struct pla_load pla_load;
+
+struct pla_load{
+        //set before pla_start_load.
+        pla_str uri;
+        //reads the file and the buffers it points to.
+        pla_file_system const * file_system;
+        pla_allocator allocator;
+        //null runs every stage on the thread that calls pla_start_load.
+        pla_executor const * executor;
+        //for the jobs inside a stage.
+        pla_job_system const * jobs;
+        u32 priority;
+        //optional last stage, turns accessors in to engine data once the buffers are ready, returning false fails the load.
+        bool (*convert)(void * user_data, pla_GLTF * gltf, pla_job_system const * jobs);
+        //called once with the stage done, failed or cancelled, the load isn't touched after so it can be freed in here.
+        void (*on_done)(void * user_data, pla_load * load);
+        void * user_data;
+
+        //filled in by the stages.
+        pla_GLTF gltf;
+        //why the parse stage failed.
+        pla_parse_error parse_error;
+        //a pla_load_stage, read it with pla_get_load_stage while the load is running.
+        u32 stage;
+        u32 cancelled;
+        u8 const * file_data;
+        usize file_size;
+        void * file_handle;
+        u8 * parse_memory;
+        usize parse_memory_size;
+        u8 * buffer_memory;
+        usize buffer_memory_size;
+        u8 * meshopt_memory;
+        usize meshopt_memory_size;
+};
+
+inline pla_load_stage pla_get_load_stage(pla_load const * load) NOEXCEPT{
+        return (pla_load_stage)pla_atomic_load(&load->stage);
+}
+
+//Asks a running load to stop, it stops before its next stage and finishes as cancelled.
+inline void pla_cancel_load(pla_load * load) NOEXCEPT{
+        pla_atomic_store(&load->cancelled, 1u);
+}
+
+//The priority the remaining stages are submitted with, for when an asset is needed sooner.
+inline void pla_set_load_priority(pla_load * load, u32 priority) NOEXCEPT{
+        pla_atomic_store(&load->priority, priority);
+}
+
+static inline void pla_free_load_memory(pla_load * load, u8 ** memory, usize * size){
+        if(*memory && load->allocator.free_sized) load->allocator.free_sized(load->allocator.user_data, *memory, *size);
+        else if(*memory && load->allocator.free) load->allocator.free(load->allocator.user_data, *memory);
+        *memory = PLA_NULL;
+        *size = 0;
+}
+
+static inline bool pla_allocate_load_memory(pla_load * load, usize size, u8 ** out_memory, usize * out_size){
+        *out_memory = PLA_NULL;
+        *out_size = size;
+        if(size == 0) return true;
+        if(!load->allocator.allocate) return false;
+        *out_memory = (u8 *)load->allocator.allocate(load->allocator.user_data, size);
+        return *out_memory != PLA_NULL;
+}
+
+//Closes the files and frees the memory of a finished load, the gltf is gone after this.
+inline void pla_release_load(pla_load * load) NOEXCEPT{
+        pla_file_system const * file_system = load->file_system;
+        if(load->gltf.buffers) pla_release_buffers(&load->gltf, file_system);
+        pla_free_load_memory(load, &load->meshopt_memory, &load->meshopt_memory_size);
+        pla_free_load_memory(load, &load->buffer_memory, &load->buffer_memory_size);
+        pla_free_load_memory(load, &load->parse_memory, &load->parse_memory_size);
+        if(load->file_data && file_system && file_system->close) file_system->close(file_system->user_data, load->file_handle, load->file_data, load->file_size);
+        load->file_data = PLA_NULL;
+        load->file_size = 0;
+        load->file_handle = PLA_NULL;
+        load->gltf = (pla_GLTF){0};
+}
+
+static void pla_run_load_stage(void * step_data);
+
+static inline void pla_submit_load_stage(pla_load * load, pla_load_stage stage){
+        pla_atomic_store(&load->stage, (u32)stage);
+        if(load->executor && load->executor->submit) load->executor->submit(load->executor->user_data, stage, pla_atomic_load(&load->priority), pla_run_load_stage, load);
+        else pla_run_load_stage(load);
+}
+
+static inline void pla_finish_load(pla_load * load, pla_load_stage stage){
+        if(stage != pla_load_stage_done) pla_release_load(load);
+        pla_atomic_store(&load->stage, (u32)stage);
+        if(load->on_done) load->on_done(load->user_data, load);
+}
+
+static inline bool pla_run_load_read(pla_load * load){
+        pla_file_system const * file_system = load->file_system;
+        if(!file_system || !file_system->open) return false;
+        if(!file_system->open(file_system->user_data, load->uri, &load->file_data, &load->file_size, &load->file_handle)){
+                load->file_data = PLA_NULL;
+                return false;
+        }
+        return load->file_size <= UINT32_MAX;
+}
+
+static inline bool pla_run_load_parse(pla_load * load){
+        size_t size = 0;
+        if(!pla_parse_GLTF_with_error((u32)load->file_size, load->file_data, &size, PLA_NULL, PLA_NULL, &load->parse_error)) return false;
+        if(!pla_allocate_load_memory(load, size, &load->parse_memory, &load->parse_memory_size)) return false;
+        if(pla_parse_GLTF_with_error((u32)load->file_size, load->file_data, &size, load->parse_memory, &load->gltf, &load->parse_error)) return true;
+        //a half parsed gltf can't be released.
+        load->gltf = (pla_GLTF){0};
+        return false;
+}
+
+static inline bool pla_run_load_resolve(pla_load * load){
+        if(!pla_allocate_load_memory(load, pla_get_buffer_memory_size(&load->gltf), &load->buffer_memory, &load->buffer_memory_size)) return false;
+        return pla_resolve_buffers(&load->gltf, load->file_system, load->jobs, load->buffer_memory_size, load->buffer_memory);
+}
+
+static inline bool pla_run_load_decode(pla_load * load){
+        if(!pla_allocate_load_memory(load, pla_get_meshopt_memory_size(&load->gltf), &load->meshopt_memory, &load->meshopt_memory_size)) return false;
+        return pla_decode_meshopt_buffer_views(&load->gltf, load->jobs, load->meshopt_memory_size, load->meshopt_memory);
+}
+
+//One stage of a load, it submits the next one as its last action.
+static void pla_run_load_stage(void * step_data){
+        pla_load * load = (pla_load *)step_data;
+        if(pla_atomic_load(&load->cancelled)){
+                pla_finish_load(load, pla_load_stage_cancelled);
+                return;
+        }
+        pla_load_stage stage = (pla_load_stage)pla_atomic_load(&load->stage);
+        bool ok = false;
+        switch(stage){
+                case pla_load_stage_read: ok = pla_run_load_read(load); break;
+                case pla_load_stage_parse: ok = pla_run_load_parse(load); break;
+                case pla_load_stage_resolve: ok = pla_run_load_resolve(load); break;
+                case pla_load_stage_decode: ok = pla_run_load_decode(load); break;
+                case pla_load_stage_convert: ok = !load->convert || load->convert(load->user_data, &load->gltf, load->jobs); break;
+                default: break;
+        }
+        if(!ok){
+                pla_finish_load(load, pla_load_stage_failed);
+                return;
+        }
+        if(stage == pla_load_stage_convert) pla_finish_load(load, pla_load_stage_done);
+        else pla_submit_load_stage(load, (pla_load_stage)(stage + 1));
+}
+
+//Starts loading load->uri, the first stage is submitted before it returns and on_done says how it ended.
+//the load has to stay where it is until on_done is called, after a done load pla_release_load frees what it holds.
+inline void pla_start_load(pla_load * load) NOEXCEPT{
+        load->gltf = (pla_GLTF){0};
+        pla_reset_parse_error(&load->parse_error);
+        load->cancelled = 0;
+        load->file_data = PLA_NULL;
+        load->file_size = 0;
+        load->file_handle = PLA_NULL;
+        load->parse_memory = load->buffer_memory = load->meshopt_memory = PLA_NULL;
+        load->parse_memory_size = load->buffer_memory_size = load->meshopt_memory_size = 0;
+        pla_submit_load_stage(load, pla_load_stage_read);
+}
 
 // inline CONSTEXPR bool pla_parse_GLTF(u32 raw_gltf_size, u8 const *raw_gltf_data, pla_GLTF *gltf, pla_allocator allocator) NOEXCEPT{
 //         if (allocator.allocate && allocator.free) gltf->allocator = allocator; 
@@ -0,0 +1,171 @@
+#pragma once
+
+//C++ layer over plastic_gltf.h: typed accessor views and a visitor that picks the component type and count once per accessor, so the loops you hand it are compiled for one element type and don't branch per element.
+
+#include "plastic_gltf.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace pla {
+
+//Contiguous range over an array the gltf owns, like std::span.
+template<typename T>
+struct span{
+        T * items = nullptr;
+        u32 count = 0;
+
+        constexpr T * begin() const noexcept { return items; }
+        constexpr T * end() const noexcept { return items + count; }
+        constexpr T & operator[](u32 i) const noexcept { return items[i]; }
+        constexpr T * data() const noexcept { return items; }
+        constexpr u32 size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+};
+
+//pla::meshes(gltf), pla::accessors(gltf), ... for every root array.
+#define X(type, _, prop) \
+        inline span<std::remove_pointer_t<type> const> prop(pla_GLTF const & gltf) noexcept { return {gltf.prop, gltf.prop##_size}; } \
+        inline span<std::remove_pointer_t<type>> prop(pla_GLTF & gltf) noexcept { return {gltf.prop, gltf.prop##_size}; }
+ROOT_ARRAYS
+#undef X
+
+inline span<pla_mesh_primitive const> primitives(pla_mesh const & mesh) noexcept { return {mesh.primitives, mesh.primitive_count}; }
+inline span<pla_mesh_primitive_attribute const> attributes(pla_mesh_primitive const & primitive) noexcept { return {primitive.attributes, primitive.attribute_count}; }
+inline span<pla_morph_target const> targets(pla_mesh_primitive const & primitive) noexcept { return {primitive.targets, primitive.target_count}; }
+
+//The C++ type of each component type, component_t<pla_GLTF_component_type_u16> is u16.
+template<pla_GLTF_component_type> struct component;
+template<> struct component<pla_GLTF_component_type_s8> { using type = s8; };
+template<> struct component<pla_GLTF_component_type_u8> { using type = u8; };
+template<> struct component<pla_GLTF_component_type_s16> { using type = s16; };
+template<> struct component<pla_GLTF_component_type_u16> { using type = u16; };
+template<> struct component<pla_GLTF_component_type_u32> { using type = u32; };
+template<> struct component<pla_GLTF_component_type_f32> { using type = f32; };
+template<pla_GLTF_component_type component_type>
+using component_t = typename component<component_type>::type;
+
+template<typename T> constexpr pla_GLTF_component_type component_type_of = pla_GLTF_component_type_MAX_ENUM;
+template<> constexpr pla_GLTF_component_type component_type_of<s8> = pla_GLTF_component_type_s8;
+template<> constexpr pla_GLTF_component_type component_type_of<u8> = pla_GLTF_component_type_u8;
+template<> constexpr pla_GLTF_component_type component_type_of<s16> = pla_GLTF_component_type_s16;
+template<> constexpr pla_GLTF_component_type component_type_of<u16> = pla_GLTF_component_type_u16;
+template<> constexpr pla_GLTF_component_type component_type_of<u32> = pla_GLTF_component_type_u32;
+template<> constexpr pla_GLTF_component_type component_type_of<f32> = pla_GLTF_component_type_f32;
+
+//Maps a normalized integer to [0, 1] or [-1, 1] the way the spec does, floats go through as they are.
+template<typename T>
+constexpr f32 normalize(T value) noexcept{
+        if constexpr(std::is_same_v<T, s8>) return value / 127.0f < -1.0f ? -1.0f : value / 127.0f;
+        else if constexpr(std::is_same_v<T, s16>) return value / 32767.0f < -1.0f ? -1.0f : value / 32767.0f;
+        else if constexpr(std::is_same_v<T, u8>) return value / 255.0f;
+        else if constexpr(std::is_same_v<T, u16>) return value / 65535.0f;
+        else return (f32)value;
+}
+
+//Strided view over the elements of an accessor with N components of type T, elements are read with memcpy so unaligned buffers are fine.
+//a scalar view gives T, everything else gives std::array<T, N>.
+template<typename T, u32 N>
+struct accessor_view{
+        using element = std::conditional_t<N == 1, T, std::array<T, N>>;
+        static constexpr pla_GLTF_component_type component_type = component_type_of<T>;
+        static constexpr u32 component_count = N;
+
+        u8 const * bytes = nullptr;
+        u32 stride = 0;
+        u32 count = 0;
+        bool normalized = false;
+
+        element operator[](u32 i) const noexcept{
+                element value;
+                memcpy(&value, bytes + (usize)stride * i, sizeof(T) * N);
+                return value;
+        }
+
+        struct iterator{
+                u8 const * at;
+                u32 stride;
+                element operator*() const noexcept{
+                        element value;
+                        memcpy(&value, at, sizeof(T) * N);
+                        return value;
+                }
+                iterator & operator++() noexcept { at += stride; return *this; }
+                bool operator==(iterator const & other) const noexcept { return at == other.at; }
+                bool operator!=(iterator const & other) const noexcept { return at != other.at; }
+        };
+
+        iterator begin() const noexcept { return {bytes, stride}; }
+        iterator end() const noexcept { return {bytes + (usize)stride * count, stride}; }
+        u32 size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+        //true when the elements are packed back to back and bytes can be used as a T array.
+        bool is_packed() const noexcept { return stride == sizeof(T) * N; }
+        explicit operator bool() const noexcept { return bytes != nullptr; }
+};
+
+//A view of accessor if it really holds N components of T, otherwise an empty view.
+//sparse accessors and accessors without a buffer view aren't plain bytes, use pla_read_accessor_f32 for those.
+template<typename T, u32 N>
+accessor_view<T, N> view_accessor(pla_GLTF const & gltf, pla_accessor const & accessor) noexcept{
+        accessor_view<T, N> view;
+        if(accessor.component_type != component_type_of<T> || accessor.type < 0 || accessor.type >= pla_GLTF_type_MAX_ENUM) return view;
+        if(pla_GLTF_type_component_count[accessor.type] != N) return view;
+        if(accessor.sparse.count || accessor.buffer_view == PLA_INDEX_NONE) return view;
+        u32 stride = 0;
+        u8 const * bytes = pla_get_accessor_data(&gltf, &accessor, &stride);
+        if(!bytes) return view;
+        view.bytes = bytes;
+        view.stride = stride;
+        view.count = accessor.count;
+        view.normalized = accessor.normalized;
+        return view;
+}
+
+template<typename T, typename F>
+bool visit_accessor_components(pla_GLTF const & gltf, pla_accessor const & accessor, F && f){
+        #define visit_count(N) { auto view = view_accessor<T, N>(gltf, accessor); if(!view) return false; f(view); return true; }
+        switch(accessor.type){
+                case pla_GLTF_SCALAR: visit_count(1)
+                case pla_GLTF_VEC2: visit_count(2)
+                case pla_GLTF_VEC3: visit_count(3)
+                case pla_GLTF_VEC4: visit_count(4)
+                case pla_GLTF_MAT2: visit_count(4)
+                case pla_GLTF_MAT3: visit_count(9)
+                case pla_GLTF_MAT4: visit_count(16)
+                default: return false;
+        }
+        #undef visit_count
+}
+
+//Calls f once with the accessor_view<T, N> that matches the accessor, f is usually a generic lambda so each of the 42 combinations gets its own loop.
+//returns false without calling f if the accessor can't be viewed.
+//mat2 of 1 byte components and mat3 of 1 or 2 byte components have padded columns in the spec, they're viewed without the padding like the rest of the header.
+template<typename F>
+bool visit_accessor(pla_GLTF const & gltf, pla_accessor const & accessor, F && f){
+        switch(accessor.component_type){
+                case pla_GLTF_component_type_s8: return visit_accessor_components<s8>(gltf, accessor, f);
+                case pla_GLTF_component_type_u8: return visit_accessor_components<u8>(gltf, accessor, f);
+                case pla_GLTF_component_type_s16: return visit_accessor_components<s16>(gltf, accessor, f);
+                case pla_GLTF_component_type_u16: return visit_accessor_components<u16>(gltf, accessor, f);
+                case pla_GLTF_component_type_u32: return visit_accessor_components<u32>(gltf, accessor, f);
+                case pla_GLTF_component_type_f32: return visit_accessor_components<f32>(gltf, accessor, f);
+                default: return false;
+        }
+}
+
+//The accessor of an attribute of a primitive, nullptr if the primitive doesn't have it.
+inline pla_accessor const * find_attribute(pla_GLTF const & gltf, pla_mesh_primitive const & primitive, pla_mesh_primitive_attribute_name name, s8 set_index = 0) noexcept{
+        for(pla_mesh_primitive_attribute const & attribute : attributes(primitive)){
+                if(attribute.name != name || attribute.set_index != set_index) continue;
+                return attribute.accessor < gltf.accessors_size ? &gltf.accessors[attribute.accessor] : nullptr;
+        }
+        return nullptr;
+}
+
+inline std::string_view to_string_view(pla_str str) noexcept { return {(char const *)str.data, str.length}; }
+
+}
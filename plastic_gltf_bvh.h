@@ -0,0 +1,914 @@
+#pragma once
+
+//Optional module over plastic_gltf.h: binned SAH bounding volume hierarchies over the triangles of mesh primitives, a top level one over the mesh instances of a scene, and ray and closest point queries on them.
+//what a build keeps goes in to a pla_linear_allocator the caller owns, temporaries come from the calling thread's scratch.
+
+#include "plastic_gltf.h"
+
+#include <float.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Bounding volume hierarchies.
+//Nodes split their items at the best of PLA_BVH_BINS planes on each axis by surface area, a leaf is kept when testing its items is cheaper than another level.
+
+#define PLA_BVH_BINS 16
+//past this depth splits are at the middle of the range, so no tree gets deeper than PLA_BVH_MAX_DEPTH and the query stacks are fixed size.
+#define PLA_BVH_SAH_DEPTH 64
+#define PLA_BVH_MAX_DEPTH 96
+//builds over more items than this split their top levels on the calling thread and build the subtrees under them as jobs.
+#define PLA_BVH_PARALLEL_ITEMS 16384
+#define PLA_BVH_MAX_TASKS 256
+#define PLA_BVH_CHUNK 4096
+
+//32 bytes, two to a cache line. inner nodes have a count of 0 and their children at nodes[first] and nodes[first + 1], a leaf has items[first, first + count).
+//children always start at an even index so both of them come in with one line.
+typedef struct pla_bvh_node{
+        f32 min[3];
+        u32 first;
+        f32 max[3];
+        u32 count;
+} pla_bvh_node;
+
+typedef struct pla_bvh{
+        //nodes[0] is the root and nodes[1] is padding that keeps the pairs of children on their cache lines, a bvh without items has no nodes.
+        pla_bvh_node * nodes;
+        u32 node_count;
+        u32 item_count;
+        //what each leaf slot holds, the index of a triangle of the primitive or of an instance of the scene.
+        u32 * items;
+        //the corners of the triangle in each slot, 9 floats each, so leaves are tested without going through the indices. null over instances.
+        f32 * triangles;
+} pla_bvh;
+
+typedef struct pla_bvh_config{
+        //leaves hold at most this many items unless they can't be split.
+        u32 max_leaf_size;
+        //cost of visiting a node relative to testing an item, higher gives shallower trees with bigger leaves.
+        f32 traversal_cost;
+} pla_bvh_config;
+
+INTERNAL pla_bvh_config pla_default_bvh_config(void) NOEXCEPT{
+        pla_bvh_config config = {};
+        config.max_leaf_size = 4;
+        config.traversal_cost = 1.0f;
+        return config;
+}
+
+//An instance of a mesh in a scene, the transforms are column major.
+typedef struct pla_bvh_instance{
+        u32 node;
+        u32 mesh;
+        f32 local_to_world[16];
+        f32 world_to_local[16];
+} pla_bvh_instance;
+
+//A bvh per primitive of every mesh, mesh m's primitives start at bvhs[first[m]].
+typedef struct pla_mesh_bvhs{
+        pla_bvh * bvhs;
+        u32 * first;
+        u32 count;
+} pla_mesh_bvhs;
+
+typedef struct pla_scene_bvh{
+        pla_mesh_bvhs meshes;
+        //over the world bounds of the instances, its items index instances.
+        pla_bvh top;
+        pla_bvh_instance * instances;
+        u32 instance_count;
+} pla_scene_bvh;
+
+typedef struct pla_bvh_hit{
+        f32 t;
+        //the point is (1 - u - v) * corner 0 + u * corner 1 + v * corner 2.
+        f32 u;
+        f32 v;
+        //the triangle.
+        u32 item;
+} pla_bvh_hit;
+
+typedef struct pla_scene_bvh_hit{
+        pla_bvh_hit hit;
+        u32 instance;
+        //in the instance's mesh.
+        u32 primitive;
+} pla_scene_bvh_hit;
+
+typedef struct pla_bvh_closest_point{
+        f32 point[3];
+        f32 distance_squared;
+        u32 item;
+} pla_bvh_closest_point;
+
+//Bytes a bvh over item_count items takes from its arena, with the alignment padding. nodes get room for the most a tree can have, 2 * item_count - 1, and the padding node.
+inline usize pla_get_bvh_memory_size(u32 item_count, bool triangles) NOEXCEPT{
+        if(!item_count) return 0;
+        usize size = sizeof(pla_bvh_node) * 2 * (usize)item_count + 64;
+        size += sizeof(u32) * (usize)item_count + 16;
+        if(triangles) size += sizeof(f32) * 9 * (usize)item_count + 16;
+        return size;
+}
+
+static inline bool pla_allocate_bvh(pla_linear_allocator * arena, u32 item_count, bool triangles, pla_bvh * out_bvh){
+        memset(out_bvh, 0, sizeof(*out_bvh));
+        out_bvh->item_count = item_count;
+        if(!item_count) return true;
+        out_bvh->nodes = (pla_bvh_node *)pla_linear_allocate(arena, sizeof(pla_bvh_node) * 2 * (usize)item_count, 64);
+        out_bvh->items = (u32 *)pla_linear_allocate(arena, sizeof(u32) * (usize)item_count, 16);
+        if(triangles) out_bvh->triangles = (f32 *)pla_linear_allocate(arena, sizeof(f32) * 9 * (usize)item_count, 16);
+        return out_bvh->nodes && out_bvh->items && (!triangles || out_bvh->triangles);
+}
+
+//Bounds with a padding lane, so growing one is a four wide min and max the compiler vectorizes.
+typedef struct pla_bvh_box{
+        f32 min[4];
+        f32 max[4];
+} pla_bvh_box;
+
+static inline void pla_bvh_empty_box(pla_bvh_box * box){
+        for(u32 i = 0; i < 4; ++i){
+                box->min[i] = FLT_MAX;
+                box->max[i] = -FLT_MAX;
+        }
+}
+
+//grows a copy and writes it back so the compiler doesn't have to assume the two overlap.
+static inline void pla_bvh_grow_box(pla_bvh_box * box, pla_bvh_box const * other){
+        pla_bvh_box grown = *box;
+        for(u32 i = 0; i < 4; ++i){
+                grown.min[i] = other->min[i] < grown.min[i] ? other->min[i] : grown.min[i];
+                grown.max[i] = other->max[i] > grown.max[i] ? other->max[i] : grown.max[i];
+        }
+        *box = grown;
+}
+
+static inline void pla_bvh_grow_box_by(pla_bvh_box * box, f32 const * min, f32 const * max){
+        pla_bvh_box other = {{min[0], min[1], min[2], 0}, {max[0], max[1], max[2], 0}};
+        pla_bvh_grow_box(box, &other);
+}
+
+//half the surface area, which is all the cost ratios need.
+static inline f32 pla_bvh_half_area(pla_bvh_box const * box){
+        f32 x = box->max[0] - box->min[0];
+        f32 y = box->max[1] - box->min[1];
+        f32 z = box->max[2] - box->min[2];
+        return x * y + y * z + z * x;
+}
+
+//Building.
+//Items come in as a box each and get sorted in to leaf order in items.
+
+typedef struct pla_bvh_builder{
+        pla_bvh_box const * boxes;
+        u32 * items;
+        pla_bvh_node * nodes;
+        pla_bvh_config config;
+} pla_bvh_builder;
+
+typedef struct pla_bvh_task{
+        u32 node;
+        u32 first;
+        u32 count;
+        u32 depth;
+} pla_bvh_task;
+
+static inline pla_bvh_task pla_make_bvh_task(u32 node, u32 first, u32 count, u32 depth){
+        pla_bvh_task task = {node, first, count, depth};
+        return task;
+}
+
+//centroids are kept doubled, min + max, it's the same ordering without the multiply.
+static inline u32 pla_bvh_get_bin(pla_bvh_box const * box, u32 axis, f32 low, f32 scale){
+        f32 at = (box->min[axis] + box->max[axis] - low) * scale;
+        //not a compare that lets a nan through to the cast.
+        if(!(at >= 0)) return 0;
+        return at < PLA_BVH_BINS ? (u32)at : PLA_BVH_BINS - 1;
+}
+
+//Sets the node of a task to its items' bounds and leaves it a leaf or partitions its items in two, the left ones first.
+//returns the left count, 0 when the node stays a leaf.
+static inline u32 pla_bvh_split(pla_bvh_builder const * builder, pla_bvh_task const * task){
+        u32 * items = builder->items + task->first;
+        u32 count = task->count;
+        pla_bvh_box bounds;
+        pla_bvh_box centroids;
+        pla_bvh_empty_box(&bounds);
+        pla_bvh_empty_box(&centroids);
+        for(u32 i = 0; i < count; ++i){
+                pla_bvh_box const * item = &builder->boxes[items[i]];
+                pla_bvh_box centroid;
+                for(u32 a = 0; a < 4; ++a) centroid.min[a] = centroid.max[a] = item->min[a] + item->max[a];
+                pla_bvh_grow_box(&bounds, item);
+                pla_bvh_grow_box(&centroids, &centroid);
+        }
+        pla_bvh_node * node = &builder->nodes[task->node];
+        memcpy(node->min, bounds.min, sizeof(node->min));
+        memcpy(node->max, bounds.max, sizeof(node->max));
+        node->first = task->first;
+        node->count = count;
+        if(count <= 1) return 0;
+
+        u32 best_axis = 3;
+        u32 best_split = 0;
+        f32 best_cost = FLT_MAX;
+        //all three axes are binned in one pass over the items.
+        u32 bin_counts[3][PLA_BVH_BINS] = {};
+        pla_bvh_box bins[3][PLA_BVH_BINS];
+        f32 scales[3];
+        bool binned = false;
+        for(u32 axis = 0; axis < 3; ++axis){
+                f32 extent = centroids.max[axis] - centroids.min[axis];
+                //a flat axis gets everything in bin 0 and no split.
+                scales[axis] = extent > 0 ? PLA_BVH_BINS / extent : 0;
+                binned |= extent > 0;
+                for(u32 b = 0; b < PLA_BVH_BINS; ++b) pla_bvh_empty_box(&bins[axis][b]);
+        }
+        if(binned && task->depth < PLA_BVH_SAH_DEPTH){
+                for(u32 i = 0; i < count; ++i){
+                        pla_bvh_box const * item = &builder->boxes[items[i]];
+                        for(u32 axis = 0; axis < 3; ++axis){
+                                u32 b = pla_bvh_get_bin(item, axis, centroids.min[axis], scales[axis]);
+                                ++bin_counts[axis][b];
+                                pla_bvh_grow_box(&bins[axis][b], item);
+                        }
+                }
+        }
+        for(u32 axis = 0; axis < 3 && binned && task->depth < PLA_BVH_SAH_DEPTH; ++axis){
+                if(scales[axis] == 0) continue;
+                //the right side of every plane in one sweep from the right, the left side in one from the left.
+                f32 right_costs[PLA_BVH_BINS];
+                pla_bvh_box swept;
+                pla_bvh_empty_box(&swept);
+                u32 swept_count = 0;
+                for(u32 b = PLA_BVH_BINS - 1; b > 0; --b){
+                        swept_count += bin_counts[axis][b];
+                        pla_bvh_grow_box(&swept, &bins[axis][b]);
+                        right_costs[b] = swept_count ? pla_bvh_half_area(&swept) * swept_count : 0;
+                }
+                pla_bvh_empty_box(&swept);
+                swept_count = 0;
+                for(u32 b = 1; b < PLA_BVH_BINS; ++b){
+                        swept_count += bin_counts[axis][b - 1];
+                        pla_bvh_grow_box(&swept, &bins[axis][b - 1]);
+                        if(!swept_count || swept_count == count) continue;
+                        f32 cost = pla_bvh_half_area(&swept) * swept_count + right_costs[b];
+                        if(cost < best_cost){
+                                best_cost = cost;
+                                best_axis = axis;
+                                best_split = b;
+                        }
+                }
+        }
+
+        if(best_axis < 3){
+                f32 area = pla_bvh_half_area(&bounds);
+                f32 split_cost = builder->config.traversal_cost + (area > 0 ? best_cost / area : 0);
+                if(count <= builder->config.max_leaf_size && split_cost >= (f32)count) return 0;
+                f32 low = centroids.min[best_axis];
+                f32 scale = scales[best_axis];
+                u32 left = 0;
+                u32 right = count;
+                while(left < right){
+                        if(pla_bvh_get_bin(&builder->boxes[items[left]], best_axis, low, scale) < best_split){
+                                ++left;
+                                continue;
+                        }
+                        u32 item = items[--right];
+                        items[right] = items[left];
+                        items[left] = item;
+                }
+                return left;
+        }
+        if(count <= builder->config.max_leaf_size) return 0;
+        //every centroid is in one place or the node is past the sah depth, halving keeps the depth down.
+        return count / 2;
+}
+
+//Builds the subtree of a task depth first, the nodes it adds are taken in pairs from *next_node.
+static inline void pla_bvh_build_subtree(pla_bvh_builder const * builder, pla_bvh_task root, u32 * next_node){
+        //one pending right child per level.
+        pla_bvh_task stack[PLA_BVH_MAX_DEPTH + 2];
+        u32 size = 0;
+        stack[size++] = root;
+        while(size){
+                pla_bvh_task task = stack[--size];
+                u32 left = pla_bvh_split(builder, &task);
+                if(!left) continue;
+                u32 children = *next_node;
+                *next_node += 2;
+                builder->nodes[task.node].first = children;
+                builder->nodes[task.node].count = 0;
+                stack[size++] = pla_make_bvh_task(children + 1, task.first + left, task.count - left, task.depth + 1);
+                stack[size++] = pla_make_bvh_task(children, task.first, left, task.depth + 1);
+        }
+}
+
+typedef struct{
+        pla_bvh_builder const * builder;
+        pla_bvh_task const * tasks;
+        u32 const * starts;
+        u32 * ends;
+} pla_bvh_subtree_job;
+
+static inline void pla_bvh_build_subtree_job(void * job_data, u32 index){
+        pla_bvh_subtree_job * job = (pla_bvh_subtree_job *)job_data;
+        u32 next_node = job->starts[index];
+        pla_bvh_build_subtree(job->builder, job->tasks[index], &next_node);
+        job->ends[index] = next_node;
+}
+
+//Builds a tree over items [0, count) in to nodes, which has room for 2 * count of them, and returns how many it used.
+//a reservation of 2 * n - 2 nodes under a root is even, so children of the pieces stay at even indices and their moves are even.
+//big trees are split breadth first until the pieces are small enough to spread over the jobs, each piece builds in to room for the most nodes it can need and the gaps are closed after.
+static inline u32 pla_bvh_build(pla_bvh_builder const * builder, u32 count, pla_job_system const * jobs){
+        if(!count) return 0;
+        memset(&builder->nodes[1], 0, sizeof(pla_bvh_node));
+        u32 next_node = 2;
+        pla_bvh_task root = pla_make_bvh_task(0, 0, count, 0);
+        if(!jobs || count <= PLA_BVH_PARALLEL_ITEMS){
+                pla_bvh_build_subtree(builder, root, &next_node);
+                return next_node;
+        }
+
+        u32 threshold = count / (PLA_BVH_MAX_TASKS / 2) > PLA_BVH_PARALLEL_ITEMS / 4 ? count / (PLA_BVH_MAX_TASKS / 2) : PLA_BVH_PARALLEL_ITEMS / 4;
+        pla_bvh_task tasks[PLA_BVH_MAX_TASKS];
+        u32 task_count = 0;
+        tasks[task_count++] = root;
+        for(u32 i = 0; i < task_count;){
+                pla_bvh_task task = tasks[i];
+                if(task.count <= threshold || task_count == PLA_BVH_MAX_TASKS){
+                        ++i;
+                        continue;
+                }
+                u32 left = pla_bvh_split(builder, &task);
+                if(!left){
+                        tasks[i] = tasks[--task_count];
+                        continue;
+                }
+                u32 children = next_node;
+                next_node += 2;
+                builder->nodes[task.node].first = children;
+                builder->nodes[task.node].count = 0;
+                tasks[i] = pla_make_bvh_task(children, task.first, left, task.depth + 1);
+                tasks[task_count++] = pla_make_bvh_task(children + 1, task.first + left, task.count - left, task.depth + 1);
+        }
+
+        //a subtree over n items adds at most 2 * n - 2 nodes under its root.
+        u32 starts[PLA_BVH_MAX_TASKS];
+        u32 ends[PLA_BVH_MAX_TASKS];
+        u32 reserved = next_node;
+        for(u32 i = 0; i < task_count; ++i){
+                starts[i] = reserved;
+                reserved += 2 * (tasks[i].count - 1);
+        }
+        pla_bvh_subtree_job job = {builder, tasks, starts, ends};
+        pla_parallel_for(jobs, task_count, pla_bvh_build_subtree_job, &job);
+
+        //the ranges are in order so each moves down over the gap before it, the children it points at move with it.
+        u32 at = next_node;
+        for(u32 i = 0; i < task_count; ++i){
+                u32 used = ends[i] - starts[i];
+                u32 shift = starts[i] - at;
+                if(shift){
+                        memmove(builder->nodes + at, builder->nodes + starts[i], sizeof(pla_bvh_node) * used);
+                        for(u32 n = at; n < at + used; ++n) if(!builder->nodes[n].count) builder->nodes[n].first -= shift;
+                        pla_bvh_node * task_root = &builder->nodes[tasks[i].node];
+                        if(!task_root->count) task_root->first -= shift;
+                }
+                at += used;
+        }
+        return at;
+}
+
+typedef struct{
+        pla_GLTF const * gltf;
+        pla_mesh_primitive const * primitive;
+        pla_accessor const * position;
+        u32 vertex_count;
+        u32 triangle_count;
+        f32 * positions;
+        u32 * corners;
+        pla_bvh_box * boxes;
+        pla_bvh * bvh;
+        u8 * failed;
+} pla_primitive_bvh_job;
+
+static inline void pla_read_bvh_positions(void * job_data, u32 index){
+        pla_primitive_bvh_job * job = (pla_primitive_bvh_job *)job_data;
+        u32 first = index * PLA_BVH_CHUNK;
+        u32 count = job->vertex_count - first < PLA_BVH_CHUNK ? job->vertex_count - first : PLA_BVH_CHUNK;
+        job->failed[index] = !pla_read_accessor_f32(job->gltf, job->position, first, count, job->positions + (usize)first * 3);
+}
+
+static inline void pla_read_bvh_triangles(void * job_data, u32 index){
+        pla_primitive_bvh_job * job = (pla_primitive_bvh_job *)job_data;
+        u32 first = index * PLA_BVH_CHUNK;
+        u32 count = job->triangle_count - first < PLA_BVH_CHUNK ? job->triangle_count - first : PLA_BVH_CHUNK;
+        u32 * corners = job->corners + (usize)first * 3;
+        if(!pla_read_primitive_triangles(job->gltf, job->primitive, first, count, corners)){
+                job->failed[index] = 1;
+                return;
+        }
+        u32 bad = 0;
+        for(u32 t = 0; t < count; ++t){
+                pla_bvh_box * box = &job->boxes[first + t];
+                pla_bvh_empty_box(box);
+                for(u32 c = 0; c < 3; ++c){
+                        u32 vertex = corners[t * 3 + c];
+                        bad |= vertex >= job->vertex_count;
+                        f32 const * p = job->positions + (usize)(vertex < job->vertex_count ? vertex : 0) * 3;
+                        pla_bvh_grow_box_by(box, p, p);
+                }
+                job->bvh->items[first + t] = first + t;
+        }
+        job->failed[index] = bad != 0;
+}
+
+static inline void pla_copy_bvh_triangles(void * job_data, u32 index){
+        pla_primitive_bvh_job * job = (pla_primitive_bvh_job *)job_data;
+        u32 first = index * PLA_BVH_CHUNK;
+        u32 count = job->triangle_count - first < PLA_BVH_CHUNK ? job->triangle_count - first : PLA_BVH_CHUNK;
+        for(u32 slot = first; slot < first + count; ++slot){
+                u32 const * corners = job->corners + (usize)job->bvh->items[slot] * 3;
+                f32 * triangle = job->bvh->triangles + (usize)slot * 9;
+                for(u32 c = 0; c < 3; ++c) memcpy(triangle + c * 3, job->positions + (usize)corners[c] * 3, sizeof(f32) * 3);
+        }
+}
+
+//Builds in to a bvh whose arrays are already allocated for the primitive's triangles.
+static inline bool pla_build_primitive_bvh_in(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_bvh_config const * config, pla_job_system const * jobs, pla_bvh * bvh){
+        bvh->node_count = 0;
+        if(!bvh->item_count) return true;
+        pla_primitive_bvh_job job = {};
+        job.gltf = gltf;
+        job.primitive = primitive;
+        job.position = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+        if(!job.position || job.position->type != pla_GLTF_VEC3) return false;
+        job.vertex_count = job.position->count;
+        job.triangle_count = bvh->item_count;
+        job.bvh = bvh;
+        u32 vertex_chunks = (job.vertex_count + PLA_BVH_CHUNK - 1) / PLA_BVH_CHUNK;
+        u32 triangle_chunks = (job.triangle_count + PLA_BVH_CHUNK - 1) / PLA_BVH_CHUNK;
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        job.positions = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 3 * ((usize)job.vertex_count + 1), 16);
+        job.corners = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * 3 * (usize)job.triangle_count, 16);
+        job.boxes = (pla_bvh_box *)pla_linear_allocate(scratch, sizeof(pla_bvh_box) * (usize)job.triangle_count, 32);
+        job.failed = (u8 *)pla_linear_allocate(scratch, (usize)vertex_chunks + triangle_chunks + 1, 1);
+        bool ok = job.positions && job.corners && job.boxes && job.failed;
+        if(ok){
+                pla_parallel_for(jobs, vertex_chunks, pla_read_bvh_positions, &job);
+                for(u32 i = 0; i < vertex_chunks; ++i) ok &= !job.failed[i];
+        }
+        if(ok){
+                job.failed += vertex_chunks;
+                pla_parallel_for(jobs, triangle_chunks, pla_read_bvh_triangles, &job);
+                for(u32 i = 0; i < triangle_chunks; ++i) ok &= !job.failed[i];
+        }
+        if(ok){
+                pla_bvh_builder builder = {job.boxes, bvh->items, bvh->nodes, *config};
+                bvh->node_count = pla_bvh_build(&builder, job.triangle_count, jobs);
+                pla_parallel_for(jobs, triangle_chunks, pla_copy_bvh_triangles, &job);
+        }
+        pla_linear_reset_to(scratch, mark);
+        return ok;
+}
+
+//Builds the bvh of a triangle list, strip or fan primitive in to arena, other modes give an empty bvh. its items are triangles in the order pla_read_primitive_triangles reads them.
+//big primitives build their subtrees as jobs, jobs can be null.
+//returns false if the positions or indices can't be read, an index is past the vertices or arena runs out, arena is reset to where it was then.
+inline bool pla_build_primitive_bvh(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_bvh_config const * config, pla_job_system const * jobs, pla_linear_allocator * arena, pla_bvh * out_bvh) NOEXCEPT{
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        bool ok = pla_allocate_bvh(arena, pla_get_primitive_triangle_count(gltf, primitive), true, out_bvh) && pla_build_primitive_bvh_in(gltf, primitive, config, jobs, out_bvh);
+        if(!ok) pla_linear_reset_to(arena, mark);
+        return ok;
+}
+
+typedef struct{
+        pla_GLTF const * gltf;
+        pla_bvh_config const * config;
+        pla_mesh_primitive const ** primitives;
+        pla_bvh * bvhs;
+        u32 const * small;
+        u8 * failed;
+} pla_mesh_bvhs_job;
+
+static inline void pla_build_small_primitive_bvh(void * job_data, u32 index){
+        pla_mesh_bvhs_job * job = (pla_mesh_bvhs_job *)job_data;
+        u32 i = job->small[index];
+        job->failed[i] = !pla_build_primitive_bvh_in(job->gltf, job->primitives[i], job->config, PLA_NULL, &job->bvhs[i]);
+}
+
+//Builds the bvh of every primitive of every mesh in to arena. small primitives are built as one job each and big ones one after the other with their subtrees as jobs, so a scan of one huge mesh and a level of many small ones both keep the jobs busy.
+//returns false like pla_build_primitive_bvh.
+inline bool pla_build_mesh_bvhs(pla_GLTF const * gltf, pla_bvh_config const * config, pla_job_system const * jobs, pla_linear_allocator * arena, pla_mesh_bvhs * out_bvhs) NOEXCEPT{
+        memset(out_bvhs, 0, sizeof(*out_bvhs));
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        u32 count = 0;
+        for(u32 m = 0; m < gltf->meshes_size; ++m) count += gltf->meshes[m].primitive_count;
+        out_bvhs->bvhs = (pla_bvh *)pla_linear_allocate(arena, sizeof(pla_bvh) * ((usize)count + 1), 16);
+        out_bvhs->first = (u32 *)pla_linear_allocate(arena, sizeof(u32) * ((usize)gltf->meshes_size + 1), 16);
+        out_bvhs->count = count;
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark scratch_mark = pla_linear_get_mark(scratch);
+        pla_mesh_bvhs_job job = {gltf, config, PLA_NULL, out_bvhs->bvhs, PLA_NULL, PLA_NULL};
+        job.primitives = (pla_mesh_primitive const **)pla_linear_allocate(scratch, sizeof(pla_mesh_primitive const *) * ((usize)count + 1), 16);
+        u32 * small = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * ((usize)count + 1), 16);
+        job.small = small;
+        job.failed = (u8 *)pla_linear_allocate(scratch, (usize)count + 1, 1);
+        bool ok = out_bvhs->bvhs && out_bvhs->first && job.primitives && small && job.failed;
+
+        u32 small_count = 0;
+        u32 at = 0;
+        for(u32 m = 0; m < gltf->meshes_size && ok; ++m){
+                out_bvhs->first[m] = at;
+                for(u32 p = 0; p < gltf->meshes[m].primitive_count && ok; ++p, ++at){
+                        job.primitives[at] = &gltf->meshes[m].primitives[p];
+                        job.failed[at] = 0;
+                        u32 triangle_count = pla_get_primitive_triangle_count(gltf, job.primitives[at]);
+                        ok = pla_allocate_bvh(arena, triangle_count, true, &out_bvhs->bvhs[at]);
+                        if(triangle_count <= PLA_BVH_PARALLEL_ITEMS) small[small_count++] = at;
+                }
+        }
+        if(ok) out_bvhs->first[gltf->meshes_size] = at;
+        if(ok) pla_parallel_for(jobs, small_count, pla_build_small_primitive_bvh, &job);
+        for(u32 i = 0; i < count && ok; ++i){
+                if(out_bvhs->bvhs[i].item_count > PLA_BVH_PARALLEL_ITEMS) ok = pla_build_primitive_bvh_in(gltf, job.primitives[i], config, jobs, &out_bvhs->bvhs[i]);
+                ok = ok && !job.failed[i];
+        }
+        pla_linear_reset_to(scratch, scratch_mark);
+        if(!ok){
+                pla_linear_reset_to(arena, mark);
+                memset(out_bvhs, 0, sizeof(*out_bvhs));
+        }
+        return ok;
+}
+
+//Inverse of a column major affine transform, false if it scales something to nothing.
+static inline bool pla_invert_affine_matrix(f32 const * m, f32 * out){
+        f32 const * x = m;
+        f32 const * y = m + 4;
+        f32 const * z = m + 8;
+        //the rows of the inverse are the cross products of the columns over the determinant.
+        f32 rows[3][3] = {
+                {y[1] * z[2] - y[2] * z[1], y[2] * z[0] - y[0] * z[2], y[0] * z[1] - y[1] * z[0]},
+                {z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2], z[0] * x[1] - z[1] * x[0]},
+                {x[1] * y[2] - x[2] * y[1], x[2] * y[0] - x[0] * y[2], x[0] * y[1] - x[1] * y[0]},
+        };
+        f32 determinant = x[0] * rows[0][0] + x[1] * rows[0][1] + x[2] * rows[0][2];
+        memset(out, 0, sizeof(f32) * 16);
+        if(determinant == 0 || determinant != determinant) return false;
+        f32 inverse = 1.0f / determinant;
+        for(u32 r = 0; r < 3; ++r){
+                for(u32 c = 0; c < 3; ++c) out[c * 4 + r] = rows[r][c] * inverse;
+        }
+        for(u32 r = 0; r < 3; ++r) out[12 + r] = -(out[r] * m[12] + out[4 + r] * m[13] + out[8 + r] * m[14]);
+        out[15] = 1;
+        return true;
+}
+
+static inline void pla_transform_point(f32 const * m, f32 const * p, f32 * out){
+        for(u32 r = 0; r < 3; ++r) out[r] = m[r] * p[0] + m[4 + r] * p[1] + m[8 + r] * p[2] + m[12 + r];
+}
+
+static inline void pla_transform_direction(f32 const * m, f32 const * d, f32 * out){
+        for(u32 r = 0; r < 3; ++r) out[r] = m[r] * d[0] + m[4 + r] * d[1] + m[8 + r] * d[2];
+}
+
+//Builds the bvh of every mesh and a top level one over the world bounds of the scene's nodes that have a mesh with triangles, in to arena.
+//instances keep the world transform and its inverse, nodes whose transform can't be inverted are left out.
+//returns false like pla_build_primitive_bvh, or if the scene can't be flattened.
+inline bool pla_build_scene_bvh(pla_GLTF const * gltf, u32 scene, pla_bvh_config const * config, pla_job_system const * jobs, pla_linear_allocator * arena, pla_scene_bvh * out_bvh) NOEXCEPT{
+        memset(out_bvh, 0, sizeof(*out_bvh));
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        if(!pla_build_mesh_bvhs(gltf, config, jobs, arena, &out_bvh->meshes)) return false;
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark scratch_mark = pla_linear_get_mark(scratch);
+        usize node_capacity = (usize)gltf->nodes_size + 1;
+        u32 * nodes = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * 2 * node_capacity, 16);
+        f32 * matrices = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 16 * node_capacity, 16);
+        pla_bvh_box * boxes = (pla_bvh_box *)pla_linear_allocate(scratch, sizeof(pla_bvh_box) * node_capacity, 32);
+        u32 count = 0;
+        bool ok = nodes && matrices && boxes && pla_flatten_scene(gltf, scene, &count, nodes, nodes + node_capacity);
+        if(ok) pla_compute_world_matrices(gltf, count, nodes, nodes + node_capacity, matrices);
+
+        pla_mesh_bvhs const * meshes = &out_bvh->meshes;
+        out_bvh->instances = ok ? (pla_bvh_instance *)pla_linear_allocate(arena, sizeof(pla_bvh_instance) * ((usize)count + 1), 16) : PLA_NULL;
+        ok = ok && out_bvh->instances;
+        u32 instance_count = 0;
+        for(u32 i = 0; i < count && ok; ++i){
+                u32 mesh = gltf->nodes[nodes[i]].mesh;
+                if(mesh >= gltf->meshes_size) continue;
+                pla_bvh_box local;
+                pla_bvh_empty_box(&local);
+                for(u32 b = meshes->first[mesh]; b < meshes->first[mesh + 1]; ++b){
+                        pla_bvh const * bvh = &meshes->bvhs[b];
+                        if(bvh->node_count) pla_bvh_grow_box_by(&local, bvh->nodes[0].min, bvh->nodes[0].max);
+                }
+                if(local.min[0] > local.max[0]) continue;
+                pla_bvh_instance * instance = &out_bvh->instances[instance_count];
+                instance->node = nodes[i];
+                instance->mesh = mesh;
+                memcpy(instance->local_to_world, matrices + (usize)i * 16, sizeof(instance->local_to_world));
+                if(!pla_invert_affine_matrix(instance->local_to_world, instance->world_to_local)) continue;
+                pla_bvh_box * world = &boxes[instance_count];
+                pla_bvh_empty_box(world);
+                for(u32 corner = 0; corner < 8; ++corner){
+                        f32 p[3] = {corner & 1 ? local.max[0] : local.min[0], corner & 2 ? local.max[1] : local.min[1], corner & 4 ? local.max[2] : local.min[2]};
+                        f32 q[3];
+                        pla_transform_point(instance->local_to_world, p, q);
+                        pla_bvh_grow_box_by(world, q, q);
+                }
+                ++instance_count;
+        }
+        out_bvh->instance_count = instance_count;
+        ok = ok && pla_allocate_bvh(arena, instance_count, false, &out_bvh->top);
+        if(ok){
+                for(u32 i = 0; i < instance_count; ++i) out_bvh->top.items[i] = i;
+                pla_bvh_builder builder = {boxes, out_bvh->top.items, out_bvh->top.nodes, *config};
+                out_bvh->top.node_count = pla_bvh_build(&builder, instance_count, jobs);
+        }
+        pla_linear_reset_to(scratch, scratch_mark);
+        if(!ok){
+                pla_linear_reset_to(arena, mark);
+                memset(out_bvh, 0, sizeof(*out_bvh));
+        }
+        return ok;
+}
+
+//Queries.
+//Traversal visits the nearer child first and keeps the farther one on a fixed stack, boxes are skipped once they're past the best hit so far_distance.
+
+//Distance along the ray to a node's box, FLT_MAX if it misses it before t_max.
+static inline f32 pla_bvh_ray_box(pla_bvh_node const * node, f32 const * origin, f32 const * inverse_direction, f32 t_max){
+        f32 near_distance = 0;
+        f32 far_distance = t_max;
+        for(u32 i = 0; i < 3; ++i){
+                f32 a = (node->min[i] - origin[i]) * inverse_direction[i];
+                f32 b = (node->max[i] - origin[i]) * inverse_direction[i];
+                //compares instead of fminf and fmaxf, which are calls without -ffinite-math-only. the nan of a ray in the plane of a face ends up on the side that's ignored like they'd ignore it.
+                f32 low = a < b ? a : b;
+                f32 high = a > b ? a : b;
+                near_distance = low > near_distance ? low : near_distance;
+                far_distance = high < far_distance ? high : far_distance;
+        }
+        return near_distance <= far_distance ? near_distance : FLT_MAX;
+}
+
+//Two sided Moller Trumbore, only hits closer than hit->t are taken.
+static inline bool pla_bvh_ray_triangle(f32 const * triangle, f32 const * origin, f32 const * direction, u32 item, pla_bvh_hit * hit){
+        f32 const * p = triangle;
+        f32 e1[3] = {p[3] - p[0], p[4] - p[1], p[5] - p[2]};
+        f32 e2[3] = {p[6] - p[0], p[7] - p[1], p[8] - p[2]};
+        f32 h[3] = {direction[1] * e2[2] - direction[2] * e2[1], direction[2] * e2[0] - direction[0] * e2[2], direction[0] * e2[1] - direction[1] * e2[0]};
+        f32 determinant = e1[0] * h[0] + e1[1] * h[1] + e1[2] * h[2];
+        if(determinant == 0) return false;
+        f32 inverse = 1.0f / determinant;
+        f32 s[3] = {origin[0] - p[0], origin[1] - p[1], origin[2] - p[2]};
+        f32 u = (s[0] * h[0] + s[1] * h[1] + s[2] * h[2]) * inverse;
+        if(u < 0 || u > 1) return false;
+        f32 q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+        f32 v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverse;
+        if(v < 0 || u + v > 1) return false;
+        f32 t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverse;
+        if(!(t >= 0 && t < hit->t)) return false;
+        hit->t = t;
+        hit->u = u;
+        hit->v = v;
+        hit->item = item;
+        return true;
+}
+
+typedef struct pla_bvh_stack_entry{
+        u32 node;
+        f32 distance;
+} pla_bvh_stack_entry;
+
+//Closest hit of the ray origin + t * direction for t in [0, t_max), direction doesn't have to be normalized and t is in its units.
+inline bool pla_bvh_intersect_ray(pla_bvh const * bvh, f32 const * origin, f32 const * direction, f32 t_max, pla_bvh_hit * out_hit) NOEXCEPT{
+        if(!bvh->node_count || !bvh->triangles) return false;
+        f32 inverse_direction[3] = {1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]};
+        pla_bvh_hit hit = {t_max, 0, 0, PLA_INDEX_NONE};
+        pla_bvh_stack_entry stack[PLA_BVH_MAX_DEPTH + 1];
+        u32 size = 0;
+        u32 index = 0;
+        if(pla_bvh_ray_box(&bvh->nodes[0], origin, inverse_direction, hit.t) == FLT_MAX) return false;
+        for(;;){
+                pla_bvh_node const * node = &bvh->nodes[index];
+                if(node->count){
+                        for(u32 i = node->first; i < node->first + node->count; ++i) pla_bvh_ray_triangle(bvh->triangles + (usize)i * 9, origin, direction, bvh->items[i], &hit);
+                }else{
+                        f32 near_distance = pla_bvh_ray_box(&bvh->nodes[node->first], origin, inverse_direction, hit.t);
+                        f32 far_distance = pla_bvh_ray_box(&bvh->nodes[node->first + 1], origin, inverse_direction, hit.t);
+                        u32 near_index = node->first;
+                        u32 far_index = node->first + 1;
+                        if(far_distance < near_distance){
+                                f32 distance = near_distance;
+                                near_distance = far_distance;
+                                far_distance = distance;
+                                near_index = far_index;
+                                far_index = node->first;
+                        }
+                        if(near_distance != FLT_MAX){
+                                if(far_distance != FLT_MAX){
+                                        stack[size].node = far_index;
+                                        stack[size].distance = far_distance;
+                                        ++size;
+                                }
+                                index = near_index;
+                                continue;
+                        }
+                }
+                //popped boxes may be behind a hit found since they were pushed.
+                while(size && stack[size - 1].distance >= hit.t) --size;
+                if(!size) break;
+                index = stack[--size].node;
+        }
+        if(hit.item == PLA_INDEX_NONE) return false;
+        *out_hit = hit;
+        return true;
+}
+
+static inline f32 pla_bvh_box_distance_squared(pla_bvh_node const * node, f32 const * point){
+        f32 sum = 0;
+        for(u32 i = 0; i < 3; ++i){
+                f32 d = point[i] < node->min[i] ? node->min[i] - point[i] : point[i] > node->max[i] ? point[i] - node->max[i] : 0;
+                sum += d * d;
+        }
+        return sum;
+}
+
+static inline void pla_bvh_lerp(f32 const * a, f32 const * b, f32 t, f32 * out){
+        for(u32 i = 0; i < 3; ++i) out[i] = a[i] + (b[i] - a[i]) * t;
+}
+
+//Closest point to p on the triangle abc by which of its vertex, edge or face regions p is in, from Real-Time Collision Detection 5.1.5.
+static inline void pla_closest_point_on_triangle(f32 const * p, f32 const * a, f32 const * b, f32 const * c, f32 * out){
+        f32 ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        f32 ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        f32 ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+        f32 d1 = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+        f32 d2 = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+        if(d1 <= 0 && d2 <= 0){
+                memcpy(out, a, sizeof(f32) * 3);
+                return;
+        }
+        f32 bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+        f32 d3 = ab[0] * bp[0] + ab[1] * bp[1] + ab[2] * bp[2];
+        f32 d4 = ac[0] * bp[0] + ac[1] * bp[1] + ac[2] * bp[2];
+        if(d3 >= 0 && d4 <= d3){
+                memcpy(out, b, sizeof(f32) * 3);
+                return;
+        }
+        f32 vc = d1 * d4 - d3 * d2;
+        if(vc <= 0 && d1 >= 0 && d3 <= 0){
+                pla_bvh_lerp(a, b, d1 / (d1 - d3), out);
+                return;
+        }
+        f32 cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+        f32 d5 = ab[0] * cp[0] + ab[1] * cp[1] + ab[2] * cp[2];
+        f32 d6 = ac[0] * cp[0] + ac[1] * cp[1] + ac[2] * cp[2];
+        if(d6 >= 0 && d5 <= d6){
+                memcpy(out, c, sizeof(f32) * 3);
+                return;
+        }
+        f32 vb = d5 * d2 - d1 * d6;
+        if(vb <= 0 && d2 >= 0 && d6 <= 0){
+                pla_bvh_lerp(a, c, d2 / (d2 - d6), out);
+                return;
+        }
+        f32 va = d3 * d6 - d5 * d4;
+        if(va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0){
+                pla_bvh_lerp(b, c, (d4 - d3) / ((d4 - d3) + (d5 - d6)), out);
+                return;
+        }
+        f32 inverse = 1.0f / (va + vb + vc);
+        f32 v = vb * inverse;
+        f32 w = vc * inverse;
+        for(u32 i = 0; i < 3; ++i) out[i] = a[i] + ab[i] * v + ac[i] * w;
+}
+
+//Closest point to point on the triangles of a bvh within max_distance, for snapping and distance queries.
+inline bool pla_bvh_find_closest_point(pla_bvh const * bvh, f32 const * point, f32 max_distance, pla_bvh_closest_point * out_closest) NOEXCEPT{
+        if(!bvh->node_count || !bvh->triangles) return false;
+        f32 best = max_distance * max_distance;
+        u32 best_item = PLA_INDEX_NONE;
+        f32 best_point[3] = {};
+        pla_bvh_stack_entry stack[PLA_BVH_MAX_DEPTH + 1];
+        u32 size = 0;
+        u32 index = 0;
+        if(pla_bvh_box_distance_squared(&bvh->nodes[0], point) > best) return false;
+        for(;;){
+                pla_bvh_node const * node = &bvh->nodes[index];
+                if(node->count){
+                        for(u32 i = node->first; i < node->first + node->count; ++i){
+                                f32 const * t = bvh->triangles + (usize)i * 9;
+                                f32 q[3];
+                                pla_closest_point_on_triangle(point, t, t + 3, t + 6, q);
+                                f32 d = (q[0] - point[0]) * (q[0] - point[0]) + (q[1] - point[1]) * (q[1] - point[1]) + (q[2] - point[2]) * (q[2] - point[2]);
+                                if(d > best || (d == best && best_item != PLA_INDEX_NONE)) continue;
+                                best = d;
+                                best_item = bvh->items[i];
+                                memcpy(best_point, q, sizeof(best_point));
+                        }
+                }else{
+                        f32 near_distance = pla_bvh_box_distance_squared(&bvh->nodes[node->first], point);
+                        f32 far_distance = pla_bvh_box_distance_squared(&bvh->nodes[node->first + 1], point);
+                        u32 near_index = node->first;
+                        u32 far_index = node->first + 1;
+                        if(far_distance < near_distance){
+                                f32 distance = near_distance;
+                                near_distance = far_distance;
+                                far_distance = distance;
+                                near_index = far_index;
+                                far_index = node->first;
+                        }
+                        if(near_distance <= best){
+                                if(far_distance <= best){
+                                        stack[size].node = far_index;
+                                        stack[size].distance = far_distance;
+                                        ++size;
+                                }
+                                index = near_index;
+                                continue;
+                        }
+                }
+                while(size && stack[size - 1].distance > best) --size;
+                if(!size) break;
+                index = stack[--size].node;
+        }
+        if(best_item == PLA_INDEX_NONE) return false;
+        memcpy(out_closest->point, best_point, sizeof(best_point));
+        out_closest->distance_squared = best;
+        out_closest->item = best_item;
+        return true;
+}
+
+//Closest hit of a world space ray in a scene, the ray goes in to each instance's space where t means the same thing.
+inline bool pla_scene_bvh_intersect_ray(pla_scene_bvh const * scene, f32 const * origin, f32 const * direction, f32 t_max, pla_scene_bvh_hit * out_hit) NOEXCEPT{
+        pla_bvh const * top = &scene->top;
+        if(!top->node_count) return false;
+        f32 inverse_direction[3] = {1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]};
+        pla_scene_bvh_hit best = {{t_max, 0, 0, PLA_INDEX_NONE}, PLA_INDEX_NONE, PLA_INDEX_NONE};
+        pla_bvh_stack_entry stack[PLA_BVH_MAX_DEPTH + 1];
+        u32 size = 0;
+        u32 index = 0;
+        if(pla_bvh_ray_box(&top->nodes[0], origin, inverse_direction, t_max) == FLT_MAX) return false;
+        for(;;){
+                pla_bvh_node const * node = &top->nodes[index];
+                if(node->count){
+                        for(u32 i = node->first; i < node->first + node->count; ++i){
+                                pla_bvh_instance const * instance = &scene->instances[top->items[i]];
+                                f32 local_origin[3];
+                                f32 local_direction[3];
+                                pla_transform_point(instance->world_to_local, origin, local_origin);
+                                pla_transform_direction(instance->world_to_local, direction, local_direction);
+                                u32 first = scene->meshes.first[instance->mesh];
+                                u32 end = scene->meshes.first[instance->mesh + 1];
+                                for(u32 b = first; b < end; ++b){
+                                        pla_bvh_hit hit;
+                                        if(!pla_bvh_intersect_ray(&scene->meshes.bvhs[b], local_origin, local_direction, best.hit.t, &hit)) continue;
+                                        best.hit = hit;
+                                        best.instance = top->items[i];
+                                        best.primitive = b - first;
+                                }
+                        }
+                }else{
+                        f32 near_distance = pla_bvh_ray_box(&top->nodes[node->first], origin, inverse_direction, best.hit.t);
+                        f32 far_distance = pla_bvh_ray_box(&top->nodes[node->first + 1], origin, inverse_direction, best.hit.t);
+                        u32 near_index = node->first;
+                        u32 far_index = node->first + 1;
+                        if(far_distance < near_distance){
+                                f32 distance = near_distance;
+                                near_distance = far_distance;
+                                far_distance = distance;
+                                near_index = far_index;
+                                far_index = node->first;
+                        }
+                        if(near_distance != FLT_MAX){
+                                if(far_distance != FLT_MAX){
+                                        stack[size].node = far_index;
+                                        stack[size].distance = far_distance;
+                                        ++size;
+                                }
+                                index = near_index;
+                                continue;
+                        }
+                }
+                while(size && stack[size - 1].distance >= best.hit.t) --size;
+                if(!size) break;
+                index = stack[--size].node;
+        }
+        if(best.instance == PLA_INDEX_NONE) return false;
+        *out_hit = best;
+        return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
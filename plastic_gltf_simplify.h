@@ -0,0 +1,752 @@
+#pragma once
+
+//Optional module over plastic_gltf.h: quadric error edge collapse simplification of mesh primitives in to level of detail index buffers.
+//lods index the primitive's own vertices so they draw with the vertex data the file already has. what a lod keeps goes in to a pla_linear_allocator the caller owns, temporaries come from the calling thread's scratch.
+
+#include "plastic_gltf.h"
+
+#include <float.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Simplification.
+//Vertices are moved on to a neighbour one edge at a time, cheapest first. the cost is how far the move takes the planes of the triangles the vertex has gathered (Garland and Heckbert's quadrics) plus the weighted change of the attributes asked for.
+//vertices that share a position but not their other attributes, uv seams and hard edges, move together along their seam. open borders only move along the border and vertices with anything more tangled around them stay put.
+
+//floats of weighted attributes a vertex carries, the rest of the attributes asked for are left out.
+#define PLA_SIMPLIFY_MAX_ATTRIBUTE_FLOATS 16
+//collapses of a pass are ordered by the top bits of their cost, exponent and 3 bits of mantissa.
+#define PLA_SIMPLIFY_SORT_BITS 11
+//border edges weigh this much more than a triangle of the same size, so outlines go last.
+#define PLA_SIMPLIFY_BORDER_WEIGHT 10.0f
+
+typedef struct pla_simplify_attribute{
+        pla_mesh_primitive_attribute_name name;
+        s8 set_index;
+        //a change of 1 / weight in a component costs as much as moving the surface by the primitive's extent.
+        f32 weight;
+} pla_simplify_attribute;
+
+typedef struct pla_simplify_config{
+        pla_simplify_attribute const * attributes;
+        u32 attribute_count;
+        //open borders stay where they are, so primitives that meet along one still meet in every lod.
+        bool lock_border;
+} pla_simplify_config;
+
+//A level of detail, simplifying stops at whichever of the two it gets to first.
+typedef struct pla_lod_target{
+        //of the primitive's triangles.
+        f32 triangle_ratio;
+        //relative to the primitive's extent, the longest side of its bounds.
+        f32 error;
+} pla_lod_target;
+
+typedef struct pla_lod{
+        //a triangle list of the primitive's vertices.
+        u32 * indices;
+        u32 index_count;
+        //the error it got to, relative like the target's.
+        f32 error;
+} pla_lod;
+
+//Lods of every primitive of every mesh, level l of primitive p is lods[p * level_count + l] and mesh m's primitives start at first[m].
+typedef struct pla_mesh_lods{
+        pla_lod * lods;
+        u32 * first;
+        u32 primitive_count;
+        u32 level_count;
+} pla_mesh_lods;
+
+INTERNAL pla_simplify_config pla_default_simplify_config(void) NOEXCEPT{
+        pla_simplify_config config = {};
+        return config;
+}
+
+//Sum of squared distances to planes, weighted. w is the weight, so error / w is a squared distance.
+typedef struct pla_quadric{
+        f32 a00, a11, a22;
+        f32 a10, a20, a21;
+        f32 b0, b1, b2;
+        f32 c;
+        f32 w;
+} pla_quadric;
+
+static inline void pla_quadric_from_plane(pla_quadric * q, f32 const * n, f32 d, f32 w){
+        q->a00 = w * n[0] * n[0];
+        q->a11 = w * n[1] * n[1];
+        q->a22 = w * n[2] * n[2];
+        q->a10 = w * n[1] * n[0];
+        q->a20 = w * n[2] * n[0];
+        q->a21 = w * n[2] * n[1];
+        q->b0 = w * n[0] * d;
+        q->b1 = w * n[1] * d;
+        q->b2 = w * n[2] * d;
+        q->c = w * d * d;
+        q->w = w;
+}
+
+static inline void pla_quadric_add(pla_quadric * q, pla_quadric const * other){
+        f32 * to = &q->a00;
+        f32 const * from = &other->a00;
+        for(u32 i = 0; i < 11; ++i) to[i] += from[i];
+}
+
+static inline f32 pla_quadric_error(pla_quadric const * q, f32 const * v){
+        f32 rx = q->b0 + q->a10 * v[1];
+        f32 ry = q->b1 + q->a21 * v[2];
+        f32 rz = q->b2 + q->a20 * v[0];
+        rx = 2 * rx + q->a00 * v[0];
+        ry = 2 * ry + q->a11 * v[1];
+        rz = 2 * rz + q->a22 * v[2];
+        f32 r = q->c + rx * v[0] + ry * v[1] + rz * v[2];
+        return q->w > 0 ? fabsf(r) / q->w : 0;
+}
+
+static inline void pla_simplify_sub(f32 const * a, f32 const * b, f32 * out){
+        for(u32 i = 0; i < 3; ++i) out[i] = a[i] - b[i];
+}
+
+static inline void pla_simplify_cross(f32 const * a, f32 const * b, f32 * out){
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline f32 pla_simplify_dot(f32 const * a, f32 const * b){
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+//The plane of a triangle weighted by its area.
+static inline void pla_quadric_from_triangle(pla_quadric * q, f32 const * p0, f32 const * p1, f32 const * p2){
+        f32 e1[3], e2[3], n[3];
+        pla_simplify_sub(p1, p0, e1);
+        pla_simplify_sub(p2, p0, e2);
+        pla_simplify_cross(e1, e2, n);
+        f32 area = sqrtf(pla_simplify_dot(n, n));
+        if(area > 0){
+                for(u32 i = 0; i < 3; ++i) n[i] /= area;
+        }
+        pla_quadric_from_plane(q, n, -pla_simplify_dot(n, p0), area);
+}
+
+//The plane through the edge p0 p1 at a right angle to the triangle, weighted by the edge's length squared, keeps a border from being pulled in or out.
+static inline void pla_quadric_from_triangle_edge(pla_quadric * q, f32 const * p0, f32 const * p1, f32 const * p2, f32 weight){
+        f32 edge[3], side[3];
+        pla_simplify_sub(p1, p0, edge);
+        pla_simplify_sub(p2, p0, side);
+        f32 length_squared = pla_simplify_dot(edge, edge);
+        f32 along = length_squared > 0 ? pla_simplify_dot(side, edge) / length_squared : 0;
+        for(u32 i = 0; i < 3; ++i) side[i] -= edge[i] * along;
+        f32 side_length = sqrtf(pla_simplify_dot(side, side));
+        if(side_length > 0){
+                for(u32 i = 0; i < 3; ++i) side[i] /= side_length;
+        }
+        pla_quadric_from_plane(q, side, -pla_simplify_dot(side, p0), length_squared * weight);
+}
+
+typedef enum pla_simplify_kind{
+        pla_simplify_manifold,
+        pla_simplify_border,
+        pla_simplify_seam,
+        pla_simplify_locked,
+        pla_simplify_kind_MAX_ENUM,
+} pla_simplify_kind;
+
+//whether a vertex of the first kind can move on to one of the second.
+INTERNAL u8 pla_simplify_can_collapse[pla_simplify_kind_MAX_ENUM][pla_simplify_kind_MAX_ENUM] = {
+        {1, 1, 1, 1},
+        {0, 1, 0, 1},
+        {0, 1, 1, 1},
+        {0, 0, 0, 0},
+};
+
+//whether an edge between the two kinds is in two triangles, so it only has to be looked at from one of them.
+INTERNAL u8 pla_simplify_has_opposite[pla_simplify_kind_MAX_ENUM][pla_simplify_kind_MAX_ENUM] = {
+        {1, 1, 1, 1},
+        {1, 0, 1, 0},
+        {1, 1, 1, 1},
+        {1, 0, 1, 0},
+};
+
+typedef struct pla_simplify_collapse{
+        u32 from;
+        u32 to;
+        //cost of going the other way too when bidirectional is set, the cheaper one is kept when they're ranked.
+        u32 bidirectional;
+        f32 error;
+} pla_simplify_collapse;
+
+//What simplifying a primitive works on, all of it in the scratch of the thread doing it.
+typedef struct pla_simplifier{
+        u32 vertex_count;
+        u32 index_count;
+        u32 * indices;
+        //scaled in to the unit cube, 3 per vertex.
+        f32 * positions;
+        //weighted, attribute_stride per vertex.
+        f32 * attributes;
+        u32 attribute_stride;
+        f32 extent;
+        //the first vertex at the same position, and a ring through all of them.
+        u32 * remap;
+        u32 * wedge;
+        u8 * kinds;
+        //the other end of the open edge going out of and in to a vertex, PLA_INDEX_NONE if there is none and the vertex itself if there's more than one.
+        u32 * loop;
+        u32 * loopback;
+        //per position, at the remap of a vertex.
+        pla_quadric * quadrics;
+        //per pass.
+        u32 * collapse_remap;
+        u8 * collapse_locked;
+        u32 * adjacency_offsets;
+        u32 * adjacency;
+        pla_simplify_collapse * collapses;
+        u32 * collapse_order;
+        u32 * sort_counts;
+} pla_simplifier;
+
+//Triangles of a position or half edges out of a vertex, in offsets[i] to offsets[i + 1]. keys maps a vertex to the list it goes in.
+static inline void pla_simplify_build_adjacency(pla_simplifier * s, u32 const * keys, bool edges){
+        u32 * offsets = s->adjacency_offsets;
+        memset(offsets, 0, sizeof(u32) * ((usize)s->vertex_count + 1));
+        for(u32 i = 0; i < s->index_count; ++i) ++offsets[keys ? keys[s->indices[i]] : s->indices[i]];
+        u32 sum = 0;
+        for(u32 v = 0; v < s->vertex_count; ++v){
+                u32 count = offsets[v];
+                offsets[v] = sum;
+                sum += count;
+        }
+        offsets[s->vertex_count] = sum;
+        for(u32 i = 0; i < s->index_count; ++i){
+                u32 v = s->indices[i];
+                u32 key = keys ? keys[v] : v;
+                //a half edge is kept as the vertex it goes to, a triangle as its first index.
+                u32 next = i - i % 3 + (i % 3 + 1) % 3;
+                s->adjacency[offsets[key]++] = edges ? s->indices[next] : i - i % 3;
+        }
+        for(u32 v = s->vertex_count; v > 0; --v) offsets[v] = offsets[v - 1];
+        offsets[0] = 0;
+}
+
+static inline bool pla_simplify_has_edge(pla_simplifier const * s, u32 a, u32 b){
+        for(u32 i = s->adjacency_offsets[a]; i < s->adjacency_offsets[a + 1]; ++i){
+                if(s->adjacency[i] == b) return true;
+        }
+        return false;
+}
+
+static inline u32 pla_simplify_hash_position(f32 const * p){
+        u32 bits[3];
+        memcpy(bits, p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+}
+
+//Gives vertices at the same position the same remap and links them in a ring by wedge.
+static inline bool pla_simplify_weld(pla_simplifier * s){
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        u32 table_size = 1;
+        while(table_size < s->vertex_count + s->vertex_count / 4) table_size *= 2;
+        u32 * table = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (usize)table_size, 16);
+        if(!table) return false;
+        memset(table, 0xff, sizeof(u32) * (usize)table_size);
+        for(u32 v = 0; v < s->vertex_count; ++v){
+                f32 const * p = s->positions + (usize)v * 3;
+                u32 slot = pla_simplify_hash_position(p) & (table_size - 1);
+                //linear probing, the table is never full.
+                while(table[slot] != PLA_INDEX_NONE && memcmp(s->positions + (usize)table[slot] * 3, p, sizeof(f32) * 3) != 0) slot = (slot + 1) & (table_size - 1);
+                if(table[slot] == PLA_INDEX_NONE) table[slot] = v;
+                u32 r = table[slot];
+                s->remap[v] = r;
+                s->wedge[v] = v;
+                if(r != v){
+                        s->wedge[v] = s->wedge[r];
+                        s->wedge[r] = v;
+                }
+        }
+        pla_linear_reset_to(scratch, mark);
+        return true;
+}
+
+//Finds the open edges and what each position can do, from the half edges in the adjacency.
+static inline void pla_simplify_classify(pla_simplifier * s, bool lock_border){
+        u32 * loop = s->loop;
+        u32 * loopback = s->loopback;
+        memset(loop, 0xff, sizeof(u32) * (usize)s->vertex_count);
+        memset(loopback, 0xff, sizeof(u32) * (usize)s->vertex_count);
+        for(u32 v = 0; v < s->vertex_count; ++v){
+                for(u32 i = s->adjacency_offsets[v]; i < s->adjacency_offsets[v + 1]; ++i){
+                        u32 to = s->adjacency[i];
+                        if(pla_simplify_has_edge(s, to, v)) continue;
+                        loop[v] = loop[v] == PLA_INDEX_NONE ? to : v;
+                        loopback[to] = loopback[to] == PLA_INDEX_NONE ? v : to;
+                }
+        }
+        for(u32 v = 0; v < s->vertex_count; ++v){
+                if(s->remap[v] != v) continue;
+                u8 kind = pla_simplify_locked;
+                u32 w = s->wedge[v];
+                if(w == v){
+                        if(loop[v] == PLA_INDEX_NONE && loopback[v] == PLA_INDEX_NONE) kind = pla_simplify_manifold;
+                        else if(loop[v] != v && loopback[v] != v) kind = lock_border ? pla_simplify_locked : pla_simplify_border;
+                }else if(s->wedge[w] == v){
+                        //two sides of a seam, each with one open edge in and out that run the other way on the other side.
+                        u32 in_v = loopback[v], out_v = loop[v], in_w = loopback[w], out_w = loop[w];
+                        bool open = in_v != PLA_INDEX_NONE && in_v != v && out_v != PLA_INDEX_NONE && out_v != v && in_w != PLA_INDEX_NONE && in_w != w && out_w != PLA_INDEX_NONE && out_w != w;
+                        if(open && s->remap[in_v] == s->remap[out_w] && s->remap[out_v] == s->remap[in_w] && s->remap[in_v] != s->remap[out_v]) kind = pla_simplify_seam;
+                }
+                s->kinds[v] = kind;
+        }
+        for(u32 v = 0; v < s->vertex_count; ++v) s->kinds[v] = s->kinds[s->remap[v]];
+}
+
+static inline void pla_simplify_fill_quadrics(pla_simplifier * s){
+        memset(s->quadrics, 0, sizeof(pla_quadric) * (usize)s->vertex_count);
+        for(u32 t = 0; t < s->index_count; t += 3){
+                u32 const * corners = s->indices + t;
+                pla_quadric q;
+                pla_quadric_from_triangle(&q, s->positions + (usize)corners[0] * 3, s->positions + (usize)corners[1] * 3, s->positions + (usize)corners[2] * 3);
+                for(u32 c = 0; c < 3; ++c) pla_quadric_add(&s->quadrics[s->remap[corners[c]]], &q);
+                for(u32 e = 0; e < 3; ++e){
+                        u32 i0 = corners[e], i1 = corners[(e + 1) % 3], i2 = corners[(e + 2) % 3];
+                        u8 k0 = s->kinds[i0], k1 = s->kinds[i1];
+                        bool open0 = k0 == pla_simplify_border || k0 == pla_simplify_seam;
+                        bool open1 = k1 == pla_simplify_border || k1 == pla_simplify_seam;
+                        //border to locked edges count too, else the corner of a border is free to slide.
+                        if(!open0 && !open1) continue;
+                        if(open0 && s->loop[i0] != i1) continue;
+                        if(open1 && s->loopback[i1] != i0) continue;
+                        //a seam is open on both of its sides, it's added from one.
+                        if(pla_simplify_has_opposite[k0][k1] && s->remap[i1] > s->remap[i0]) continue;
+                        pla_quadric_from_triangle_edge(&q, s->positions + (usize)i0 * 3, s->positions + (usize)i1 * 3, s->positions + (usize)i2 * 3, PLA_SIMPLIFY_BORDER_WEIGHT);
+                        pla_quadric_add(&s->quadrics[s->remap[i0]], &q);
+                        pla_quadric_add(&s->quadrics[s->remap[i1]], &q);
+                }
+        }
+}
+
+//whether from can move on to to, a border or seam vertex only moves along its open edges.
+static inline bool pla_simplify_can_move(pla_simplifier const * s, u32 from, u32 to){
+        u8 kind = s->kinds[from];
+        if(!pla_simplify_can_collapse[kind][s->kinds[to]]) return false;
+        if(kind == pla_simplify_border || kind == pla_simplify_seam) return s->loop[from] == to || s->loopback[from] == to;
+        return true;
+}
+
+//The other side of a seam vertex's move, where its wedge goes. PLA_INDEX_NONE if the seam doesn't carry on to there.
+static inline u32 pla_simplify_seam_target(pla_simplifier const * s, u32 from, u32 to){
+        u32 pair = s->wedge[from];
+        u32 target = s->loop[from] == to ? s->loopback[pair] : s->loop[pair];
+        if(target == PLA_INDEX_NONE || target == pair || s->remap[target] != s->remap[to]) return PLA_INDEX_NONE;
+        return target;
+}
+
+static inline f32 pla_simplify_attribute_error(pla_simplifier const * s, u32 a, u32 b){
+        f32 error = 0;
+        f32 const * x = s->attributes + (usize)a * s->attribute_stride;
+        f32 const * y = s->attributes + (usize)b * s->attribute_stride;
+        for(u32 i = 0; i < s->attribute_stride; ++i) error += (x[i] - y[i]) * (x[i] - y[i]);
+        return error;
+}
+
+static inline f32 pla_simplify_collapse_error(pla_simplifier const * s, u32 from, u32 to){
+        f32 error = pla_quadric_error(&s->quadrics[s->remap[from]], s->positions + (usize)to * 3);
+        if(s->attribute_stride){
+                error += pla_simplify_attribute_error(s, from, to);
+                if(s->kinds[from] == pla_simplify_seam){
+                        u32 target = pla_simplify_seam_target(s, from, to);
+                        if(target != PLA_INDEX_NONE) error += pla_simplify_attribute_error(s, s->wedge[from], target);
+                }
+        }
+        //nan attributes, it'd pass every limit.
+        return error <= FLT_MAX ? error : FLT_MAX;
+}
+
+//Every edge that can be collapsed one way or the other, once.
+static inline u32 pla_simplify_pick_collapses(pla_simplifier * s){
+        u32 count = 0;
+        for(u32 i = 0; i < s->index_count; ++i){
+                u32 i0 = s->indices[i];
+                u32 i1 = s->indices[i - i % 3 + (i % 3 + 1) % 3];
+                //a zero length edge, or a manifold vertex that reaches both sides of a seam. they're left as they are.
+                if(s->remap[i0] == s->remap[i1]) continue;
+                u8 k0 = s->kinds[i0], k1 = s->kinds[i1];
+                if(pla_simplify_has_opposite[k0][k1] && s->remap[i1] > s->remap[i0]) continue;
+                bool forward = pla_simplify_can_move(s, i0, i1);
+                bool backward = pla_simplify_can_move(s, i1, i0);
+                if(!forward && !backward) continue;
+                pla_simplify_collapse * collapse = &s->collapses[count++];
+                collapse->from = forward ? i0 : i1;
+                collapse->to = forward ? i1 : i0;
+                collapse->bidirectional = forward && backward;
+        }
+        return count;
+}
+
+//Costs the collapses and orders them by a counting sort on the top bits of the cost.
+static inline void pla_simplify_rank_collapses(pla_simplifier * s, u32 count){
+        u32 const bins = 1u << PLA_SIMPLIFY_SORT_BITS;
+        memset(s->sort_counts, 0, sizeof(u32) * bins);
+        for(u32 i = 0; i < count; ++i){
+                pla_simplify_collapse * collapse = &s->collapses[i];
+                collapse->error = pla_simplify_collapse_error(s, collapse->from, collapse->to);
+                if(collapse->bidirectional){
+                        f32 back = pla_simplify_collapse_error(s, collapse->to, collapse->from);
+                        if(back < collapse->error){
+                                u32 from = collapse->from;
+                                collapse->from = collapse->to;
+                                collapse->to = from;
+                                collapse->error = back;
+                        }
+                }
+                u32 bits;
+                memcpy(&bits, &collapse->error, sizeof(bits));
+                ++s->sort_counts[(bits >> (31 - PLA_SIMPLIFY_SORT_BITS)) & (bins - 1)];
+        }
+        u32 sum = 0;
+        for(u32 b = 0; b < bins; ++b){
+                u32 bin_count = s->sort_counts[b];
+                s->sort_counts[b] = sum;
+                sum += bin_count;
+        }
+        for(u32 i = 0; i < count; ++i){
+                u32 bits;
+                memcpy(&bits, &s->collapses[i].error, sizeof(bits));
+                s->collapse_order[s->sort_counts[(bits >> (31 - PLA_SIMPLIFY_SORT_BITS)) & (bins - 1)]++] = i;
+        }
+}
+
+//Whether moving position r0 to the position of vertex to turns a triangle around it over, with the collapses already made this pass.
+static inline bool pla_simplify_has_flips(pla_simplifier const * s, u32 r0, u32 to){
+        u32 r1 = s->remap[to];
+        f32 const * target = s->positions + (usize)to * 3;
+        for(u32 a = s->adjacency_offsets[r0]; a < s->adjacency_offsets[r0 + 1]; ++a){
+                u32 const * corners = s->indices + s->adjacency[a];
+                u32 moved[3];
+                bool gone = false;
+                for(u32 c = 0; c < 3; ++c){
+                        moved[c] = s->collapse_remap[corners[c]];
+                        gone |= s->remap[moved[c]] == r1;
+                }
+                if(gone || moved[0] == moved[1] || moved[1] == moved[2] || moved[2] == moved[0]) continue;
+                f32 const * before[3];
+                f32 const * after[3];
+                for(u32 c = 0; c < 3; ++c){
+                        before[c] = s->positions + (usize)moved[c] * 3;
+                        after[c] = s->remap[moved[c]] == r0 ? target : before[c];
+                }
+                f32 e1[3], e2[3], n0[3], n1[3];
+                pla_simplify_sub(before[1], before[0], e1);
+                pla_simplify_sub(before[2], before[0], e2);
+                pla_simplify_cross(e1, e2, n0);
+                pla_simplify_sub(after[1], after[0], e1);
+                pla_simplify_sub(after[2], after[0], e2);
+                pla_simplify_cross(e1, e2, n1);
+                if(pla_simplify_dot(n0, n1) <= 0) return true;
+        }
+        return false;
+}
+
+//Makes the ranked collapses that don't touch one made before them this pass, til the goal or the error limit. returns the triangles they remove, the error of the worst one goes in max_error.
+static inline u32 pla_simplify_perform_collapses(pla_simplifier * s, u32 count, u32 triangle_goal, f32 error_limit, f32 * max_error){
+        for(u32 v = 0; v < s->vertex_count; ++v) s->collapse_remap[v] = v;
+        memset(s->collapse_locked, 0, s->vertex_count);
+        //past the goal's worth of edges, collapses much worse than the one at the goal wait for a pass with the costs updated.
+        u32 edge_goal = triangle_goal / 2;
+        f32 error_goal = edge_goal < count ? 1.5f * s->collapses[s->collapse_order[edge_goal]].error : FLT_MAX;
+        u32 removed = 0;
+        for(u32 i = 0; i < count; ++i){
+                pla_simplify_collapse const * collapse = &s->collapses[s->collapse_order[i]];
+                if(collapse->error > error_limit || removed >= triangle_goal) break;
+                if(collapse->error > error_goal && removed > triangle_goal / 10) break;
+                u32 from = collapse->from, to = collapse->to;
+                u32 r0 = s->remap[from], r1 = s->remap[to];
+                if(s->collapse_locked[r0] || s->collapse_locked[r1]) continue;
+                if(pla_simplify_has_flips(s, r0, to)) continue;
+                u8 kind = s->kinds[from];
+                if(kind == pla_simplify_seam){
+                        u32 target = pla_simplify_seam_target(s, from, to);
+                        if(target == PLA_INDEX_NONE) continue;
+                        s->collapse_remap[from] = to;
+                        s->collapse_remap[s->wedge[from]] = target;
+                }else{
+                        u32 v = from;
+                        do{
+                                s->collapse_remap[v] = to;
+                                v = s->wedge[v];
+                        }while(v != from);
+                }
+                pla_quadric_add(&s->quadrics[r1], &s->quadrics[r0]);
+                s->collapse_locked[r0] = 1;
+                s->collapse_locked[r1] = 1;
+                removed += kind == pla_simplify_border ? 1 : 2;
+                if(collapse->error > *max_error) *max_error = collapse->error;
+        }
+        return removed;
+}
+
+//Points the open edges that went to a collapsed vertex at where it went, or past it when the collapse went against the loop.
+static inline void pla_simplify_remap_loops(pla_simplifier * s, u32 * loop){
+        for(u32 v = 0; v < s->vertex_count; ++v){
+                u32 next = loop[v];
+                if(next == PLA_INDEX_NONE || next == v) continue;
+                u32 moved = s->collapse_remap[next];
+                loop[v] = moved == v ? loop[next] : moved;
+        }
+}
+
+//Collapses til there are at most target_index_count indices or the next collapse costs more than error_limit, a squared error in the unit cube.
+static inline void pla_simplify_to(pla_simplifier * s, u32 target_index_count, f32 error_limit, f32 * max_error){
+        while(s->index_count > target_index_count){
+                pla_simplify_build_adjacency(s, s->remap, false);
+                u32 count = pla_simplify_pick_collapses(s);
+                if(!count) break;
+                pla_simplify_rank_collapses(s, count);
+                u32 removed = pla_simplify_perform_collapses(s, count, (s->index_count - target_index_count) / 3, error_limit, max_error);
+                if(!removed) break;
+                u32 kept = 0;
+                for(u32 t = 0; t < s->index_count; t += 3){
+                        u32 a = s->collapse_remap[s->indices[t]];
+                        u32 b = s->collapse_remap[s->indices[t + 1]];
+                        u32 c = s->collapse_remap[s->indices[t + 2]];
+                        if(a == b || b == c || c == a) continue;
+                        s->indices[kept++] = a;
+                        s->indices[kept++] = b;
+                        s->indices[kept++] = c;
+                }
+                s->index_count = kept;
+                pla_simplify_remap_loops(s, s->loop);
+                pla_simplify_remap_loops(s, s->loopback);
+        }
+}
+
+//Reads the weighted attributes config asks for that the primitive has, in to s->attributes.
+static inline bool pla_simplify_read_attributes(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_simplify_config const * config, pla_simplifier * s){
+        pla_accessor const * accessors[PLA_SIMPLIFY_MAX_ATTRIBUTE_FLOATS];
+        f32 weights[PLA_SIMPLIFY_MAX_ATTRIBUTE_FLOATS];
+        u32 found = 0;
+        s->attribute_stride = 0;
+        for(u32 i = 0; i < config->attribute_count; ++i){
+                pla_simplify_attribute const * attribute = &config->attributes[i];
+                for(u32 a = 0; a < primitive->attribute_count; ++a){
+                        pla_mesh_primitive_attribute const * candidate = &primitive->attributes[a];
+                        if(candidate->name != attribute->name || candidate->set_index != attribute->set_index || candidate->accessor >= gltf->accessors_size) continue;
+                        pla_accessor const * accessor = &gltf->accessors[candidate->accessor];
+                        if(accessor->type < pla_GLTF_SCALAR || accessor->type > pla_GLTF_VEC4 || accessor->count < s->vertex_count) break;
+                        u32 components = pla_GLTF_type_component_count[accessor->type];
+                        if(s->attribute_stride + components > PLA_SIMPLIFY_MAX_ATTRIBUTE_FLOATS) break;
+                        accessors[found] = accessor;
+                        weights[found++] = attribute->weight;
+                        s->attribute_stride += components;
+                        break;
+                }
+        }
+        if(!s->attribute_stride) return true;
+        pla_linear_allocator * scratch = pla_get_scratch();
+        s->attributes = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * s->attribute_stride * (usize)s->vertex_count, 16);
+        if(!s->attributes) return false;
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        f32 * values = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 4 * (usize)s->vertex_count, 16);
+        u32 offset = 0;
+        bool ok = values != PLA_NULL;
+        for(u32 i = 0; i < found && ok; ++i){
+                u32 components = pla_GLTF_type_component_count[accessors[i]->type];
+                ok = pla_read_accessor_f32(gltf, accessors[i], 0, s->vertex_count, values);
+                for(u32 v = 0; v < s->vertex_count && ok; ++v){
+                        for(u32 c = 0; c < components; ++c) s->attributes[(usize)v * s->attribute_stride + offset + c] = values[(usize)v * components + c] * weights[i];
+                }
+                offset += components;
+        }
+        pla_linear_reset_to(scratch, mark);
+        return ok;
+}
+
+//Simplifies a primitive in to target_count lods, each from the one before, writing their indices one after the other at staging.
+//staging has room for 3 indices per triangle per lod. everything else is in the calling thread's scratch.
+static inline bool pla_simplify_primitive_in(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_simplify_config const * config, pla_lod_target const * targets, u32 target_count, u32 * staging, pla_lod * out_lods){
+        memset(out_lods, 0, sizeof(pla_lod) * target_count);
+        u32 triangle_count = pla_get_primitive_triangle_count(gltf, primitive);
+        if(!triangle_count) return true;
+        pla_accessor const * position = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+        if(!position || position->type != pla_GLTF_VEC3 || !position->count) return false;
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        pla_simplifier s = {};
+        s.vertex_count = position->count;
+        s.index_count = triangle_count * 3;
+        usize v = (usize)s.vertex_count + 1;
+        usize n = (usize)s.index_count;
+        s.indices = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * n, 16);
+        s.positions = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 3 * v, 16);
+        s.remap = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        s.wedge = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        s.kinds = (u8 *)pla_linear_allocate(scratch, v, 16);
+        s.loop = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        s.loopback = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        s.quadrics = (pla_quadric *)pla_linear_allocate(scratch, sizeof(pla_quadric) * v, 16);
+        s.collapse_remap = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        s.collapse_locked = (u8 *)pla_linear_allocate(scratch, v, 16);
+        s.adjacency_offsets = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (v + 1), 16);
+        s.adjacency = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * n, 16);
+        s.collapses = (pla_simplify_collapse *)pla_linear_allocate(scratch, sizeof(pla_simplify_collapse) * n, 16);
+        s.collapse_order = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * n, 16);
+        s.sort_counts = (u32 *)pla_linear_allocate(scratch, sizeof(u32) << PLA_SIMPLIFY_SORT_BITS, 16);
+        bool ok = s.indices && s.positions && s.remap && s.wedge && s.kinds && s.loop && s.loopback && s.quadrics && s.collapse_remap && s.collapse_locked && s.adjacency_offsets && s.adjacency && s.collapses && s.collapse_order && s.sort_counts;
+        ok = ok && pla_read_primitive_triangles(gltf, primitive, 0, triangle_count, s.indices);
+        for(u32 i = 0; i < s.index_count && ok; ++i) ok = s.indices[i] < s.vertex_count;
+        if(ok){
+                //triangles with a repeated index don't draw anything, they'd only get in the way.
+                u32 kept = 0;
+                for(u32 t = 0; t < s.index_count; t += 3){
+                        u32 a = s.indices[t], b = s.indices[t + 1], c = s.indices[t + 2];
+                        if(a == b || b == c || c == a) continue;
+                        s.indices[kept++] = a;
+                        s.indices[kept++] = b;
+                        s.indices[kept++] = c;
+                }
+                s.index_count = kept;
+        }
+        ok = ok && pla_read_accessor_f32(gltf, position, 0, s.vertex_count, s.positions);
+        ok = ok && pla_simplify_read_attributes(gltf, primitive, config, &s);
+        if(ok){
+                //in to the unit cube so errors are relative, the cube's corner at the origin keeps the floats of nearby vertices apart.
+                f32 low[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+                f32 high[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+                for(u32 i = 0; i < s.vertex_count; ++i){
+                        for(u32 c = 0; c < 3; ++c){
+                                f32 x = s.positions[(usize)i * 3 + c];
+                                ok &= x == x && fabsf(x) <= FLT_MAX;
+                                low[c] = x < low[c] ? x : low[c];
+                                high[c] = x > high[c] ? x : high[c];
+                        }
+                }
+                for(u32 c = 0; c < 3; ++c) s.extent = high[c] - low[c] > s.extent ? high[c] - low[c] : s.extent;
+                ok = ok && s.extent <= FLT_MAX;
+                f32 scale = s.extent > 0 ? 1.0f / s.extent : 0;
+                for(u32 i = 0; i < s.vertex_count && ok; ++i){
+                        for(u32 c = 0; c < 3; ++c) s.positions[(usize)i * 3 + c] = (s.positions[(usize)i * 3 + c] - low[c]) * scale;
+                }
+        }
+        ok = ok && pla_simplify_weld(&s);
+        if(ok){
+                pla_simplify_build_adjacency(&s, PLA_NULL, true);
+                pla_simplify_classify(&s, config->lock_border);
+                pla_simplify_fill_quadrics(&s);
+                f32 max_error = 0;
+                u32 * at = staging;
+                for(u32 l = 0; l < target_count; ++l){
+                        f32 ratio = targets[l].triangle_ratio < 0 ? 0 : targets[l].triangle_ratio > 1 ? 1 : targets[l].triangle_ratio;
+                        u32 target_index_count = (u32)(ratio * (f32)triangle_count) * 3;
+                        pla_simplify_to(&s, target_index_count, targets[l].error * targets[l].error, &max_error);
+                        memcpy(at, s.indices, sizeof(u32) * s.index_count);
+                        out_lods[l].indices = at;
+                        out_lods[l].index_count = s.index_count;
+                        out_lods[l].error = sqrtf(max_error);
+                        at += s.index_count;
+                }
+        }
+        pla_linear_reset_to(scratch, mark);
+        return ok;
+}
+
+//Indices pla_simplify_primitive can write for a primitive at most, 3 per triangle per lod.
+inline usize pla_get_lod_staging_size(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, u32 target_count) NOEXCEPT{
+        return (usize)pla_get_primitive_triangle_count(gltf, primitive) * 3 * target_count;
+}
+
+//Simplifies a triangle list, strip or fan primitive in to a lod per target in to arena, other modes give empty lods. each lod goes on from the one before, so targets should go from most to least detail.
+//returns false if the positions, indices or attributes can't be read, an index is past the vertices or arena runs out, arena is reset to where it was then.
+inline bool pla_simplify_primitive(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_simplify_config const * config, pla_lod_target const * targets, u32 target_count, pla_linear_allocator * arena, pla_lod * out_lods) NOEXCEPT{
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark scratch_mark = pla_linear_get_mark(scratch);
+        u32 * staging = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (pla_get_lod_staging_size(gltf, primitive, target_count) + 1), 16);
+        bool ok = staging && pla_simplify_primitive_in(gltf, primitive, config, targets, target_count, staging, out_lods);
+        for(u32 l = 0; l < target_count && ok; ++l){
+                u32 * indices = (u32 *)pla_linear_allocate(arena, sizeof(u32) * ((usize)out_lods[l].index_count + 1), 16);
+                ok = indices != PLA_NULL;
+                if(ok && out_lods[l].index_count) memcpy(indices, out_lods[l].indices, sizeof(u32) * out_lods[l].index_count);
+                out_lods[l].indices = indices;
+        }
+        pla_linear_reset_to(scratch, scratch_mark);
+        if(!ok){
+                pla_linear_reset_to(arena, mark);
+                memset(out_lods, 0, sizeof(pla_lod) * target_count);
+        }
+        return ok;
+}
+
+typedef struct{
+        pla_GLTF const * gltf;
+        pla_simplify_config const * config;
+        pla_lod_target const * targets;
+        u32 target_count;
+        pla_mesh_primitive const ** primitives;
+        u32 ** staging;
+        pla_lod * lods;
+        u8 * failed;
+} pla_mesh_lods_job;
+
+static inline void pla_simplify_primitive_job(void * job_data, u32 index){
+        pla_mesh_lods_job * job = (pla_mesh_lods_job *)job_data;
+        pla_lod * lods = job->lods + (usize)index * job->target_count;
+        job->failed[index] = !pla_simplify_primitive_in(job->gltf, job->primitives[index], job->config, job->targets, job->target_count, job->staging[index], lods);
+}
+
+//Simplifies every primitive of every mesh like pla_simplify_primitive, one job per primitive, in to arena. jobs can be null.
+//the lods are staged in the calling thread's scratch til they're all done, with room for every lod at full detail, and then packed in to arena.
+//returns false like pla_simplify_primitive.
+inline bool pla_generate_mesh_lods(pla_GLTF const * gltf, pla_simplify_config const * config, pla_lod_target const * targets, u32 target_count, pla_job_system const * jobs, pla_linear_allocator * arena, pla_mesh_lods * out_lods) NOEXCEPT{
+        memset(out_lods, 0, sizeof(*out_lods));
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        u32 count = 0;
+        for(u32 m = 0; m < gltf->meshes_size; ++m) count += gltf->meshes[m].primitive_count;
+        out_lods->lods = (pla_lod *)pla_linear_allocate(arena, sizeof(pla_lod) * ((usize)count * target_count + 1), 16);
+        out_lods->first = (u32 *)pla_linear_allocate(arena, sizeof(u32) * ((usize)gltf->meshes_size + 1), 16);
+        out_lods->primitive_count = count;
+        out_lods->level_count = target_count;
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark scratch_mark = pla_linear_get_mark(scratch);
+        pla_mesh_lods_job job = {gltf, config, targets, target_count, PLA_NULL, PLA_NULL, out_lods->lods, PLA_NULL};
+        job.primitives = (pla_mesh_primitive const **)pla_linear_allocate(scratch, sizeof(pla_mesh_primitive const *) * ((usize)count + 1), 16);
+        job.staging = (u32 **)pla_linear_allocate(scratch, sizeof(u32 *) * ((usize)count + 1), 16);
+        job.failed = (u8 *)pla_linear_allocate(scratch, (usize)count + 1, 1);
+        bool ok = out_lods->lods && out_lods->first && job.primitives && job.staging && job.failed;
+        u32 at = 0;
+        for(u32 m = 0; m < gltf->meshes_size && ok; ++m){
+                out_lods->first[m] = at;
+                for(u32 p = 0; p < gltf->meshes[m].primitive_count && ok; ++p, ++at){
+                        job.primitives[at] = &gltf->meshes[m].primitives[p];
+                        job.staging[at] = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (pla_get_lod_staging_size(gltf, job.primitives[at], target_count) + 1), 16);
+                        ok = job.staging[at] != PLA_NULL;
+                }
+        }
+        if(ok) out_lods->first[gltf->meshes_size] = at;
+        if(ok) pla_parallel_for(jobs, count, pla_simplify_primitive_job, &job);
+        for(u32 i = 0; i < count && ok; ++i){
+                ok = !job.failed[i];
+                for(u32 l = 0; l < target_count && ok; ++l){
+                        pla_lod * lod = &out_lods->lods[(usize)i * target_count + l];
+                        u32 * indices = (u32 *)pla_linear_allocate(arena, sizeof(u32) * ((usize)lod->index_count + 1), 16);
+                        ok = indices != PLA_NULL;
+                        if(ok && lod->index_count) memcpy(indices, lod->indices, sizeof(u32) * lod->index_count);
+                        lod->indices = indices;
+                }
+        }
+        pla_linear_reset_to(scratch, scratch_mark);
+        if(!ok){
+                pla_linear_reset_to(arena, mark);
+                memset(out_lods, 0, sizeof(*out_lods));
+        }
+        return ok;
+}
+
+#ifdef __cplusplus
+}
+#endif
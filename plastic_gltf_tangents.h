@@ -0,0 +1,825 @@
+#pragma once
+
+//Optional module over plastic_gltf.h: MikkTSpace tangents for primitives that come without a TANGENT attribute.
+//what a primitive keeps goes in to a pla_linear_allocator the caller owns, temporaries come from the calling thread's scratch.
+
+#include "plastic_gltf.h"
+
+#include <float.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Tangents.
+//Follows mikktspace.c step for step with its default 180 degree threshold, so the tangents are the ones Blender and other bakers make normal maps against.
+//corners equal in position, normal and uv are welded, triangles with two corners at one position are left out and copy a tangent from a good triangle on the same corner later.
+//around each vertex the triangles that reach each other across shared edges with the same uv winding are a group, and a group's tangent is the angle weighted sum of its triangles' uv derivatives projected on the normal.
+//glTF's v goes down where mikktspace's goes up. the tangents are worked out on the uvs as they are and the sign is flipped, which is the same as flipping v.
+
+#define PLA_TANGENT_CHUNK 4096
+//primitives with more corners than this do their triangles and groups as jobs, smaller ones are one job each.
+#define PLA_TANGENT_PARALLEL_CORNERS 65536
+//groups with more triangles than this are checked for derivatives that could be opposite before comparing every pair.
+#define PLA_TANGENT_PAIRWISE_GROUP 16
+
+typedef struct pla_tangents{
+        //xyz and the bitangent sign in w, 4 floats per vertex like a float VEC4 TANGENT accessor. the primitive's vertices and then the split ones.
+        f32 * tangents;
+        u32 vertex_count;
+        //a vertex whose triangles don't agree on its tangent, a uv mirror without a seam, is split. split vertex i copies its other attributes from vertex split_sources[i].
+        u32 * split_sources;
+        u32 split_count;
+        //a triangle list with the split vertices in, null when nothing was split and the primitive's own indices still go with the tangents.
+        u32 * indices;
+        u32 index_count;
+} pla_tangents;
+
+//Tangents of every primitive of every mesh, mesh m's primitives start at primitives[first[m]]. empty for the ones that have a TANGENT already or have no triangles, NORMAL or TEXCOORD_0.
+typedef struct pla_mesh_tangents{
+        pla_tangents * primitives;
+        u32 * first;
+        u32 count;
+} pla_mesh_tangents;
+
+#define PLA_TANGENT_ORIENT_PRESERVING 1u
+//a triangle with no uv area or derivatives, it joins whichever group reaches it first.
+#define PLA_TANGENT_GROUP_WITH_ANY 2u
+
+typedef struct pla_tangent_triangle{
+        //the directions u and v grow in, normalized and flipped with the uv winding.
+        f32 os[3];
+        f32 ot[3];
+        //good triangles across each edge, edge i goes from corner i to the next.
+        u32 neighbors[3];
+        //the group each corner is in.
+        u32 groups[3];
+        u32 flags;
+} pla_tangent_triangle;
+
+typedef struct pla_tangent_group{
+        //welded vertex the group is around.
+        u32 vertex;
+        u32 orient_preserving;
+        //in to group_triangles.
+        u32 first;
+        u32 count;
+} pla_tangent_group;
+
+typedef struct{
+        f32 const * positions;
+        f32 const * normals;
+        f32 const * texcoords;
+        //welded corners of the good triangles.
+        u32 const * corners;
+        u32 triangle_count;
+        pla_tangent_triangle * triangles;
+        pla_tangent_group const * groups;
+        u32 group_count;
+        u32 const * group_triangles;
+        //4 per corner of the good triangles.
+        f32 * tangents;
+        u8 * failed;
+} pla_tangent_job;
+
+//mikktspace's NotZero, anything bigger than the smallest normal float.
+static inline bool pla_tangent_not_zero(f32 x){
+        return fabsf(x) > FLT_MIN;
+}
+
+static inline f32 pla_tangent_dot(f32 const * a, f32 const * b){
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static inline void pla_tangent_normalize(f32 * v){
+        if(!pla_tangent_not_zero(v[0]) && !pla_tangent_not_zero(v[1]) && !pla_tangent_not_zero(v[2])) return;
+        f32 scale = 1 / sqrtf(pla_tangent_dot(v, v));
+        for(u32 i = 0; i < 3; ++i) v[i] = scale * v[i];
+}
+
+//v with its part along n taken out, normalized unless nothing is left.
+static inline void pla_tangent_project(f32 const * v, f32 const * n, f32 * out){
+        f32 along = pla_tangent_dot(n, v);
+        for(u32 i = 0; i < 3; ++i) out[i] = v[i] - along * n[i];
+        pla_tangent_normalize(out);
+}
+
+//uv derivatives of the good triangles in a chunk.
+static inline void pla_tangent_triangle_info(void * job_data, u32 index){
+        pla_tangent_job * job = (pla_tangent_job *)job_data;
+        u32 first = index * PLA_TANGENT_CHUNK;
+        u32 count = job->triangle_count - first < PLA_TANGENT_CHUNK ? job->triangle_count - first : PLA_TANGENT_CHUNK;
+        for(u32 k = first; k < first + count; ++k){
+                pla_tangent_triangle * triangle = &job->triangles[k];
+                u32 const * corners = job->corners + (usize)k * 3;
+                f32 const * v1 = job->positions + (usize)corners[0] * 3;
+                f32 const * v2 = job->positions + (usize)corners[1] * 3;
+                f32 const * v3 = job->positions + (usize)corners[2] * 3;
+                f32 const * t1 = job->texcoords + (usize)corners[0] * 2;
+                f32 const * t2 = job->texcoords + (usize)corners[1] * 2;
+                f32 const * t3 = job->texcoords + (usize)corners[2] * 2;
+                f32 t21x = t2[0] - t1[0];
+                f32 t21y = t2[1] - t1[1];
+                f32 t31x = t3[0] - t1[0];
+                f32 t31y = t3[1] - t1[1];
+                f32 area = t21x * t31y - t21y * t31x;
+                f32 os[3], ot[3];
+                for(u32 i = 0; i < 3; ++i){
+                        f32 d1 = v2[i] - v1[i];
+                        f32 d2 = v3[i] - v1[i];
+                        os[i] = t31y * d1 - t21y * d2;
+                        ot[i] = -t31x * d1 + t21x * d2;
+                }
+                //left as they are when there's nothing to normalize, like mikktspace does.
+                memcpy(triangle->os, os, sizeof(os));
+                memcpy(triangle->ot, ot, sizeof(ot));
+                memset(triangle->neighbors, 0xff, sizeof(triangle->neighbors));
+                memset(triangle->groups, 0xff, sizeof(triangle->groups));
+                triangle->flags = PLA_TANGENT_GROUP_WITH_ANY | (area > 0 ? PLA_TANGENT_ORIENT_PRESERVING : 0);
+                if(!pla_tangent_not_zero(area)) continue;
+                f32 abs_area = fabsf(area);
+                f32 length_s = sqrtf(pla_tangent_dot(os, os));
+                f32 length_t = sqrtf(pla_tangent_dot(ot, ot));
+                f32 sign = area > 0 ? 1.0f : -1.0f;
+                if(pla_tangent_not_zero(length_s)){
+                        f32 scale = sign / length_s;
+                        for(u32 i = 0; i < 3; ++i) triangle->os[i] = scale * os[i];
+                }
+                if(pla_tangent_not_zero(length_t)){
+                        f32 scale = sign / length_t;
+                        for(u32 i = 0; i < 3; ++i) triangle->ot[i] = scale * ot[i];
+                }
+                if(pla_tangent_not_zero(length_s / abs_area) && pla_tangent_not_zero(length_t / abs_area)) triangle->flags &= ~PLA_TANGENT_GROUP_WITH_ANY;
+        }
+}
+
+//mikktspace's GetEdge, which edge of a triangle joins i0 and i1 and which way round the triangle has it.
+static inline u32 pla_tangent_get_edge(u32 const * corners, u32 i0, u32 i1, u32 * out_from, u32 * out_to){
+        if(corners[0] == i0 || corners[0] == i1){
+                if(corners[1] == i0 || corners[1] == i1){
+                        *out_from = corners[0];
+                        *out_to = corners[1];
+                        return 0;
+                }
+                *out_from = corners[2];
+                *out_to = corners[0];
+                return 2;
+        }
+        *out_from = corners[1];
+        *out_to = corners[2];
+        return 1;
+}
+
+typedef struct pla_tangent_edge{
+        u32 i0;
+        u32 i1;
+        u32 triangle;
+} pla_tangent_edge;
+
+//Pairs every edge with the first triangle after it, in order of lower corner, higher corner and triangle, that has it the other way round and isn't paired on that edge yet.
+static inline bool pla_tangent_build_neighbors(pla_tangent_job * job, u32 vertex_count){
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        usize edge_count = (usize)job->triangle_count * 3;
+        pla_tangent_edge * edges = (pla_tangent_edge *)pla_linear_allocate(scratch, sizeof(pla_tangent_edge) * (edge_count + 1), 16);
+        pla_tangent_edge * sorted = (pla_tangent_edge *)pla_linear_allocate(scratch, sizeof(pla_tangent_edge) * (edge_count + 1), 16);
+        u32 * offsets = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * ((usize)vertex_count + 1), 16);
+        if(!edges || !sorted || !offsets){
+                pla_linear_reset_to(scratch, mark);
+                return false;
+        }
+        for(usize e = 0; e < edge_count; ++e){
+                u32 a = job->corners[e];
+                u32 b = job->corners[e - e % 3 + (e % 3 + 1) % 3];
+                pla_tangent_edge edge = {a < b ? a : b, a < b ? b : a, (u32)(e / 3)};
+                edges[e] = edge;
+        }
+        //stable counting sorts on the higher corner and then the lower one, edges come in triangle order so that's the order ties are left in.
+        for(u32 pass = 0; pass < 2; ++pass){
+                memset(offsets, 0, sizeof(u32) * ((usize)vertex_count + 1));
+                for(usize e = 0; e < edge_count; ++e) ++offsets[pass ? edges[e].i0 : edges[e].i1];
+                u32 sum = 0;
+                for(u32 v = 0; v < vertex_count; ++v){
+                        u32 count = offsets[v];
+                        offsets[v] = sum;
+                        sum += count;
+                }
+                for(usize e = 0; e < edge_count; ++e) sorted[offsets[pass ? edges[e].i0 : edges[e].i1]++] = edges[e];
+                pla_tangent_edge * swap = edges;
+                edges = sorted;
+                sorted = swap;
+        }
+        //the first unpaired edge each way round only moves forward through a run of one edge, so a run shared by many triangles stays linear.
+        for(usize run = 0; run < edge_count;){
+                usize end = run + 1;
+                while(end < edge_count && edges[end].i0 == edges[run].i0 && edges[end].i1 == edges[run].i1) ++end;
+                usize next[2] = {run, run};
+                for(usize i = run; i < end; ++i){
+                        u32 a = edges[i].triangle;
+                        u32 from_a, to_a;
+                        u32 edge_a = pla_tangent_get_edge(job->corners + (usize)a * 3, edges[i].i0, edges[i].i1, &from_a, &to_a);
+                        if(job->triangles[a].neighbors[edge_a] != PLA_INDEX_NONE) continue;
+                        u32 way = from_a == edges[i].i0 ? 1 : 0;
+                        usize j = next[way] > i + 1 ? next[way] : i + 1;
+                        u32 edge_b = 0;
+                        for(; j < end; ++j){
+                                u32 from_b, to_b;
+                                edge_b = pla_tangent_get_edge(job->corners + (usize)edges[j].triangle * 3, edges[j].i0, edges[j].i1, &from_b, &to_b);
+                                if(from_a == to_b && to_a == from_b && job->triangles[edges[j].triangle].neighbors[edge_b] == PLA_INDEX_NONE) break;
+                        }
+                        next[way] = j;
+                        if(j == end) continue;
+                        job->triangles[a].neighbors[edge_a] = edges[j].triangle;
+                        job->triangles[edges[j].triangle].neighbors[edge_b] = a;
+                }
+                run = end;
+        }
+        pla_linear_reset_to(scratch, mark);
+        return true;
+}
+
+//mikktspace's AssignRecur for one triangle, with the recursion on stack. neighbors are pushed right then left so they come off in the order it calls them.
+static inline void pla_tangent_assign(pla_tangent_job * job, pla_tangent_group * groups, u32 group, u32 * group_triangles, u32 triangle, u32 * stack, u32 * stack_size){
+        pla_tangent_group * g = &groups[group];
+        pla_tangent_triangle * t = &job->triangles[triangle];
+        u32 const * corners = job->corners + (usize)triangle * 3;
+        u32 i = corners[0] == g->vertex ? 0 : corners[1] == g->vertex ? 1 : corners[2] == g->vertex ? 2 : 3;
+        if(i == 3 || t->groups[i] != PLA_INDEX_NONE) return;
+        //the first group to reach a triangle without derivatives decides its winding, the one place order matters.
+        if((t->flags & PLA_TANGENT_GROUP_WITH_ANY) && t->groups[0] == PLA_INDEX_NONE && t->groups[1] == PLA_INDEX_NONE && t->groups[2] == PLA_INDEX_NONE){
+                t->flags = (t->flags & ~PLA_TANGENT_ORIENT_PRESERVING) | (g->orient_preserving ? PLA_TANGENT_ORIENT_PRESERVING : 0);
+        }
+        if(((t->flags & PLA_TANGENT_ORIENT_PRESERVING) != 0) != (g->orient_preserving != 0)) return;
+        group_triangles[g->first + g->count++] = triangle;
+        t->groups[i] = group;
+        u32 left = t->neighbors[i];
+        u32 right = t->neighbors[i > 0 ? i - 1 : 2];
+        if(right != PLA_INDEX_NONE) stack[(*stack_size)++] = right;
+        if(left != PLA_INDEX_NONE) stack[(*stack_size)++] = left;
+}
+
+//mikktspace's Build4RuleGroups, a group for every corner of a good triangle with derivatives that isn't in one yet, grown across the edges on either side of the corner.
+static inline bool pla_tangent_build_groups(pla_tangent_job * job, pla_tangent_group * groups, u32 * group_triangles){
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        u32 * stack = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (2 * (usize)job->triangle_count + 2), 16);
+        if(!stack) return false;
+        u32 group_count = 0;
+        u32 offset = 0;
+        for(u32 k = 0; k < job->triangle_count; ++k){
+                for(u32 i = 0; i < 3; ++i){
+                        pla_tangent_triangle * t = &job->triangles[k];
+                        if((t->flags & PLA_TANGENT_GROUP_WITH_ANY) || t->groups[i] != PLA_INDEX_NONE) continue;
+                        u32 group = group_count++;
+                        pla_tangent_group * g = &groups[group];
+                        g->vertex = job->corners[(usize)k * 3 + i];
+                        g->orient_preserving = (t->flags & PLA_TANGENT_ORIENT_PRESERVING) != 0;
+                        g->first = offset;
+                        g->count = 0;
+                        group_triangles[g->first + g->count++] = k;
+                        t->groups[i] = group;
+                        u32 stack_size = 0;
+                        u32 left = t->neighbors[i];
+                        u32 right = t->neighbors[i > 0 ? i - 1 : 2];
+                        if(right != PLA_INDEX_NONE) stack[stack_size++] = right;
+                        if(left != PLA_INDEX_NONE) stack[stack_size++] = left;
+                        while(stack_size) pla_tangent_assign(job, groups, group, group_triangles, stack[--stack_size], stack, &stack_size);
+                        offset += g->count;
+                }
+        }
+        job->group_count = group_count;
+        pla_linear_reset_to(scratch, mark);
+        return true;
+}
+
+static inline void pla_tangent_sift_member(u32 * members, u32 root, u32 count, u32 const * triangles){
+        while(2 * root + 1 < count){
+                u32 child = 2 * root + 1;
+                if(child + 1 < count && triangles[members[child + 1]] > triangles[members[child]]) ++child;
+                if(triangles[members[root]] >= triangles[members[child]]) return;
+                u32 swap = members[root];
+                members[root] = members[child];
+                members[child] = swap;
+                root = child;
+        }
+}
+
+//Sorts a group's members in to triangle order, heap sorted when there are many like around the middle of a big fan.
+static inline void pla_tangent_sort_members(u32 * members, u32 count, u32 const * triangles){
+        if(count <= PLA_TANGENT_PAIRWISE_GROUP){
+                for(u32 a = 1; a < count; ++a){
+                        u32 m = members[a];
+                        u32 b = a;
+                        while(b > 0 && triangles[members[b - 1]] > triangles[m]){
+                                members[b] = members[b - 1];
+                                --b;
+                        }
+                        members[b] = m;
+                }
+                return;
+        }
+        for(u32 root = count / 2; root-- > 0;) pla_tangent_sift_member(members, root, count, triangles);
+        for(u32 end = count; end > 1;){
+                --end;
+                u32 swap = members[0];
+                members[0] = members[end];
+                members[end] = swap;
+                pla_tangent_sift_member(members, 0, end, triangles);
+        }
+}
+
+//cell of a unit vector on a grid of 1/8, 18 to an axis.
+static inline u32 pla_tangent_direction_cell(f32 const * v, f32 sign, s32 dx, s32 dy, s32 dz){
+        s32 x = (s32)floorf(sign * v[0] * 8) + 9 + dx;
+        s32 y = (s32)floorf(sign * v[1] * 8) + 9 + dy;
+        s32 z = (s32)floorf(sign * v[2] * 8) + 9 + dz;
+        if(x < 0 || y < 0 || z < 0 || x >= 18 || y >= 18 || z >= 18) return PLA_INDEX_NONE;
+        return ((u32)z * 18 + (u32)y) * 18 + (u32)x;
+}
+
+//Whether no two of a group's projected derivatives can have a cosine of -1 or less, then the subgroups are the whole group and the group without the ones with a nan in, which are lonely and in no other triangle's subgroup.
+//unit vectors with a float dot of -1 are within 0.05 of opposite so they land in neighbouring cells and shorter ones can't get there, any other length sends the group back to comparing every pair.
+static inline bool pla_tangent_no_opposites(pla_tangent_job const * job, u32 const * triangles, f32 const * projected, u32 count, u8 * lonely){
+        u32 cells[2][(18 * 18 * 18 + 31) / 32] = {};
+        for(u32 pass = 0; pass < 2; ++pass){
+                for(u32 j = 0; j < count; ++j){
+                        f32 const * v = projected + (usize)j * 6;
+                        lonely[j] = 0;
+                        if(job->triangles[triangles[j]].flags & PLA_TANGENT_GROUP_WITH_ANY) continue;
+                        for(u32 k = 0; k < 6; ++k) lonely[j] |= v[k] != v[k];
+                        if(lonely[j]) continue;
+                        for(u32 k = 0; k < 2; ++k, v += 3){
+                                f32 length = pla_tangent_dot(v, v);
+                                if(length < 0.25f) continue;
+                                if(!(length >= 0.999f && length <= 1.001f)) return false;
+                                if(!pass){
+                                        u32 cell = pla_tangent_direction_cell(v, 1, 0, 0, 0);
+                                        cells[k][cell / 32] |= 1u << (cell % 32);
+                                        continue;
+                                }
+                                for(s32 d = 0; d < 27; ++d){
+                                        u32 cell = pla_tangent_direction_cell(v, -1, d % 3 - 1, d / 3 % 3 - 1, d / 9 - 1);
+                                        if(cell != PLA_INDEX_NONE && (cells[k][cell / 32] >> (cell % 32) & 1)) return false;
+                                }
+                        }
+                }
+        }
+        return true;
+}
+
+//EvalTspace's sum of the members' projected derivatives by their angle, in member order. triangles without derivatives add nothing.
+static inline void pla_tangent_sum_members(pla_tangent_job const * job, u32 const * triangles, f32 const * projected, f32 const * angles, u32 const * members, u32 member_count, f32 * out){
+        out[0] = out[1] = out[2] = 0;
+        for(u32 a = 0; a < member_count; ++a){
+                if(job->triangles[triangles[members[a]]].flags & PLA_TANGENT_GROUP_WITH_ANY) continue;
+                f32 const * os = projected + (usize)members[a] * 6;
+                for(u32 c = 0; c < 3; ++c) out[c] = out[c] + angles[members[a]] * os[c];
+        }
+        pla_tangent_normalize(out);
+}
+
+//mikktspace's GenerateTSpaces and EvalTspace for the groups in a chunk. a triangle's subgroup is the triangles of the group whose projected derivatives aren't opposite to its own, its corner gets the subgroup's angle weighted tangent.
+static inline void pla_tangent_group_spaces(void * job_data, u32 index){
+        pla_tangent_job * job = (pla_tangent_job *)job_data;
+        u32 first = index * PLA_TANGENT_CHUNK;
+        u32 count = job->group_count - first < PLA_TANGENT_CHUNK ? job->group_count - first : PLA_TANGENT_CHUNK;
+        u32 max_count = 0;
+        for(u32 g = first; g < first + count; ++g) max_count = job->groups[g].count > max_count ? job->groups[g].count : max_count;
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        f32 * projected = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 6 * (usize)max_count, 16);
+        f32 * angles = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * (usize)max_count, 16);
+        u32 * order = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (usize)max_count, 16);
+        u32 * members = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (usize)max_count, 16);
+        u8 * lonely = (u8 *)pla_linear_allocate(scratch, (usize)max_count, 16);
+        u32 ** subgroups = (u32 **)pla_linear_allocate(scratch, sizeof(u32 *) * (usize)max_count, 16);
+        u32 * subgroup_counts = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (usize)max_count, 16);
+        u32 * subgroup_hashes = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (usize)max_count, 16);
+        f32 * subgroup_tangents = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 3 * (usize)max_count, 16);
+        if(!projected || !angles || !order || !members || !lonely || !subgroups || !subgroup_counts || !subgroup_hashes || !subgroup_tangents){
+                job->failed[index] = 1;
+                pla_linear_reset_to(scratch, mark);
+                return;
+        }
+        pla_linear_mark group_mark = pla_linear_get_mark(scratch);
+        for(u32 g = first; g < first + count; ++g){
+                pla_tangent_group const * group = &job->groups[g];
+                u32 const * triangles = job->group_triangles + group->first;
+                f32 const * n = job->normals + (usize)group->vertex * 3;
+                //every triangle of a group is projected on the same normal and has the same angle at the vertex in whichever subgroup, so they're done once.
+                for(u32 j = 0; j < group->count; ++j){
+                        pla_tangent_triangle const * t = &job->triangles[triangles[j]];
+                        pla_tangent_project(t->os, n, projected + (usize)j * 6);
+                        pla_tangent_project(t->ot, n, projected + (usize)j * 6 + 3);
+                        if(t->flags & PLA_TANGENT_GROUP_WITH_ANY) continue;
+                        u32 const * corners = job->corners + (usize)triangles[j] * 3;
+                        u32 i = corners[0] == group->vertex ? 0 : corners[1] == group->vertex ? 1 : 2;
+                        f32 const * p0 = job->positions + (usize)corners[i > 0 ? i - 1 : 2] * 3;
+                        f32 const * p1 = job->positions + (usize)corners[i] * 3;
+                        f32 const * p2 = job->positions + (usize)corners[i < 2 ? i + 1 : 0] * 3;
+                        f32 e1[3], e2[3], v1[3], v2[3];
+                        for(u32 c = 0; c < 3; ++c){
+                                e1[c] = p0[c] - p1[c];
+                                e2[c] = p2[c] - p1[c];
+                        }
+                        pla_tangent_project(e1, n, v1);
+                        pla_tangent_project(e2, n, v2);
+                        f32 cosine = pla_tangent_dot(v1, v2);
+                        cosine = cosine > 1 ? 1 : cosine < -1 ? -1 : cosine;
+                        angles[j] = (f32)acos((double)cosine);
+                }
+                //members are gathered in order of triangle, which is the order the tangent is summed in.
+                for(u32 j = 0; j < group->count; ++j) order[j] = j;
+                pla_tangent_sort_members(order, group->count, triangles);
+                bool shared = group->count > PLA_TANGENT_PAIRWISE_GROUP && pla_tangent_no_opposites(job, triangles, projected, group->count, lonely);
+                bool summed[2] = {false, false};
+                u32 subgroup_count = 0;
+                pla_linear_reset_to(scratch, group_mark);
+                for(u32 j = 0; j < group->count; ++j){
+                        u32 f = triangles[j];
+                        pla_tangent_triangle const * tf = &job->triangles[f];
+                        u32 i = tf->groups[0] == g ? 0 : tf->groups[1] == g ? 1 : 2;
+                        f32 * out = job->tangents + ((usize)f * 3 + i) * 4;
+                        out[3] = group->orient_preserving ? -1.0f : 1.0f;
+                        u32 member_count = 0;
+                        if(shared){
+                                //the other triangles in a lonely one's subgroup have no derivatives so it sums to its own.
+                                u32 any = (tf->flags & PLA_TANGENT_GROUP_WITH_ANY) != 0;
+                                if(!any && lonely[j]){
+                                        pla_tangent_sum_members(job, triangles, projected, angles, &j, 1, out);
+                                        continue;
+                                }
+                                f32 * sum = subgroup_tangents + (usize)any * 3;
+                                if(!summed[any]){
+                                        for(u32 o = 0; o < group->count; ++o){
+                                                if(!any && lonely[order[o]]) continue;
+                                                members[member_count++] = order[o];
+                                        }
+                                        pla_tangent_sum_members(job, triangles, projected, angles, members, member_count, sum);
+                                        summed[any] = true;
+                                }
+                                memcpy(out, sum, sizeof(f32) * 3);
+                                continue;
+                        }
+                        for(u32 o = 0; o < group->count; ++o){
+                                u32 m = order[o];
+                                u32 t = triangles[m];
+                                bool any = ((tf->flags | job->triangles[t].flags) & PLA_TANGENT_GROUP_WITH_ANY) != 0;
+                                f32 cos_s = pla_tangent_dot(projected + (usize)j * 6, projected + (usize)m * 6);
+                                f32 cos_t = pla_tangent_dot(projected + (usize)j * 6 + 3, projected + (usize)m * 6 + 3);
+                                //the cosine of the 180 degree threshold, -1 as a float.
+                                if(any || f == t || (cos_s > -1.0f && cos_t > -1.0f)) members[member_count++] = m;
+                        }
+                        u32 hash = 2166136261u;
+                        for(u32 a = 0; a < member_count; ++a) hash = (hash ^ members[a]) * 16777619u;
+                        u32 l = 0;
+                        while(l < subgroup_count && (subgroup_hashes[l] != hash || subgroup_counts[l] != member_count || memcmp(subgroups[l], members, sizeof(u32) * member_count) != 0)) ++l;
+                        if(l == subgroup_count){
+                                subgroups[l] = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * ((usize)member_count + 1), 16);
+                                if(!subgroups[l]){
+                                        job->failed[index] = 1;
+                                        pla_linear_reset_to(scratch, mark);
+                                        return;
+                                }
+                                memcpy(subgroups[l], members, sizeof(u32) * member_count);
+                                subgroup_counts[l] = member_count;
+                                subgroup_hashes[l] = hash;
+                                ++subgroup_count;
+                                pla_tangent_sum_members(job, triangles, projected, angles, members, member_count, subgroup_tangents + (usize)l * 3);
+                        }
+                        memcpy(out, subgroup_tangents + (usize)l * 3, sizeof(f32) * 3);
+                }
+        }
+        pla_linear_reset_to(scratch, mark);
+}
+
+static inline void pla_tangent_default(f32 * out){
+        //mikktspace's tangent for a corner no group reached, +x with its sign of -1, flipped for glTF.
+        out[0] = 1;
+        out[1] = 0;
+        out[2] = 0;
+        out[3] = 1;
+}
+
+static inline u32 pla_tangent_hash_vertex(f32 const * values){
+        u32 hash = 2166136261u;
+        for(u32 i = 0; i < 8; ++i){
+                //-0 welds with 0 like the float compare does.
+                f32 value = values[i] == 0 ? 0.0f : values[i];
+                u32 bits;
+                memcpy(&bits, &value, sizeof(bits));
+                hash = (hash ^ bits) * 16777619u;
+        }
+        return hash;
+}
+
+//The first vertex with the same position, normal and uv by float compare. vertex holds the 8 floats of each.
+static inline bool pla_tangent_weld(f32 const * vertex, u32 vertex_count, u32 * out_remap){
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        u32 table_size = 1;
+        while(table_size < vertex_count + vertex_count / 4) table_size *= 2;
+        u32 * table = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (usize)table_size, 16);
+        if(!table) return false;
+        memset(table, 0xff, sizeof(u32) * (usize)table_size);
+        for(u32 v = 0; v < vertex_count; ++v){
+                f32 const * values = vertex + (usize)v * 8;
+                u32 slot = pla_tangent_hash_vertex(values) & (table_size - 1);
+                u32 found = v;
+                for(; table[slot] != PLA_INDEX_NONE; slot = (slot + 1) & (table_size - 1)){
+                        f32 const * other = vertex + (usize)table[slot] * 8;
+                        bool equal = true;
+                        for(u32 i = 0; i < 8; ++i) equal &= other[i] == values[i];
+                        if(!equal) continue;
+                        found = table[slot];
+                        break;
+                }
+                if(found == v) table[slot] = v;
+                out_remap[v] = found;
+        }
+        pla_linear_reset_to(scratch, mark);
+        return true;
+}
+
+//The mikktspace tangent of every corner of a triangle list, strip or fan primitive, 4 floats each with the glTF sign. corners gets the vertex of each, 3 per triangle like pla_read_primitive_triangles.
+static inline bool pla_compute_corner_tangents(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_job_system const * jobs, u32 * corners, f32 * out_tangents){
+        u32 triangle_count = pla_get_primitive_triangle_count(gltf, primitive);
+        if(!triangle_count) return true;
+        pla_accessor const * position = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+        pla_accessor const * normal = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_NORMAL);
+        pla_accessor const * texcoord = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_TEXCOORD);
+        if(!position || !normal || !texcoord || position->type != pla_GLTF_VEC3 || normal->type != pla_GLTF_VEC3 || texcoord->type != pla_GLTF_VEC2) return false;
+        u32 vertex_count = position->count;
+        if(normal->count < vertex_count || texcoord->count < vertex_count) return false;
+        usize corner_count = (usize)triangle_count * 3;
+        if(!pla_read_primitive_triangles(gltf, primitive, 0, triangle_count, corners)) return false;
+        for(usize c = 0; c < corner_count; ++c){
+                if(corners[c] >= vertex_count) return false;
+        }
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        usize v = (usize)vertex_count + 1;
+        f32 * positions = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 3 * v, 16);
+        f32 * normals = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 3 * v, 16);
+        f32 * texcoords = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 2 * v, 16);
+        f32 * vertex = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 8 * v, 16);
+        u32 * remap = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        u32 * first_corner = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * v, 16);
+        u32 * good = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * ((usize)triangle_count + 1), 16);
+        u32 * welded = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (corner_count + 1), 16);
+        pla_tangent_triangle * triangles = (pla_tangent_triangle *)pla_linear_allocate(scratch, sizeof(pla_tangent_triangle) * ((usize)triangle_count + 1), 16);
+        pla_tangent_group * groups = (pla_tangent_group *)pla_linear_allocate(scratch, sizeof(pla_tangent_group) * (corner_count + 1), 16);
+        u32 * group_triangles = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (corner_count + 1), 16);
+        f32 * good_tangents = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 4 * (corner_count + 1), 16);
+        u8 * failed = (u8 *)pla_linear_allocate(scratch, corner_count / PLA_TANGENT_CHUNK + 2, 1);
+        bool ok = positions && normals && texcoords && vertex && remap && first_corner && good && welded && triangles && groups && group_triangles && good_tangents && failed;
+        ok = ok && pla_read_accessor_f32(gltf, position, 0, vertex_count, positions);
+        ok = ok && pla_read_accessor_f32(gltf, normal, 0, vertex_count, normals);
+        ok = ok && pla_read_accessor_f32(gltf, texcoord, 0, vertex_count, texcoords);
+        if(ok){
+                for(u32 i = 0; i < vertex_count; ++i){
+                        memcpy(vertex + (usize)i * 8, positions + (usize)i * 3, sizeof(f32) * 3);
+                        memcpy(vertex + (usize)i * 8 + 3, normals + (usize)i * 3, sizeof(f32) * 3);
+                        memcpy(vertex + (usize)i * 8 + 6, texcoords + (usize)i * 2, sizeof(f32) * 2);
+                }
+                ok = pla_tangent_weld(vertex, vertex_count, remap);
+        }
+        if(!ok){
+                pla_linear_reset_to(scratch, mark);
+                return false;
+        }
+
+        //good triangles first in their order, triangles with two corners at one position are left til the end.
+        u32 good_count = 0;
+        for(u32 t = 0; t < triangle_count; ++t){
+                u32 const * c = corners + (usize)t * 3;
+                f32 const * p[3];
+                for(u32 i = 0; i < 3; ++i) p[i] = positions + (usize)remap[c[i]] * 3;
+                bool degenerate = false;
+                for(u32 i = 0; i < 3; ++i){
+                        f32 const * a = p[i];
+                        f32 const * b = p[(i + 1) % 3];
+                        degenerate |= a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+                }
+                if(degenerate) continue;
+                for(u32 i = 0; i < 3; ++i) welded[(usize)good_count * 3 + i] = remap[c[i]];
+                good[good_count++] = t;
+        }
+        pla_tangent_job job = {positions, normals, texcoords, welded, good_count, triangles, groups, 0, group_triangles, good_tangents, failed};
+        u32 triangle_chunks = (good_count + PLA_TANGENT_CHUNK - 1) / PLA_TANGENT_CHUNK;
+        pla_parallel_for(jobs, triangle_chunks, pla_tangent_triangle_info, &job);
+        ok = pla_tangent_build_neighbors(&job, vertex_count) && pla_tangent_build_groups(&job, groups, group_triangles);
+        if(ok){
+                for(usize c = 0; c < (usize)good_count * 3; ++c) pla_tangent_default(good_tangents + c * 4);
+                u32 group_chunks = (job.group_count + PLA_TANGENT_CHUNK - 1) / PLA_TANGENT_CHUNK;
+                memset(failed, 0, (usize)group_chunks + 1);
+                pla_parallel_for(jobs, group_chunks, pla_tangent_group_spaces, &job);
+                for(u32 i = 0; i < group_chunks; ++i) ok &= !failed[i];
+        }
+        if(ok){
+                memset(first_corner, 0xff, sizeof(u32) * v);
+                for(u32 k = 0; k < good_count; ++k){
+                        for(u32 i = 0; i < 3; ++i){
+                                u32 w = welded[(usize)k * 3 + i];
+                                if(first_corner[w] == PLA_INDEX_NONE) first_corner[w] = k * 3 + i;
+                                memcpy(out_tangents + ((usize)good[k] * 3 + i) * 4, good_tangents + ((usize)k * 3 + i) * 4, sizeof(f32) * 4);
+                        }
+                }
+                //triangles that were left out take the tangent of the first good corner on the same welded vertex.
+                u32 next_good = 0;
+                for(u32 t = 0; t < triangle_count; ++t){
+                        if(next_good < good_count && good[next_good] == t){
+                                ++next_good;
+                                continue;
+                        }
+                        for(u32 i = 0; i < 3; ++i){
+                                u32 source = first_corner[remap[corners[(usize)t * 3 + i]]];
+                                f32 * out = out_tangents + ((usize)t * 3 + i) * 4;
+                                if(source == PLA_INDEX_NONE) pla_tangent_default(out);
+                                else memcpy(out, good_tangents + (usize)source * 4, sizeof(f32) * 4);
+                        }
+                }
+        }
+        pla_linear_reset_to(scratch, mark);
+        return ok;
+}
+
+//Turns corner tangents in to one per vertex in to arena, splitting vertices whose corners got different ones.
+static inline bool pla_resolve_corner_tangents(u32 const * corners, f32 const * corner_tangents, usize corner_count, u32 vertex_count, pla_linear_allocator * arena, pla_tangents * out_tangents){
+        memset(out_tangents, 0, sizeof(*out_tangents));
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark mark = pla_linear_get_mark(scratch);
+        usize capacity = (usize)vertex_count + corner_count + 1;
+        usize table_size = 1;
+        while(table_size < corner_count + corner_count / 2 + 1) table_size *= 2;
+        f32 * tangents = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 4 * capacity, 16);
+        u8 * used = (u8 *)pla_linear_allocate(scratch, (usize)vertex_count + 1, 16);
+        u32 * table = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * table_size, 16);
+        u32 * sources = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (corner_count + 1), 16);
+        u32 * indices = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * (corner_count + 1), 16);
+        bool ok = capacity <= UINT32_MAX && tangents && used && table && sources && indices;
+        u32 split_count = 0;
+        if(ok){
+                //vertices no triangle uses keep mikktspace's default.
+                for(u32 i = 0; i < vertex_count; ++i) pla_tangent_default(tangents + (usize)i * 4);
+                memset(used, 0, vertex_count);
+                memset(table, 0xff, sizeof(u32) * table_size);
+                //vertex and tangent bits to the vertex that has them, the first tangent a vertex gets keeps its index and the others are split off in the order they come.
+                for(usize c = 0; c < corner_count; ++c){
+                        u32 vertex = corners[c];
+                        f32 const * tangent = corner_tangents + c * 4;
+                        u32 hash = vertex * 2654435761u;
+                        for(u32 k = 0; k < 4; ++k){
+                                u32 bits;
+                                memcpy(&bits, tangent + k, sizeof(bits));
+                                hash = (hash ^ bits) * 16777619u;
+                        }
+                        usize slot = hash & (table_size - 1);
+                        for(; table[slot] != PLA_INDEX_NONE; slot = (slot + 1) & (table_size - 1)){
+                                u32 at = table[slot];
+                                u32 source = at < vertex_count ? at : sources[at - vertex_count];
+                                if(source == vertex && memcmp(tangents + (usize)at * 4, tangent, sizeof(f32) * 4) == 0) break;
+                        }
+                        if(table[slot] == PLA_INDEX_NONE){
+                                u32 at = vertex;
+                                if(used[vertex]){
+                                        sources[split_count] = vertex;
+                                        at = vertex_count + split_count++;
+                                }
+                                used[vertex] = 1;
+                                memcpy(tangents + (usize)at * 4, tangent, sizeof(f32) * 4);
+                                table[slot] = at;
+                        }
+                        indices[c] = table[slot];
+                }
+        }
+        if(ok){
+                u32 total = vertex_count + split_count;
+                out_tangents->tangents = (f32 *)pla_linear_allocate(arena, sizeof(f32) * 4 * ((usize)total + 1), 16);
+                out_tangents->split_sources = split_count ? (u32 *)pla_linear_allocate(arena, sizeof(u32) * split_count, 16) : PLA_NULL;
+                out_tangents->indices = split_count ? (u32 *)pla_linear_allocate(arena, sizeof(u32) * corner_count, 16) : PLA_NULL;
+                ok = out_tangents->tangents && (!split_count || (out_tangents->split_sources && out_tangents->indices));
+                if(ok){
+                        memcpy(out_tangents->tangents, tangents, sizeof(f32) * 4 * total);
+                        if(split_count){
+                                memcpy(out_tangents->split_sources, sources, sizeof(u32) * split_count);
+                                memcpy(out_tangents->indices, indices, sizeof(u32) * corner_count);
+                        }
+                        out_tangents->vertex_count = total;
+                        out_tangents->split_count = split_count;
+                        out_tangents->index_count = split_count ? (u32)corner_count : 0;
+                }
+        }
+        pla_linear_reset_to(scratch, mark);
+        return ok;
+}
+
+//Generates the mikktspace tangents of a triangle list, strip or fan primitive in to arena, points and lines give no tangents. the triangles and the groups are done as jobs, jobs can be null.
+//returns false if the primitive has triangles but no NORMAL or TEXCOORD_0, they or the indices can't be read, an index is past the vertices or arena runs out, arena is reset to where it was then.
+inline bool pla_generate_tangents(pla_GLTF const * gltf, pla_mesh_primitive const * primitive, pla_job_system const * jobs, pla_linear_allocator * arena, pla_tangents * out_tangents) NOEXCEPT{
+        memset(out_tangents, 0, sizeof(*out_tangents));
+        usize corner_count = (usize)pla_get_primitive_triangle_count(gltf, primitive) * 3;
+        if(!corner_count) return true;
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark scratch_mark = pla_linear_get_mark(scratch);
+        u32 * corners = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * corner_count, 16);
+        f32 * corner_tangents = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 4 * corner_count, 16);
+        pla_accessor const * position = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+        bool ok = corners && corner_tangents && position && pla_compute_corner_tangents(gltf, primitive, jobs, corners, corner_tangents);
+        ok = ok && pla_resolve_corner_tangents(corners, corner_tangents, corner_count, position->count, arena, out_tangents);
+        pla_linear_reset_to(scratch, scratch_mark);
+        if(!ok){
+                pla_linear_reset_to(arena, mark);
+                memset(out_tangents, 0, sizeof(*out_tangents));
+        }
+        return ok;
+}
+
+//whether pla_generate_mesh_tangents makes tangents for a primitive.
+static inline bool pla_primitive_needs_tangents(pla_GLTF const * gltf, pla_mesh_primitive const * primitive){
+        pla_mesh_primitive_attribute const * attributes = primitive->attributes;
+        u32 count = primitive->attribute_count;
+        return pla_get_primitive_triangle_count(gltf, primitive) && !pla_find_attribute_accessor(gltf, attributes, count, pla_TANGENT) && pla_find_attribute_accessor(gltf, attributes, count, pla_NORMAL) && pla_find_attribute_accessor(gltf, attributes, count, pla_TEXCOORD);
+}
+
+typedef struct{
+        pla_GLTF const * gltf;
+        pla_mesh_primitive const ** primitives;
+        u32 ** corners;
+        f32 ** tangents;
+        u32 const * small;
+        u8 * failed;
+} pla_mesh_tangents_job;
+
+static inline void pla_compute_small_primitive_tangents(void * job_data, u32 index){
+        pla_mesh_tangents_job * job = (pla_mesh_tangents_job *)job_data;
+        u32 i = job->small[index];
+        job->failed[i] = !pla_compute_corner_tangents(job->gltf, job->primitives[i], PLA_NULL, job->corners[i], job->tangents[i]);
+}
+
+//Generates tangents like pla_generate_tangents for every primitive of every mesh that has triangles, NORMAL and TEXCOORD_0 but no TANGENT, in to arena.
+//small primitives are one job each and big ones go one after the other with their triangles and groups as jobs. the corner tangents are staged in the calling thread's scratch til they're all done.
+//returns false like pla_generate_tangents.
+inline bool pla_generate_mesh_tangents(pla_GLTF const * gltf, pla_job_system const * jobs, pla_linear_allocator * arena, pla_mesh_tangents * out_tangents) NOEXCEPT{
+        memset(out_tangents, 0, sizeof(*out_tangents));
+        pla_linear_mark mark = pla_linear_get_mark(arena);
+        u32 count = 0;
+        for(u32 m = 0; m < gltf->meshes_size; ++m) count += gltf->meshes[m].primitive_count;
+        out_tangents->primitives = (pla_tangents *)pla_linear_allocate(arena, sizeof(pla_tangents) * ((usize)count + 1), 16);
+        out_tangents->first = (u32 *)pla_linear_allocate(arena, sizeof(u32) * ((usize)gltf->meshes_size + 1), 16);
+        out_tangents->count = count;
+
+        pla_linear_allocator * scratch = pla_get_scratch();
+        pla_linear_mark scratch_mark = pla_linear_get_mark(scratch);
+        pla_mesh_tangents_job job = {gltf, PLA_NULL, PLA_NULL, PLA_NULL, PLA_NULL, PLA_NULL};
+        job.primitives = (pla_mesh_primitive const **)pla_linear_allocate(scratch, sizeof(pla_mesh_primitive const *) * ((usize)count + 1), 16);
+        job.corners = (u32 **)pla_linear_allocate(scratch, sizeof(u32 *) * ((usize)count + 1), 16);
+        job.tangents = (f32 **)pla_linear_allocate(scratch, sizeof(f32 *) * ((usize)count + 1), 16);
+        u32 * small = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * ((usize)count + 1), 16);
+        job.small = small;
+        job.failed = (u8 *)pla_linear_allocate(scratch, (usize)count + 1, 1);
+        bool ok = out_tangents->primitives && out_tangents->first && job.primitives && job.corners && job.tangents && small && job.failed;
+        if(ok) memset(out_tangents->primitives, 0, sizeof(pla_tangents) * count);
+
+        u32 small_count = 0;
+        u32 at = 0;
+        for(u32 m = 0; m < gltf->meshes_size && ok; ++m){
+                out_tangents->first[m] = at;
+                for(u32 p = 0; p < gltf->meshes[m].primitive_count && ok; ++p, ++at){
+                        pla_mesh_primitive const * primitive = &gltf->meshes[m].primitives[p];
+                        job.primitives[at] = primitive;
+                        job.corners[at] = PLA_NULL;
+                        job.tangents[at] = PLA_NULL;
+                        job.failed[at] = 0;
+                        if(!pla_primitive_needs_tangents(gltf, primitive)) continue;
+                        usize corner_count = (usize)pla_get_primitive_triangle_count(gltf, primitive) * 3;
+                        job.corners[at] = (u32 *)pla_linear_allocate(scratch, sizeof(u32) * corner_count, 16);
+                        job.tangents[at] = (f32 *)pla_linear_allocate(scratch, sizeof(f32) * 4 * corner_count, 16);
+                        ok = job.corners[at] && job.tangents[at];
+                        if(corner_count <= PLA_TANGENT_PARALLEL_CORNERS) small[small_count++] = at;
+                }
+        }
+        if(ok) out_tangents->first[gltf->meshes_size] = at;
+        if(ok) pla_parallel_for(jobs, small_count, pla_compute_small_primitive_tangents, &job);
+        for(u32 i = 0; i < count && ok; ++i){
+                if(!job.corners[i]) continue;
+                pla_mesh_primitive const * primitive = job.primitives[i];
+                usize corner_count = (usize)pla_get_primitive_triangle_count(gltf, primitive) * 3;
+                if(corner_count > PLA_TANGENT_PARALLEL_CORNERS) ok = pla_compute_corner_tangents(gltf, primitive, jobs, job.corners[i], job.tangents[i]);
+                ok = ok && !job.failed[i];
+                pla_accessor const * position = pla_find_attribute_accessor(gltf, primitive->attributes, primitive->attribute_count, pla_POSITION);
+                ok = ok && position && pla_resolve_corner_tangents(job.corners[i], job.tangents[i], corner_count, position->count, arena, &out_tangents->primitives[i]);
+        }
+        pla_linear_reset_to(scratch, scratch_mark);
+        if(!ok){
+                pla_linear_reset_to(arena, mark);
+                memset(out_tangents, 0, sizeof(*out_tangents));
+        }
+        return ok;
+}
+
+#ifdef __cplusplus
+}
+#endif
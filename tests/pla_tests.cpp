@@ -0,0 +1,161 @@
+//Checks for behaviour the fuzz target can't see, prints every failed check and exits with 1 if there was one.
+//
+//    c++ -std=c++2b -g -fsanitize=address,undefined tests/pla_tests.cpp -o pla_tests
+//    ./pla_tests
+
+#define PLA_USE_POSIX
+#include "../plastic_gltf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static int pla_test_failures = 0;
+
+#define PLA_CHECK(condition) do{ \
+        if(!(condition)){ \
+                fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+                ++pla_test_failures; \
+        } \
+}while(0)
+
+typedef struct{
+        pla_file_system posix;
+        u32 open_count;
+        u32 close_count;
+} counting_file_system;
+
+static bool counting_open(void * user_data, pla_str uri, u8 const ** out_data, usize * out_size, void ** out_handle){
+        counting_file_system * counting = (counting_file_system *)user_data;
+        if(!counting->posix.open(counting->posix.user_data, uri, out_data, out_size, out_handle)) return false;
+        ++counting->open_count;
+        return true;
+}
+
+static void counting_close(void * user_data, void * handle, u8 const * data, usize size){
+        counting_file_system * counting = (counting_file_system *)user_data;
+        ++counting->close_count;
+        counting->posix.close(counting->posix.user_data, handle, data, size);
+}
+
+static void test_release_posix_images(){
+        char directory[] = "/tmp/pla_tests_XXXXXX";
+        PLA_CHECK(mkdtemp(directory) != PLA_NULL);
+        std::vector<char> path(sizeof(directory) + 16);
+        snprintf(path.data(), path.size(), "%s/a.png", directory);
+        //a png signature and header for a 2 x 3 rgba image.
+        u8 const png[33] = {0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a, 0, 0, 0, 13, 'I', 'H', 'D', 'R', 0, 0, 0, 2, 0, 0, 0, 3, 8, 6, 0, 0, 0, 0, 0, 0, 0};
+        FILE * file = fopen(path.data(), "wb");
+        PLA_CHECK(file && fwrite(png, 1, sizeof(png), file) == sizeof(png));
+        if(file) fclose(file);
+
+        char const json[] = "{\"asset\":{\"version\":\"2.0\"},\"images\":[{\"uri\":\"a.png\"},{\"uri\":\"data:image/png;base64,iVBORw0KGgo=\"}]}";
+        size_t memory_size = 0;
+        PLA_CHECK(pla_parse_GLTF(sizeof(json) - 1, (u8 const *)json, &memory_size, PLA_NULL, PLA_NULL));
+        std::vector<u8> memory(memory_size + 1);
+        pla_GLTF gltf = {};
+        PLA_CHECK(pla_parse_GLTF(sizeof(json) - 1, (u8 const *)json, &memory_size, memory.data(), &gltf));
+
+        pla_posix_file_system posix = {directory, PLA_NULL};
+        counting_file_system counting = {pla_get_posix_file_system(&posix), 0, 0};
+        pla_file_system file_system = {&counting, counting_open, counting_close};
+        std::vector<u8> image_memory(pla_get_image_memory_size(&gltf) + 1);
+        PLA_CHECK(pla_resolve_images(&gltf, &file_system, PLA_NULL, image_memory.size(), image_memory.data()));
+        PLA_CHECK(counting.open_count == 1);
+        PLA_CHECK(gltf.images[0].data && gltf.images[0].file_handle == PLA_NULL);
+        PLA_CHECK(gltf.images[0].width == 2 && gltf.images[0].height == 3);
+
+        pla_release_images(&gltf, &file_system);
+        PLA_CHECK(counting.close_count == 1);
+        PLA_CHECK(gltf.images[0].data == PLA_NULL);
+        //the data uri lives in image_memory and isn't closed.
+        PLA_CHECK(gltf.images[1].data != PLA_NULL);
+
+        remove(path.data());
+        rmdir(directory);
+}
+
+static void test_skin_joints(){
+        //joints 0, 1, 0, 0 as bytes, weights 0.25, 0.75, 0, 0 and the same joints as floats.
+        char const json[] = "{\"asset\":{\"version\":\"2.0\"},"
+                "\"buffers\":[{\"byteLength\":36,\"uri\":\"data:application/octet-stream;base64,AAEAAAAAgD4AAEA/AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAA\"}],"
+                "\"bufferViews\":[{\"buffer\":0,\"byteLength\":4},{\"buffer\":0,\"byteOffset\":4,\"byteLength\":16},{\"buffer\":0,\"byteOffset\":20,\"byteLength\":16}],"
+                "\"accessors\":[{\"bufferView\":0,\"componentType\":5121,\"count\":1,\"type\":\"VEC4\"},{\"bufferView\":1,\"componentType\":5126,\"count\":1,\"type\":\"VEC4\"},{\"bufferView\":2,\"componentType\":5126,\"count\":1,\"type\":\"VEC4\"}],"
+                "\"meshes\":[{\"primitives\":[{\"attributes\":{\"JOINTS_0\":0,\"WEIGHTS_0\":1}},{\"attributes\":{\"JOINTS_0\":2,\"WEIGHTS_0\":1}}]}],"
+                "\"skins\":[{\"joints\":[0]},{\"joints\":[0,1]}],"
+                "\"nodes\":[{\"mesh\":0,\"skin\":1},{}]}";
+        size_t memory_size = 0;
+        PLA_CHECK(pla_parse_GLTF(sizeof(json) - 1, (u8 const *)json, &memory_size, PLA_NULL, PLA_NULL));
+        std::vector<u8> memory(memory_size + 1);
+        pla_GLTF gltf = {};
+        PLA_CHECK(pla_parse_GLTF(sizeof(json) - 1, (u8 const *)json, &memory_size, memory.data(), &gltf));
+        std::vector<u8> buffer_memory(pla_get_buffer_memory_size(&gltf) + 1);
+        PLA_CHECK(pla_resolve_buffers(&gltf, PLA_NULL, PLA_NULL, buffer_memory.size(), buffer_memory.data()));
+        //float joints aren't allowed.
+        PLA_CHECK(!pla_validate_gltf(&gltf));
+
+        pla_skin_packing packing = pla_default_skin_packing();
+        pla_mesh_primitive const * primitives = gltf.meshes[0].primitives;
+        u8 influences[8] = {};
+        usize size = sizeof(influences);
+        PLA_CHECK(pla_pack_skin_influences(&gltf, &primitives[0], &gltf.skins[1], &packing, &size, influences));
+        PLA_CHECK(influences[0] == 1 && influences[1] == 0 && influences[4] + influences[5] == 255);
+        //joint 1 isn't in a skin of one joint.
+        PLA_CHECK(!pla_pack_skin_influences(&gltf, &primitives[0], &gltf.skins[0], &packing, &size, influences));
+        PLA_CHECK(!pla_pack_skin_influences(&gltf, &primitives[1], &gltf.skins[1], &packing, &size, influences));
+}
+
+static void test_resampled_frame_count(){
+        pla_animation_clip clip = {};
+        clip.end_time = 1;
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, 30) == 31);
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, 0) == 0);
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, NAN) == 0);
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, INFINITY) == 0);
+        clip.end_time = 0;
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, 30) == 1);
+        clip.end_time = 1e30f;
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, 30) == 0);
+        clip.end_time = INFINITY;
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, 30) == 0);
+        clip.end_time = NAN;
+        PLA_CHECK(pla_get_resampled_frame_count(&clip, 30) == 0);
+        f32 out = 0;
+        f32 * outs[1] = {&out};
+        PLA_CHECK(!pla_resample_animation_clip(&clip, 30, &out));
+        PLA_CHECK(!pla_resample_animation_clips(&clip, 1, 30, outs, PLA_NULL));
+}
+
+static f64 to_f64(char const * text){
+        pla_str str = {(u8 const *)text, strlen(text)};
+        return pla_str_to_f64(str);
+}
+
+static void test_str_to_f64(){
+        PLA_CHECK(to_f64("0") == 0);
+        PLA_CHECK(to_f64("-12.5") == -12.5);
+        PLA_CHECK(to_f64("1e22") == 1e22);
+        PLA_CHECK(to_f64("2.2250738585072014e-308") == 2.2250738585072014e-308);
+        PLA_CHECK(to_f64("1e-400") == 0);
+        //too large for a double.
+        PLA_CHECK(to_f64("1e400") == INFINITY);
+        PLA_CHECK(to_f64("-1e400") == -INFINITY);
+        PLA_CHECK(to_f64("1.8e308") == INFINITY);
+        PLA_CHECK(to_f64("123456789012345678901234567890e300") == INFINITY);
+        //leading zeros aren't significant digits.
+        PLA_CHECK(to_f64("0.0000000000000000000012345") == 1.2345e-21);
+        PLA_CHECK(fabs(to_f64("0.000000000000000000001234567890123456789") / 1.234567890123456789e-21 - 1) < 1e-15);
+        PLA_CHECK(to_f64("00000000000000000000000012.5") == 12.5);
+        PLA_CHECK(to_f64("-0.000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001e100") == -1e-14);
+}
+
+int main(){
+        test_release_posix_images();
+        test_skin_joints();
+        test_resampled_frame_count();
+        test_str_to_f64();
+        if(pla_test_failures) fprintf(stderr, "%d checks failed\n", pla_test_failures);
+        else printf("all checks passed\n");
+        return pla_test_failures ? 1 : 0;
+}
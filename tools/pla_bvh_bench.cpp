@@ -0,0 +1,309 @@
+//Times building the bvhs of a file's meshes and scene on one thread and on --threads, then ray and closest point queries against them.
+//Each build runs --runs times and the fastest is kept. rays go from around the scene's bounds to random points inside them, closest points are asked for inside the bounds too.
+//--check compares that many of the rays and points against testing every triangle and prints how many disagree, it should be 0.
+//
+//    c++ -std=c++2b -O2 -pthread tools/pla_bvh_bench.cpp -o pla_bvh_bench
+//    ./pla_bvh_bench --runs 5 --threads 8 --queries 1000000 scans/*.glb
+
+#define PLA_USE_POSIX
+#include "../plastic_gltf_bvh.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+static u64 now_ns(){
+        return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//Workers that wait for parallel_for calls, the calling thread takes indices too.
+struct thread_pool{
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::vector<std::thread> workers;
+        void (*job)(void *, u32) = nullptr;
+        void * job_data = nullptr;
+        u32 count = 0;
+        std::atomic<u32> next{0};
+        u32 busy = 0;
+        u64 generation = 0;
+        bool stop = false;
+
+        explicit thread_pool(u32 thread_count){
+                for(u32 i = 1; i < thread_count; ++i) workers.emplace_back([this]{ work(); });
+        }
+
+        ~thread_pool(){
+                {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        stop = true;
+                }
+                wake.notify_all();
+                for(std::thread & worker : workers) worker.join();
+        }
+
+        void run_jobs(){
+                for(u32 i; (i = next.fetch_add(1)) < count;) job(job_data, i);
+        }
+
+        void work(){
+                u64 seen = 0;
+                for(;;){
+                        {
+                                std::unique_lock<std::mutex> lock(mutex);
+                                wake.wait(lock, [&]{ return stop || generation != seen; });
+                                if(stop) break;
+                                seen = generation;
+                                ++busy;
+                        }
+                        run_jobs();
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if(--busy == 0) done.notify_one();
+                }
+                pla_release_scratch();
+        }
+
+        static void parallel_for(void * user_data, u32 count, void (*job)(void *, u32), void * job_data){
+                thread_pool * pool = (thread_pool *)user_data;
+                {
+                        std::lock_guard<std::mutex> lock(pool->mutex);
+                        pool->job = job;
+                        pool->job_data = job_data;
+                        pool->count = count;
+                        pool->next = 0;
+                        ++pool->generation;
+                }
+                pool->wake.notify_all();
+                pool->run_jobs();
+                std::unique_lock<std::mutex> lock(pool->mutex);
+                pool->done.wait(lock, [&]{ return pool->busy == 0; });
+        }
+};
+
+struct query_set{
+        std::vector<f32> origins;
+        std::vector<f32> directions;
+        std::vector<f32> points;
+};
+
+static query_set make_queries(f32 const * min, f32 const * max, u32 count){
+        std::mt19937 random(1);
+        std::uniform_real_distribution<f32> unit(0, 1);
+        query_set queries;
+        queries.origins.resize((usize)count * 3);
+        queries.directions.resize((usize)count * 3);
+        queries.points.resize((usize)count * 3);
+        for(u32 i = 0; i < count; ++i){
+                for(u32 a = 0; a < 3; ++a){
+                        f32 extent = max[a] - min[a];
+                        f32 origin = min[a] - extent * 0.5f + unit(random) * extent * 2;
+                        f32 target = min[a] + unit(random) * extent;
+                        queries.origins[i * 3 + a] = origin;
+                        queries.directions[i * 3 + a] = target - origin;
+                        queries.points[i * 3 + a] = min[a] + unit(random) * extent;
+                }
+        }
+        return queries;
+}
+
+//World space triangles of the whole scene for the brute force checks.
+static std::vector<f32> gather_world_triangles(pla_scene_bvh const & scene){
+        std::vector<f32> triangles;
+        for(u32 i = 0; i < scene.instance_count; ++i){
+                pla_bvh_instance const & instance = scene.instances[i];
+                for(u32 b = scene.meshes.first[instance.mesh]; b < scene.meshes.first[instance.mesh + 1]; ++b){
+                        pla_bvh const & bvh = scene.meshes.bvhs[b];
+                        for(usize c = 0; c < (usize)bvh.item_count * 3; ++c){
+                                f32 world[3];
+                                pla_transform_point(instance.local_to_world, bvh.triangles + c * 3, world);
+                                triangles.insert(triangles.end(), world, world + 3);
+                        }
+                }
+        }
+        return triangles;
+}
+
+static pla_bvh const * largest_bvh(pla_mesh_bvhs const & meshes){
+        pla_bvh const * largest = nullptr;
+        for(u32 i = 0; i < meshes.count; ++i) if(!largest || meshes.bvhs[i].item_count > largest->item_count) largest = &meshes.bvhs[i];
+        return largest && largest->node_count ? largest : nullptr;
+}
+
+static bool load(std::string const & path, pla_linear_allocator * memory, pla_file_system * file_system, pla_GLTF * gltf, std::vector<u8> & data){
+        FILE * file = fopen(path.c_str(), "rb");
+        if(!file) return false;
+        u8 chunk[65536];
+        for(usize read; (read = fread(chunk, 1, sizeof(chunk), file)) > 0;) data.insert(data.end(), chunk, chunk + read);
+        fclose(file);
+        if(data.size() > UINT32_MAX || !pla_parse_GLTF_with_allocator((u32)data.size(), data.data(), memory, gltf, PLA_NULL)) return false;
+        usize buffer_size = pla_get_buffer_memory_size(gltf);
+        u8 * buffer_memory = (u8 *)pla_linear_allocate(memory, buffer_size, 16);
+        if(!buffer_memory || !pla_resolve_buffers(gltf, file_system, PLA_NULL, buffer_size, buffer_memory)) return false;
+        usize meshopt_size = pla_get_meshopt_memory_size(gltf);
+        u8 * meshopt_memory = (u8 *)pla_linear_allocate(memory, meshopt_size, 16);
+        return meshopt_memory && pla_decode_meshopt_buffer_views(gltf, PLA_NULL, meshopt_size, meshopt_memory);
+}
+
+int main(int argc, char ** argv){
+        u32 runs = 5;
+        u32 thread_count = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+        u32 query_count = 1 << 20;
+        u32 check_count = 1000;
+        std::vector<std::string> paths;
+        for(int i = 1; i < argc; ++i){
+                std::string arg = argv[i];
+                if(arg == "--runs" && i + 1 < argc) runs = (u32)atoi(argv[++i]);
+                else if(arg == "--threads" && i + 1 < argc) thread_count = (u32)atoi(argv[++i]);
+                else if(arg == "--queries" && i + 1 < argc) query_count = (u32)atoi(argv[++i]);
+                else if(arg == "--check" && i + 1 < argc) check_count = (u32)atoi(argv[++i]);
+                else paths.push_back(arg);
+        }
+        if(paths.empty() || runs == 0 || thread_count == 0 || query_count == 0){
+                fprintf(stderr, "usage: %s [--runs count] [--threads count] [--queries count] [--check count] files...\n", argv[0]);
+                return 2;
+        }
+        check_count = check_count < query_count ? check_count : query_count;
+
+        thread_pool pool(thread_count);
+        pla_job_system jobs = {&pool, thread_pool::parallel_for};
+        pla_bvh_config config = pla_default_bvh_config();
+        int failed = 0;
+        for(std::string const & path : paths){
+                usize slash = path.find_last_of('/');
+                std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+                pla_posix_file_system posix = {directory.c_str(), PLA_NULL};
+                pla_file_system file_system = pla_get_posix_file_system(&posix);
+                pla_linear_allocator memory = pla_make_linear_allocator(pla_get_heap_allocator(), 1 << 20, 0);
+                pla_linear_allocator arena = pla_make_linear_allocator(pla_get_heap_allocator(), 1 << 20, 0);
+                std::vector<u8> data;
+                pla_GLTF gltf = {};
+                if(!load(path, &memory, &file_system, &gltf, data)){
+                        fprintf(stderr, "%s: can't load\n", path.c_str());
+                        if(gltf.buffers) pla_release_buffers(&gltf, &file_system);
+                        pla_release_linear_allocator(&memory);
+                        pla_release_linear_allocator(&arena);
+                        ++failed;
+                        continue;
+                }
+                u32 scene = gltf.scene < gltf.scenes_size ? gltf.scene : 0;
+                bool has_scene = scene < gltf.scenes_size;
+
+                //the first run of each also grows the arena and the scratches so the rest don't allocate.
+                u64 best_serial = UINT64_MAX;
+                u64 best_threaded = UINT64_MAX;
+                pla_scene_bvh bvh = {};
+                bool ok = true;
+                for(u32 run = 0; run < runs && ok; ++run){
+                        for(u32 threaded = 0; threaded < 2 && ok; ++threaded){
+                                pla_linear_reset(&arena);
+                                u64 start = now_ns();
+                                if(has_scene) ok = pla_build_scene_bvh(&gltf, scene, &config, threaded ? &jobs : PLA_NULL, &arena, &bvh);
+                                else ok = pla_build_mesh_bvhs(&gltf, &config, threaded ? &jobs : PLA_NULL, &arena, &bvh.meshes);
+                                u64 elapsed = now_ns() - start;
+                                u64 * best = threaded ? &best_threaded : &best_serial;
+                                *best = elapsed < *best ? elapsed : *best;
+                        }
+                }
+                if(!ok){
+                        fprintf(stderr, "%s: can't build\n", path.c_str());
+                        ++failed;
+                }
+                u64 triangle_count = 0;
+                u64 node_count = 0;
+                for(u32 i = 0; ok && i < bvh.meshes.count; ++i){
+                        triangle_count += bvh.meshes.bvhs[i].item_count;
+                        node_count += bvh.meshes.bvhs[i].node_count;
+                }
+                if(ok){
+                        printf("%s\n  %llu triangles, %llu nodes, %u instances\n", path.c_str(), (unsigned long long)triangle_count, (unsigned long long)node_count, bvh.instance_count);
+                        printf("  %-24s %10.3f ms %10.2f Mtriangles/s\n", "build, 1 thread", best_serial / 1e6, triangle_count / (best_serial / 1e3));
+                        printf("  %-24s %10.3f ms %10.2f Mtriangles/s, %u threads\n", "build, threaded", best_threaded / 1e6, triangle_count / (best_threaded / 1e3), thread_count);
+                }
+
+                if(ok && has_scene && bvh.top.node_count){
+                        query_set queries = make_queries(bvh.top.nodes[0].min, bvh.top.nodes[0].max, query_count);
+                        u32 hits = 0;
+                        u64 start = now_ns();
+                        for(u32 i = 0; i < query_count; ++i){
+                                pla_scene_bvh_hit hit;
+                                hits += pla_scene_bvh_intersect_ray(&bvh, &queries.origins[i * 3], &queries.directions[i * 3], FLT_MAX, &hit);
+                        }
+                        u64 elapsed = now_ns() - start;
+                        printf("  %-24s %10.3f ms %10.2f Mrays/s, %.1f%% hit\n", "scene rays", elapsed / 1e6, query_count / (elapsed / 1e3), 100.0 * hits / query_count);
+
+                        //the brute force goes through world space triangles so its t can differ in the last bits.
+                        std::vector<f32> world = gather_world_triangles(bvh);
+                        u32 mismatches = 0;
+                        for(u32 i = 0; i < check_count; ++i){
+                                pla_scene_bvh_hit hit;
+                                bool found = pla_scene_bvh_intersect_ray(&bvh, &queries.origins[i * 3], &queries.directions[i * 3], FLT_MAX, &hit);
+                                pla_bvh_hit brute = {FLT_MAX, 0, 0, PLA_INDEX_NONE};
+                                for(usize t = 0; t < world.size() / 9; ++t) pla_bvh_ray_triangle(&world[t * 9], &queries.origins[i * 3], &queries.directions[i * 3], (u32)t, &brute);
+                                bool brute_found = brute.item != PLA_INDEX_NONE;
+                                if(found != brute_found || (found && fabsf(hit.hit.t - brute.t) > 1e-4f * (1 + brute.t))) ++mismatches;
+                        }
+                        printf("  %-24s %10u of %u\n", "scene ray mismatches", mismatches, check_count);
+                        failed += mismatches != 0;
+                }
+
+                pla_bvh const * largest = ok ? largest_bvh(bvh.meshes) : nullptr;
+                if(largest){
+                        query_set queries = make_queries(largest->nodes[0].min, largest->nodes[0].max, query_count);
+                        u32 hits = 0;
+                        u64 start = now_ns();
+                        for(u32 i = 0; i < query_count; ++i){
+                                pla_bvh_hit hit;
+                                hits += pla_bvh_intersect_ray(largest, &queries.origins[i * 3], &queries.directions[i * 3], FLT_MAX, &hit);
+                        }
+                        u64 rays = now_ns() - start;
+                        f32 sum = 0;
+                        start = now_ns();
+                        for(u32 i = 0; i < query_count; ++i){
+                                pla_bvh_closest_point closest;
+                                if(pla_bvh_find_closest_point(largest, &queries.points[i * 3], FLT_MAX, &closest)) sum += closest.distance_squared;
+                        }
+                        u64 points = now_ns() - start;
+                        printf("  largest primitive, %u triangles\n", largest->item_count);
+                        printf("  %-24s %10.3f ms %10.2f Mrays/s, %.1f%% hit\n", "rays", rays / 1e6, query_count / (rays / 1e3), 100.0 * hits / query_count);
+                        printf("  %-24s %10.3f ms %10.2f Mqueries/s, mean distance %g\n", "closest points", points / 1e6, query_count / (points / 1e3), sqrt(sum / query_count));
+
+                        u32 mismatches = 0;
+                        for(u32 i = 0; i < check_count; ++i){
+                                pla_bvh_hit hit;
+                                bool found = pla_bvh_intersect_ray(largest, &queries.origins[i * 3], &queries.directions[i * 3], FLT_MAX, &hit);
+                                pla_bvh_hit brute = {FLT_MAX, 0, 0, PLA_INDEX_NONE};
+                                for(u32 t = 0; t < largest->item_count; ++t) pla_bvh_ray_triangle(largest->triangles + (usize)t * 9, &queries.origins[i * 3], &queries.directions[i * 3], largest->items[t], &brute);
+                                if(found != (brute.item != PLA_INDEX_NONE) || (found && hit.t != brute.t)) ++mismatches;
+
+                                pla_bvh_closest_point closest;
+                                f32 const * point = &queries.points[i * 3];
+                                pla_bvh_find_closest_point(largest, point, FLT_MAX, &closest);
+                                f32 best = FLT_MAX;
+                                for(u32 t = 0; t < largest->item_count; ++t){
+                                        f32 const * corners = largest->triangles + (usize)t * 9;
+                                        f32 q[3];
+                                        pla_closest_point_on_triangle(point, corners, corners + 3, corners + 6, q);
+                                        f32 d = (q[0] - point[0]) * (q[0] - point[0]) + (q[1] - point[1]) * (q[1] - point[1]) + (q[2] - point[2]) * (q[2] - point[2]);
+                                        best = d < best ? d : best;
+                                }
+                                mismatches += closest.distance_squared != best;
+                        }
+                        printf("  %-24s %10u of %u\n", "mismatches", mismatches, check_count * 2);
+                        failed += mismatches != 0;
+                }
+
+                pla_release_buffers(&gltf, &file_system);
+                pla_release_linear_allocator(&arena);
+                pla_release_linear_allocator(&memory);
+        }
+        pla_release_scratch();
+        return failed ? 1 : 0;
+}
@@ -0,0 +1,421 @@
+//Converts .glb / .gltf files to a flat runtime format: a node table, a mesh and primitive table, the vertex stream descriptions and two blobs of packed vertices and indices.
+//Files go through a pipeline of bounded queues, read -> parse -> convert -> write, each stage on its own threads, and the throughput and queue occupancy of every stage are printed at the end.
+//
+//    c++ -std=c++2b -O2 -pthread tools/pla_convert.cpp -o pla_convert
+//    ./pla_convert -o out/ --threads 2,2,4,1 --queue 8 assets/*.glb
+//
+//Posix only, external buffers are mapped through pla_posix_file_system.
+//--pages transparent|explicit puts the files, buffers and arenas on huge pages and --numa local puts each on the node of the worker that allocates it.
+
+#define PLA_USE_POSIX
+#include "../plastic_gltf.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//The flat format, little endian and every table 4 byte aligned.
+//header, nodes[node_count], meshes[mesh_count], primitives[primitive_count], streams[stream_count], vertex blob, index blob.
+#define PLAF_MAGIC 0x46414c50
+#define PLAF_VERSION 1
+
+struct plaf_header{
+        u32 magic;
+        u32 version;
+        u32 node_count;
+        u32 mesh_count;
+        u32 primitive_count;
+        u32 stream_count;
+        u64 vertex_blob_size;
+        u64 index_blob_size;
+};
+
+struct plaf_node{
+        //PLA_INDEX_NONE for nodes without a mesh or a parent.
+        u32 mesh;
+        u32 parent;
+        //local transform, column major.
+        f32 matrix[16];
+};
+
+struct plaf_mesh{
+        u32 first_primitive;
+        u32 primitive_count;
+};
+
+struct plaf_primitive{
+        u32 first_stream;
+        u32 stream_count;
+        u32 stride;
+        u32 vertex_count;
+        //offsets in to the vertex and index blobs, each primitive starts 16 byte aligned.
+        u64 vertex_offset;
+        u64 index_offset;
+        //0 for primitives without indices.
+        u32 index_count;
+        //2 or 4.
+        u32 index_size;
+        u32 mode;
+        u32 material;
+};
+
+//One attribute in the interleaved vertex, decoded = quantized * scale + bias for the bounds encoding.
+struct plaf_stream{
+        u32 name;
+        s32 set_index;
+        u32 encoding;
+        u32 offset;
+        u32 component_count;
+        f32 scale[4];
+        f32 bias[4];
+};
+
+static_assert(sizeof(plaf_header) == 40 && sizeof(plaf_node) == 72 && sizeof(plaf_mesh) == 8 && sizeof(plaf_primitive) == 48 && sizeof(plaf_stream) == 52, "the flat format is read with memcpy");
+
+//Fixed capacity queue, push blocks while its full and pop blocks while its empty until every producer is done.
+template<typename T>
+struct bounded_queue{
+        std::mutex mutex;
+        std::condition_variable not_full;
+        std::condition_variable not_empty;
+        std::deque<T> items;
+        usize capacity;
+        u32 producers;
+        //occupancy seen by every push, for the report.
+        u64 pushes = 0;
+        u64 occupancy_sum = 0;
+        usize occupancy_max = 0;
+
+        bounded_queue(usize capacity, u32 producers) : capacity(capacity), producers(producers) {}
+
+        void push(T item){
+                std::unique_lock<std::mutex> lock(mutex);
+                not_full.wait(lock, [&]{ return items.size() < capacity; });
+                items.push_back(std::move(item));
+                ++pushes;
+                occupancy_sum += items.size();
+                occupancy_max = items.size() > occupancy_max ? items.size() : occupancy_max;
+                not_empty.notify_one();
+        }
+
+        std::optional<T> pop(){
+                std::unique_lock<std::mutex> lock(mutex);
+                not_empty.wait(lock, [&]{ return !items.empty() || producers == 0; });
+                if(items.empty()) return std::nullopt;
+                T item = std::move(items.front());
+                items.pop_front();
+                not_full.notify_one();
+                return item;
+        }
+
+        //called once by every producer thread when it runs out of work.
+        void producer_done(){
+                std::lock_guard<std::mutex> lock(mutex);
+                if(--producers == 0) not_empty.notify_all();
+        }
+};
+
+//where the memory of every asset comes from, set from the options before the workers start.
+static pla_page_placement placement = {pla_huge_pages_none, PLA_NUMA_ANY};
+static bool use_placement = false;
+
+static pla_linear_allocator make_asset_memory(){
+        if(!use_placement) return pla_make_linear_allocator(pla_get_heap_allocator(), 1 << 20, 0);
+        return pla_make_linear_allocator(pla_get_page_allocator(&placement), 1 << 20, placement.huge_pages != pla_huge_pages_none ? PLA_HUGE_PAGE_SIZE : 0);
+}
+
+struct asset{
+        std::string path;
+        std::string directory;
+        //the file, the parsed gltf, resolved buffers and decoded meshopt views.
+        pla_linear_allocator memory = make_asset_memory();
+        u8 * file = PLA_NULL;
+        usize file_size = 0;
+        pla_posix_file_system posix;
+        pla_file_system file_system;
+        pla_GLTF gltf;
+        std::vector<u8> output;
+        //why a stage failed, if it knows.
+        std::string error;
+
+        ~asset(){
+                if(gltf.buffers) pla_release_buffers(&gltf, &file_system);
+                pla_release_linear_allocator(&memory);
+        }
+};
+
+using asset_ptr = std::unique_ptr<asset>;
+
+struct stage_stats{
+        std::atomic<u64> items{0};
+        std::atomic<u64> failed{0};
+        std::atomic<u64> bytes{0};
+        std::atomic<u64> busy_ns{0};
+};
+
+static u64 now_ns(){
+        return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool read_file(asset & a){
+        FILE * file = fopen(a.path.c_str(), "rb");
+        if(!file) return false;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if(size <= 0 || size > (long)UINT32_MAX){
+                fclose(file);
+                return false;
+        }
+        a.file_size = (usize)size;
+        a.file = (u8 *)pla_linear_allocate(&a.memory, a.file_size, 16);
+        bool ok = a.file && fread(a.file, 1, a.file_size, file) == a.file_size;
+        fclose(file);
+        usize slash = a.path.find_last_of('/');
+        a.directory = slash == std::string::npos ? "." : a.path.substr(0, slash);
+        return ok;
+}
+
+static bool parse_failed(asset & a, pla_parse_error const & error){
+        char text[256];
+        snprintf(text, sizeof(text), "%s at byte %u%s%s", pla_parse_error_code_strings[error.code], error.offset, error.path[0] ? " in " : "", error.path);
+        a.error = text;
+        a.gltf = pla_GLTF{};
+        return false;
+}
+
+static bool parse_asset(asset & a){
+        pla_parse_error error;
+        a.gltf = pla_GLTF{};
+        if(!pla_parse_GLTF_with_allocator((u32)a.file_size, a.file, &a.memory, &a.gltf, &error)){
+                a.gltf = pla_GLTF{};
+                return parse_failed(a, error);
+        }
+        a.posix.directory = a.directory.c_str();
+        a.posix.placement = use_placement ? &placement : PLA_NULL;
+        a.file_system = pla_get_posix_file_system(&a.posix);
+        usize buffer_size = pla_get_buffer_memory_size(&a.gltf);
+        u8 * buffer_memory = (u8 *)pla_linear_allocate(&a.memory, buffer_size, 16);
+        if(!buffer_memory || !pla_resolve_buffers(&a.gltf, &a.file_system, PLA_NULL, buffer_size, buffer_memory)) return false;
+        usize meshopt_size = pla_get_meshopt_memory_size(&a.gltf);
+        u8 * meshopt_memory = (u8 *)pla_linear_allocate(&a.memory, meshopt_size, 16);
+        return meshopt_memory && pla_decode_meshopt_buffer_views(&a.gltf, PLA_NULL, meshopt_size, meshopt_memory);
+}
+
+static void build_nodes(pla_GLTF const & gltf, std::vector<plaf_node> & nodes){
+        nodes.resize(gltf.nodes_size);
+        for(plaf_node & node : nodes) node.parent = PLA_INDEX_NONE;
+        for(u32 i = 0; i < gltf.nodes_size; ++i){
+                pla_node const & node = gltf.nodes[i];
+                nodes[i].mesh = node.mesh;
+                memcpy(nodes[i].matrix, node.matrix, sizeof(node.matrix));
+                for(u32 c = 0; c < node.child_count; ++c) if(node.children[c] < nodes.size()) nodes[node.children[c]].parent = i;
+        }
+}
+
+static void append(std::vector<u8> & out, void const * data, usize size){
+        out.insert(out.end(), (u8 const *)data, (u8 const *)data + size);
+}
+
+static void align(std::vector<u8> & blob, usize alignment){
+        blob.resize((blob.size() + alignment - 1) & ~(alignment - 1));
+}
+
+static bool convert_asset(asset & a){
+        pla_GLTF const & gltf = a.gltf;
+        std::vector<plaf_node> nodes;
+        std::vector<plaf_mesh> meshes;
+        std::vector<plaf_primitive> primitives;
+        std::vector<plaf_stream> streams;
+        std::vector<u8> vertices;
+        std::vector<u8> indices;
+        build_nodes(gltf, nodes);
+        pla_quantize_config config = pla_default_quantize_config();
+        for(pla_mesh const & mesh : pla::meshes(gltf)){
+                meshes.push_back({(u32)primitives.size(), mesh.primitive_count});
+                for(pla_mesh_primitive const & primitive : pla::primitives(mesh)){
+                        pla_vertex_layout layout = {};
+                        usize size = 0;
+                        if(!pla_quantize_primitive(&gltf, &primitive, &config, &layout, &size, PLA_NULL)) return false;
+                        align(vertices, 16);
+                        plaf_primitive out = {};
+                        out.first_stream = (u32)streams.size();
+                        out.stream_count = layout.stream_count;
+                        out.stride = layout.stride;
+                        out.vertex_count = layout.vertex_count;
+                        out.vertex_offset = vertices.size();
+                        out.mode = primitive.mode;
+                        out.material = primitive.material;
+                        vertices.resize(vertices.size() + size);
+                        if(size && !pla_quantize_primitive(&gltf, &primitive, &config, &layout, &size, vertices.data() + out.vertex_offset)) return false;
+                        for(u32 i = 0; i < layout.stream_count; ++i){
+                                pla_vertex_stream const & stream = layout.streams[i];
+                                plaf_stream packed = {(u32)stream.name, stream.set_index, (u32)stream.encoding, stream.offset, stream.component_count, {}, {}};
+                                memcpy(packed.scale, stream.scale, sizeof(packed.scale));
+                                memcpy(packed.bias, stream.bias, sizeof(packed.bias));
+                                streams.push_back(packed);
+                        }
+
+                        out.index_size = layout.vertex_count > 0xffff ? 4 : 2;
+                        if(primitive.indices != PLA_INDEX_NONE){
+                                if(primitive.indices >= gltf.accessors_size) return false;
+                                align(indices, 16);
+                                out.index_offset = indices.size();
+                                //the visitor picks the index type once, the copy loop below is compiled for it.
+                                bool is_index = false;
+                                bool ok = pla::visit_accessor(gltf, gltf.accessors[primitive.indices], [&](auto view){
+                                        if constexpr(decltype(view)::component_count == 1 && !std::is_same_v<typename decltype(view)::element, f32>){
+                                                is_index = true;
+                                                out.index_count = view.size();
+                                                indices.resize(indices.size() + (usize)view.size() * out.index_size);
+                                                u8 * destination = indices.data() + out.index_offset;
+                                                for(u32 i = 0; i < view.size(); ++i){
+                                                        u32 index = (u32)view[i];
+                                                        if(out.index_size == 2){
+                                                                u16 index16 = (u16)index;
+                                                                memcpy(destination + (usize)i * 2, &index16, 2);
+                                                        }
+                                                        else memcpy(destination + (usize)i * 4, &index, 4);
+                                                }
+                                        }
+                                });
+                                if(!ok || !is_index) return false;
+                        }
+                        primitives.push_back(out);
+                }
+        }
+
+        plaf_header header = {PLAF_MAGIC, PLAF_VERSION, (u32)nodes.size(), (u32)meshes.size(), (u32)primitives.size(), (u32)streams.size(), vertices.size(), indices.size()};
+        a.output.clear();
+        append(a.output, &header, sizeof(header));
+        append(a.output, nodes.data(), nodes.size() * sizeof(plaf_node));
+        append(a.output, meshes.data(), meshes.size() * sizeof(plaf_mesh));
+        append(a.output, primitives.data(), primitives.size() * sizeof(plaf_primitive));
+        append(a.output, streams.data(), streams.size() * sizeof(plaf_stream));
+        append(a.output, vertices.data(), vertices.size());
+        append(a.output, indices.data(), indices.size());
+        return true;
+}
+
+static bool write_asset(asset & a, std::string const & out_directory){
+        usize slash = a.path.find_last_of('/');
+        std::string name = slash == std::string::npos ? a.path : a.path.substr(slash + 1);
+        usize dot = name.find_last_of('.');
+        if(dot != std::string::npos) name.resize(dot);
+        std::string path = out_directory + "/" + name + ".plaf";
+        FILE * file = fopen(path.c_str(), "wb");
+        if(!file) return false;
+        bool ok = fwrite(a.output.data(), 1, a.output.size(), file) == a.output.size();
+        return fclose(file) == 0 && ok;
+}
+
+//Runs work on every item from in until its drained and pushes the ones that succeed to out.
+template<typename F>
+static void run_stage(char const * name, bounded_queue<asset_ptr> * in, bounded_queue<asset_ptr> * out, stage_stats & stats, F work){
+        while(std::optional<asset_ptr> item = in->pop()){
+                asset_ptr a = std::move(*item);
+                u64 start = now_ns();
+                usize bytes = 0;
+                bool ok = work(*a, bytes);
+                stats.busy_ns += now_ns() - start;
+                if(!ok){
+                        fprintf(stderr, "%s failed: %s%s%s\n", name, a->path.c_str(), a->error.empty() ? "" : ": ", a->error.c_str());
+                        ++stats.failed;
+                        continue;
+                }
+                ++stats.items;
+                stats.bytes += bytes;
+                if(out) out->push(std::move(a));
+        }
+        if(out) out->producer_done();
+}
+
+static bool parse_thread_counts(char const * arg, u32 * counts){
+        for(u32 i = 0; i < 4; ++i){
+                char * end = PLA_NULL;
+                long count = strtol(arg, &end, 10);
+                if(end == arg || count <= 0 || count > 256) return false;
+                counts[i] = (u32)count;
+                if(i < 3 && *end != ',') return false;
+                arg = end + 1;
+        }
+        return true;
+}
+
+int main(int argc, char ** argv){
+        std::string out_directory = ".";
+        u32 threads[4] = {1, 2, 2, 1};
+        usize queue_capacity = 4;
+        std::vector<std::string> paths;
+        for(int i = 1; i < argc; ++i){
+                std::string arg = argv[i];
+                if(arg == "-o" && i + 1 < argc) out_directory = argv[++i];
+                else if(arg == "--threads" && i + 1 < argc){
+                        if(!parse_thread_counts(argv[++i], threads)){
+                                fprintf(stderr, "--threads takes read,parse,convert,write counts\n");
+                                return 2;
+                        }
+                }
+                else if(arg == "--queue" && i + 1 < argc) queue_capacity = (usize)atoi(argv[++i]);
+                else if(arg == "--pages" && i + 1 < argc){
+                        std::string pages = argv[++i];
+                        placement.huge_pages = pla_huge_pages_MAX_ENUM;
+                        for(u32 p = 0; p < pla_huge_pages_MAX_ENUM; ++p) if(pages == pla_huge_pages_strings[p]) placement.huge_pages = (pla_huge_pages)p;
+                        if(placement.huge_pages == pla_huge_pages_MAX_ENUM){
+                                fprintf(stderr, "--pages takes none, transparent or explicit\n");
+                                return 2;
+                        }
+                        use_placement = true;
+                }
+                else if(arg == "--numa" && i + 1 < argc){
+                        std::string numa = argv[++i];
+                        placement.numa_node = numa == "local" ? PLA_NUMA_LOCAL : numa == "any" ? PLA_NUMA_ANY : (u32)atoi(numa.c_str());
+                        use_placement = true;
+                }
+                else paths.push_back(arg);
+        }
+        if(paths.empty() || queue_capacity == 0){
+                fprintf(stderr, "usage: %s [-o out_dir] [--threads read,parse,convert,write] [--queue capacity] [--pages none|transparent|explicit] [--numa any|local|node] files...\n", argv[0]);
+                return 2;
+        }
+
+        char const * names[4] = {"read", "parse", "convert", "write"};
+        //queues[0] feeds the readers, queues[i] sits in front of stage i.
+        bounded_queue<asset_ptr> queues[4] = {{paths.size(), 1}, {queue_capacity, threads[0]}, {queue_capacity, threads[1]}, {queue_capacity, threads[2]}};
+        stage_stats stats[4];
+        for(std::string const & path : paths){
+                asset_ptr a(new asset());
+                a->path = path;
+                queues[0].push(std::move(a));
+        }
+        queues[0].producer_done();
+
+        u64 start = now_ns();
+        std::vector<std::thread> workers;
+        for(u32 t = 0; t < threads[0]; ++t) workers.emplace_back([&]{ run_stage(names[0], &queues[0], &queues[1], stats[0], [](asset & a, usize & bytes){ bool ok = read_file(a); bytes = a.file_size; return ok; }); });
+        for(u32 t = 0; t < threads[1]; ++t) workers.emplace_back([&]{ run_stage(names[1], &queues[1], &queues[2], stats[1], [](asset & a, usize & bytes){ bytes = a.file_size; return parse_asset(a); }); });
+        for(u32 t = 0; t < threads[2]; ++t) workers.emplace_back([&]{ run_stage(names[2], &queues[2], &queues[3], stats[2], [](asset & a, usize & bytes){ bool ok = convert_asset(a); bytes = a.output.size(); return ok; }); });
+        for(u32 t = 0; t < threads[3]; ++t) workers.emplace_back([&]{ run_stage(names[3], &queues[3], PLA_NULL, stats[3], [&](asset & a, usize & bytes){ bytes = a.output.size(); return write_asset(a, out_directory); }); });
+        for(std::thread & worker : workers) worker.join();
+        f64 seconds = (now_ns() - start) / 1e9;
+
+        printf("%-8s %7s %7s %9s %10s %9s %10s %9s\n", "stage", "threads", "items", "failed", "MB/s cpu", "cpu s", "queue avg", "queue max");
+        for(u32 i = 0; i < 4; ++i){
+                //summed over the stage's threads, so with more than one it can be more than the wall time.
+                f64 cpu = stats[i].busy_ns / 1e9;
+                bounded_queue<asset_ptr> & in = queues[i];
+                printf("%-8s %7u %7llu %9llu %10.1f %9.3f %10.2f %9zu\n", names[i], threads[i], (unsigned long long)stats[i].items.load(), (unsigned long long)stats[i].failed.load(),
+                        cpu > 0 ? stats[i].bytes / 1e6 / cpu : 0.0, cpu, in.pushes ? (f64)in.occupancy_sum / in.pushes : 0.0, in.occupancy_max);
+        }
+        printf("%zu files in %.3fs, %.1f files/s\n", paths.size(), seconds, paths.size() / seconds);
+        u64 failed = stats[0].failed + stats[1].failed + stats[2].failed + stats[3].failed;
+        return failed ? 1 : 0;
+}
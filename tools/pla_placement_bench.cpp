@@ -0,0 +1,164 @@
+//Times loading, parsing and converting every accessor to floats with the file, arenas and outputs placed on different pages and numa nodes.
+//Each placement runs --runs times and the fastest run is kept. conversion runs on --threads workers that each map their own output, so with numa local every worker writes to its own node.
+//remote puts every worker's output on the next node over, on a machine with one node it's the same as local.
+//explicit huge pages come from vm.nr_hugepages and are transparent ones when the pool is empty.
+//
+//    c++ -std=c++2b -O2 -pthread tools/pla_placement_bench.cpp -o pla_placement_bench
+//    ./pla_placement_bench --runs 5 --threads 8 scans/*.glb
+
+#define PLA_USE_POSIX
+#include "../plastic_gltf.h"
+
+#include <chrono>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct placement_case{
+        char const * name;
+        //false is malloc and a mapped file, what you get without a placement.
+        bool placed;
+        pla_huge_pages huge_pages;
+        u32 numa_node;
+        bool remote;
+};
+
+struct timings{
+        u64 load = UINT64_MAX;
+        u64 parse = UINT64_MAX;
+        u64 convert = UINT64_MAX;
+};
+
+//keeps the touching loop from being optimized out.
+static u8 volatile touched_sink;
+
+static u64 now_ns(){
+        return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static u32 count_numa_nodes(){
+        u32 count = 0;
+        while(count < 64){
+                std::string path = "/sys/devices/system/node/node" + std::to_string(count);
+                if(access(path.c_str(), F_OK) != 0) break;
+                ++count;
+        }
+        return count ? count : 1;
+}
+
+static pla_linear_allocator make_allocator(placement_case const & c, pla_page_placement const * placement){
+        if(!c.placed) return pla_make_linear_allocator(pla_get_heap_allocator(), 1 << 20, 0);
+        return pla_make_linear_allocator(pla_get_page_allocator(placement), 1 << 20, c.huge_pages != pla_huge_pages_none ? PLA_HUGE_PAGE_SIZE : 0);
+}
+
+//Converts the accessors i % thread_count == thread in to an output the worker maps itself.
+static void convert_share(pla_GLTF const * gltf, placement_case const & c, u32 node_count, u32 thread, u32 thread_count, f32 * checksum){
+        pla_page_placement placement = {c.huge_pages, c.numa_node};
+        if(c.remote) placement.numa_node = (pla_get_current_numa_node() + 1) % node_count;
+        pla_linear_allocator output = make_allocator(c, &placement);
+        f32 sum = 0;
+        for(u32 i = thread; i < gltf->accessors_size; i += thread_count){
+                pla_accessor const * accessor = &gltf->accessors[i];
+                if(accessor->type < 0 || accessor->type >= pla_GLTF_type_MAX_ENUM) continue;
+                usize count = (usize)accessor->count * pla_GLTF_type_component_count[accessor->type];
+                f32 * values = (f32 *)pla_linear_allocate(&output, count * sizeof(f32), 64);
+                if(!values || !pla_read_accessor_f32(gltf, accessor, 0, accessor->count, values)) continue;
+                if(count) sum += values[0] + values[count - 1];
+        }
+        *checksum = sum;
+        pla_release_linear_allocator(&output);
+}
+
+static bool run_case(std::string const & path, placement_case const & c, u32 node_count, u32 thread_count, timings & best){
+        pla_page_placement placement = {c.huge_pages, c.numa_node};
+        usize slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+        std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+        pla_posix_file_system posix = {directory.c_str(), c.placed ? &placement : PLA_NULL};
+        pla_file_system file_system = pla_get_posix_file_system(&posix);
+
+        u64 start = now_ns();
+        u8 const * data = PLA_NULL;
+        usize size = 0;
+        void * handle = PLA_NULL;
+        pla_str uri = {(u8 const *)name.data(), name.size()};
+        if(!file_system.open(file_system.user_data, uri, &data, &size, &handle)) return false;
+        //a mapped file is read in by the first pass over it, touching it here keeps that out of the parse time.
+        u8 touched = 0;
+        for(usize i = 0; i < size; i += 4096) touched ^= data[i];
+        u64 loaded = now_ns();
+
+        pla_linear_allocator memory = make_allocator(c, &placement);
+        pla_GLTF gltf = {};
+        bool ok = size <= UINT32_MAX && pla_parse_GLTF_with_allocator((u32)size, data, &memory, &gltf, PLA_NULL);
+        usize buffer_size = ok ? pla_get_buffer_memory_size(&gltf) : 0;
+        u8 * buffer_memory = ok ? (u8 *)pla_linear_allocate(&memory, buffer_size, 16) : PLA_NULL;
+        ok = ok && buffer_memory && pla_resolve_buffers(&gltf, &file_system, PLA_NULL, buffer_size, buffer_memory);
+        usize meshopt_size = ok ? pla_get_meshopt_memory_size(&gltf) : 0;
+        u8 * meshopt_memory = ok ? (u8 *)pla_linear_allocate(&memory, meshopt_size, 16) : PLA_NULL;
+        ok = ok && meshopt_memory && pla_decode_meshopt_buffer_views(&gltf, PLA_NULL, meshopt_size, meshopt_memory);
+        u64 parsed = now_ns();
+
+        std::vector<f32> checksums(thread_count);
+        if(ok){
+                std::vector<std::thread> workers;
+                for(u32 t = 0; t < thread_count; ++t) workers.emplace_back(convert_share, &gltf, std::cref(c), node_count, t, thread_count, &checksums[t]);
+                for(std::thread & worker : workers) worker.join();
+        }
+        u64 converted = now_ns();
+
+        if(gltf.buffers) pla_release_buffers(&gltf, &file_system);
+        pla_release_linear_allocator(&memory);
+        file_system.close(file_system.user_data, handle, data, size);
+        if(!ok) return false;
+        best.load = loaded - start < best.load ? loaded - start : best.load;
+        best.parse = parsed - loaded < best.parse ? parsed - loaded : best.parse;
+        best.convert = converted - parsed < best.convert ? converted - parsed : best.convert;
+        touched_sink = touched;
+        return true;
+}
+
+int main(int argc, char ** argv){
+        u32 runs = 5;
+        u32 thread_count = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+        std::vector<std::string> paths;
+        for(int i = 1; i < argc; ++i){
+                std::string arg = argv[i];
+                if(arg == "--runs" && i + 1 < argc) runs = (u32)atoi(argv[++i]);
+                else if(arg == "--threads" && i + 1 < argc) thread_count = (u32)atoi(argv[++i]);
+                else paths.push_back(arg);
+        }
+        if(paths.empty() || runs == 0 || thread_count == 0){
+                fprintf(stderr, "usage: %s [--runs count] [--threads count] files...\n", argv[0]);
+                return 2;
+        }
+
+        u32 node_count = count_numa_nodes();
+        placement_case cases[] = {
+                {"malloc, mapped file", false, pla_huge_pages_none, PLA_NUMA_ANY, false},
+                {"pages", true, pla_huge_pages_none, PLA_NUMA_ANY, false},
+                {"transparent", true, pla_huge_pages_transparent, PLA_NUMA_ANY, false},
+                {"explicit", true, pla_huge_pages_explicit, PLA_NUMA_ANY, false},
+                {"pages, numa local", true, pla_huge_pages_none, PLA_NUMA_LOCAL, false},
+                {"transparent, numa local", true, pla_huge_pages_transparent, PLA_NUMA_LOCAL, false},
+                {"transparent, numa remote", true, pla_huge_pages_transparent, PLA_NUMA_ANY, true},
+        };
+        printf("%u numa nodes, %u conversion threads\n", node_count, thread_count);
+        for(std::string const & path : paths){
+                printf("%s\n%-28s %10s %10s %10s\n", path.c_str(), "placement", "load ms", "parse ms", "convert ms");
+                for(placement_case const & c : cases){
+                        timings best;
+                        bool ok = true;
+                        for(u32 run = 0; run < runs && ok; ++run) ok = run_case(path, c, node_count, thread_count, best);
+                        if(!ok){
+                                printf("%-28s %10s\n", c.name, "failed");
+                                continue;
+                        }
+                        printf("%-28s %10.3f %10.3f %10.3f\n", c.name, best.load / 1e6, best.parse / 1e6, best.convert / 1e6);
+                }
+        }
+        return 0;
+}
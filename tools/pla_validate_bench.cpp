@@ -0,0 +1,86 @@
+//Times parsing against parsing plus pla_validate_gltf, the cost of what PLA_HARDENED adds to a parse.
+//Each file is parsed --runs times and the fastest run of each is kept so the numbers don't move with the machine.
+//
+//    c++ -std=c++2b -O2 tools/pla_validate_bench.cpp -o pla_validate_bench
+//    ./pla_validate_bench --runs 20 assets/*.glb
+
+#include "../plastic_gltf.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+static u64 now_ns(){
+        return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool read_file(char const * path, std::vector<u8> & data){
+        FILE * file = fopen(path, "rb");
+        if(!file) return false;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if(size <= 0 || size > (long)UINT32_MAX){
+                fclose(file);
+                return false;
+        }
+        data.resize((usize)size);
+        bool ok = fread(data.data(), 1, data.size(), file) == data.size();
+        fclose(file);
+        return ok;
+}
+
+int main(int argc, char ** argv){
+        u32 runs = 10;
+        std::vector<std::string> paths;
+        for(int i = 1; i < argc; ++i){
+                std::string arg = argv[i];
+                if(arg == "--runs" && i + 1 < argc) runs = (u32)atoi(argv[++i]);
+                else paths.push_back(arg);
+        }
+        if(paths.empty() || runs == 0){
+                fprintf(stderr, "usage: %s [--runs count] files...\n", argv[0]);
+                return 2;
+        }
+
+        printf("%-32s %12s %12s %10s %s\n", "file", "parse ms", "validate ms", "overhead", "valid");
+        u64 total_parse = 0;
+        u64 total_validate = 0;
+        for(std::string const & path : paths){
+                std::vector<u8> data;
+                if(!read_file(path.c_str(), data)){
+                        fprintf(stderr, "%s: can't read\n", path.c_str());
+                        continue;
+                }
+                size_t size = 0;
+                if(!pla_parse_GLTF((u32)data.size(), data.data(), &size, PLA_NULL, PLA_NULL)){
+                        fprintf(stderr, "%s: can't parse\n", path.c_str());
+                        continue;
+                }
+                std::vector<u8> memory(size);
+                u64 best_parse = UINT64_MAX;
+                u64 best_validate = UINT64_MAX;
+                bool valid = false;
+                for(u32 run = 0; run < runs; ++run){
+                        pla_GLTF gltf = {};
+                        u64 start = now_ns();
+                        if(!pla_parse_GLTF((u32)data.size(), data.data(), &size, memory.data(), &gltf)) break;
+                        u64 parsed = now_ns();
+                        valid = pla_validate_gltf(&gltf);
+                        u64 validated = now_ns();
+                        best_parse = parsed - start < best_parse ? parsed - start : best_parse;
+                        best_validate = validated - parsed < best_validate ? validated - parsed : best_validate;
+                }
+                if(best_parse == UINT64_MAX){
+                        fprintf(stderr, "%s: can't parse\n", path.c_str());
+                        continue;
+                }
+                total_parse += best_parse;
+                total_validate += best_validate;
+                printf("%-32s %12.3f %12.3f %9.2f%% %s\n", path.c_str(), best_parse / 1e6, best_validate / 1e6, 100.0 * best_validate / best_parse, valid ? "yes" : "no");
+        }
+        if(total_parse) printf("%-32s %12.3f %12.3f %9.2f%%\n", "total", total_parse / 1e6, total_validate / 1e6, 100.0 * total_validate / total_parse);
+        return 0;
+}